@@ -151,6 +151,21 @@
  * Set it to 0 to have no limit. */
 #define LV_DRAW_LAYER_MAX_MEMORY 0  /**< No limit by default [bytes]*/
 
+/* Max memory used to keep the rendered content of the widgets having `LV_OBJ_FLAG_CACHE_LAYER`.
+ * The least recently drawn ones are dropped if the limit is reached.
+ * Set it to 0 to ignore `LV_OBJ_FLAG_CACHE_LAYER`. */
+#define LV_DRAW_LAYER_CACHE_MAX_MEMORY 0  /**< [bytes]*/
+
+/** Don't draw the widgets or the parts of the widgets which are covered by opaque widgets drawn later.
+ *  Only non-transformed widgets with full opacity are considered as covering.
+ *  Use `lv_display_get_culled_px_count()` to see how many pixels were skipped in the last refresh. */
+#define LV_USE_OCCLUSION_CULLING 0
+
+/** In `LV_DISPLAY_RENDER_MODE_DIRECT` move the already rendered pixels of the scrolled widgets
+ *  and redraw only the newly revealed parts. Used only if nothing else is drawn on the scrolled area
+ *  (e.g. the widget has an opaque plain background and there are no floating widgets above it). */
+#define LV_USE_SCROLL_SHIFT 0
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -208,14 +223,26 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /** Allow buffering some shadow calculation.
          *  LV_DRAW_SW_SHADOW_CACHE_SIZE is the maximum shadow size to buffer, where shadow size is
-         *  `shadow_width + radius`.  Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost. */
+         *  `shadow_width + radius`.  Caching a shadow has `shadow size`^2 RAM cost. */
         #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
+        #if LV_DRAW_SW_SHADOW_CACHE_SIZE
+            /** Size in bytes of the cache of the blurred shadow corners.
+             *  The least recently used corners are dropped when it's full. */
+            #define LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE (32 * 1024)
+        #endif
 
         /** Set number of maximally-cached circle data.
          *  The circumference of 1/4 circle are saved for anti-aliasing.
-         *  `radius * 4` bytes are used per circle (the most often used radiuses are saved).
+         *  `radius * 6` bytes are used per circle (the least recently used radiuses are dropped).
+         *  The cache is shared by the draw threads and kept between the refreshes.
          *  - 0: disables caching */
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+
+        /** Size in bytes of the cache of the gradient color maps.
+         *  A map costs `4 * gradient length` bytes and is shared by all the draw tasks using the same stops.
+         *  E.g. `(8 * 1024)` keeps the maps of a few screen wide gradients.
+         *  - 0: disables caching */
+        #define LV_DRAW_SW_GRAD_CACHE_SIZE 0
     #endif
 
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
@@ -464,6 +491,17 @@
  *  The main logic is like `LV_CACHE_DEF_SIZE` but for image headers. */
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/** 1: Decode the images in a background thread.
+ *  While an image is not in the image cache yet a placeholder is drawn instead of blocking the rendering,
+ *  and the Widget is invalidated when the decoded image is ready.
+ *  Requires `LV_USE_OS` and the image cache (`LV_CACHE_DEF_SIZE > 0`).
+ *  Images can be decoded in advance with `lv_image_decoder_prefetch()` too. */
+#define LV_USE_IMAGE_DECODER_ASYNC 0
+#if LV_USE_IMAGE_DECODER_ASYNC
+    /** Stack size of the decoder thread. Image decoders (e.g. PNG or JPEG) might need a lot of stack. */
+    #define LV_IMAGE_DECODER_ASYNC_STACK_SIZE   (32 * 1024)     /**< [bytes]*/
+#endif
+
 /** Number of stops allowed per gradient. Increase this to allow more stops.
  *  This adds (sizeof(lv_color_t) + 1) bytes per additional stop. */
 #define LV_GRADIENT_MAX_STOPS   2
@@ -479,6 +517,12 @@
 /** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/** Cache this many resolved style properties per widget (for each part and state).
+ *  A cached property is returned without looking up the styles of the widget and its parents.
+ *  The cache is allocated when a style property of the widget is read the first time.
+ *  Must be a power of 2. 0: disable the cache */
+#define LV_OBJ_STYLE_RESOLVED_CACHE_SIZE    0
+
 /** Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -641,6 +685,11 @@
  *  A compiler error will be triggered if a font needs it. */
 #define LV_FONT_FMT_TXT_LARGE 0
 
+/** Size in bytes of the cache of the decoded glyph bitmaps of the `lv_font_fmt_txt` fonts (e.g. built-in fonts).
+ *  Glyphs found in the cache don't need to be decompressed or converted to A8 again.
+ *  0: to disable caching */
+#define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE 0
+
 /** Enables/disables support for compressed fonts. */
 #define LV_USE_FONT_COMPRESSED 0
 
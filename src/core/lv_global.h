@@ -22,6 +22,7 @@ extern "C" {
 #endif
 #include "../misc/lv_anim.h"
 #include "../misc/lv_area.h"
+#include "../misc/lv_array.h"
 #include "../misc/lv_color_op.h"
 #include "../misc/lv_ll.h"
 #include "../misc/lv_log.h"
@@ -73,6 +74,10 @@ struct _snippet_stack;
 struct _lv_freetype_context_t;
 #endif
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+struct _lv_image_decoder_async_t;
+#endif
+
 #if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
 struct _lv_profiler_builtin_ctx_t;
 #endif
@@ -94,6 +99,7 @@ typedef struct _lv_global_t {
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
+    uint32_t style_generation;
 
     lv_ll_t group_ll;
     lv_group_t * group_default;
@@ -105,6 +111,9 @@ typedef struct _lv_global_t {
     uint32_t layout_count;
     lv_layout_dsc_t * layout_list;
     bool layout_update_mutex;
+    uint32_t layout_visited_cnt;
+    uint32_t layout_updated_cnt;
+    uint32_t layout_measured_cnt;
 
     uint32_t memory_zero;
     uint32_t math_rand_seed;
@@ -125,14 +134,24 @@ typedef struct _lv_global_t {
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+#if LV_USE_IMAGE_DECODER_ASYNC
+    struct _lv_image_decoder_async_t * img_decoder_async;
+#endif
 
     lv_draw_global_info_t draw_info;
     lv_ll_t draw_sw_blend_handler_ll;
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    lv_draw_sw_shadow_cache_t sw_shadow_cache;
+    lv_cache_t * sw_shadow_cache;
+#endif
+#if defined(LV_DRAW_SW_GRAD_CACHE_SIZE) && LV_DRAW_SW_GRAD_CACHE_SIZE > 0
+    lv_cache_t * sw_grad_cache;
 #endif
 #if LV_DRAW_SW_COMPLEX
-    lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
+    lv_cache_t * sw_circle_cache;
+#endif
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+    lv_cache_t * layer_cache;
+    lv_array_t layer_cache_acquired;    /**< Entries used in the current refresh*/
 #endif
 
 #if LV_USE_LOG
@@ -199,6 +218,10 @@ typedef struct _lv_global_t {
     lv_font_fmt_rle_t font_fmt_rle;
 #endif
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    lv_font_fmt_txt_glyph_cache_t font_fmt_txt_glyph_cache;
+#endif
+
 #if LV_USE_SPAN != 0
     struct _snippet_stack * span_snippet_stack;
 #endif
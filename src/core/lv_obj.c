@@ -9,12 +9,13 @@
 #include "lv_obj_private.h"
 #include "../misc/lv_event_private.h"
 #include "../misc/lv_area_private.h"
+#include "../misc/lv_style_private.h"
 #include "lv_obj_style_private.h"
 #include "lv_obj_event_private.h"
 #include "lv_obj_class_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_private.h"
-#include "lv_refr.h"
+#include "lv_refr_private.h"
 #include "lv_group.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
@@ -24,6 +25,7 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_types.h"
 #include "../tick/lv_tick.h"
+#include "../layouts/lv_layout_private.h"
 #include "../stdlib/lv_string.h"
 #include "lv_obj_draw_private.h"
 
@@ -297,6 +299,10 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     obj->flags &= (~f);
 
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+    if(f & LV_OBJ_FLAG_CACHE_LAYER) lv_refr_cache_layer_drop(obj);
+#endif
+
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
         lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
@@ -552,6 +558,8 @@ static void lv_obj_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     obj->flags |= LV_OBJ_FLAG_SCROLL_WITH_ARROW;
     if(parent) obj->flags |= LV_OBJ_FLAG_GESTURE_BUBBLE;
 
+    obj->layout_item_inv = 1;
+
 #if LV_OBJ_ID_AUTO_ASSIGN
     lv_obj_assign_id(class_p, obj);
 #endif
@@ -570,6 +578,11 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_obj_remove_style_all(obj);
     lv_obj_enable_style_refresh(true);
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    lv_free(obj->style_resolved_cache);
+    obj->style_resolved_cache = NULL;
+#endif
+
     /*Remove the animations from this object*/
     lv_anim_delete(obj, NULL);
 
@@ -577,12 +590,18 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_group_t * group = lv_obj_get_group(obj);
     if(group) lv_group_remove_obj(obj);
 
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_LAYER)) lv_refr_cache_layer_drop(obj);
+#endif
+
     if(obj->spec_attr) {
         if(obj->spec_attr->children) {
             lv_free(obj->spec_attr->children);
             obj->spec_attr->children = NULL;
         }
 
+        lv_layout_free_cache(obj);
+
         lv_event_remove_all(&obj->spec_attr->event_list);
 #if LV_USE_OBJ_NAME
         if(obj->spec_attr->name && !obj->spec_attr->name_static) {
@@ -968,6 +987,10 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
         return;
     }
 
+    /*The values of the widget are cached per state, but the values inherited by the children
+     *depend on the state of this widget*/
+    lv_obj_style_invalidate_resolved_cache(obj, true);
+
     /*Invalidate the object in their current state*/
     lv_obj_invalidate(obj);
 
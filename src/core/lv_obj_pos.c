@@ -22,6 +22,8 @@
  *********************/
 #define MY_CLASS (&lv_obj_class)
 #define update_layout_mutex LV_GLOBAL_DEFAULT()->layout_update_mutex
+#define layout_visited_cnt LV_GLOBAL_DEFAULT()->layout_visited_cnt
+#define layout_updated_cnt LV_GLOBAL_DEFAULT()->layout_updated_cnt
 
 /**********************
  *      TYPEDEFS
@@ -33,6 +35,7 @@
 static int32_t calc_content_width(lv_obj_t * obj);
 static int32_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static void layout_mark_parents_dirty(lv_obj_t * obj);
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv);
 static bool is_transformed(const lv_obj_t * obj);
 
@@ -199,6 +202,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     lv_obj_invalidate(obj);
 
     obj->readjust_scroll_after_layout = 1;
+    layout_mark_parents_dirty(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -282,6 +286,7 @@ bool lv_obj_is_layout_positioned(const lv_obj_t * obj)
 void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
+    layout_mark_parents_dirty(obj);
 
     /*Mark the screen as dirty too to mark that there is something to do on this screen*/
     lv_obj_t * scr = lv_obj_get_screen(obj);
@@ -314,6 +319,16 @@ void lv_obj_update_layout(const lv_obj_t * obj)
     LV_PROFILER_LAYOUT_END;
 }
 
+uint32_t lv_obj_get_layout_visited_count(void)
+{
+    return layout_visited_cnt;
+}
+
+uint32_t lv_obj_get_layout_updated_count(void)
+{
+    return layout_updated_cnt;
+}
+
 void lv_obj_set_align(lv_obj_t * obj, lv_align_t align)
 {
     lv_obj_set_style_align(obj, align, 0);
@@ -823,6 +838,11 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+    /*Even if not visible now the cached layers need to be updated*/
+    lv_refr_cache_layer_invalidate(obj);
+#endif
+
     lv_display_t * disp   = lv_obj_get_display(obj);
     if(!lv_display_is_invalidation_enabled(disp)) return;
 
@@ -1223,15 +1243,25 @@ static int32_t calc_content_height(lv_obj_t * obj)
 
 static void layout_update_core(lv_obj_t * obj)
 {
+    layout_visited_cnt++;
+
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_count(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+
+    /*Go only into the branches where something needs to be updated*/
+    if(obj->layout_child_inv) {
+        obj->layout_child_inv = 0;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            if(child->layout_inv || child->layout_child_inv || child->readjust_scroll_after_layout) {
+                layout_update_core(child);
+            }
+        }
     }
 
     if(obj->layout_inv) {
         obj->layout_inv = 0;
+        layout_updated_cnt++;
         lv_obj_refr_size(obj);
         lv_obj_refr_pos(obj);
 
@@ -1246,6 +1276,20 @@ static void layout_update_core(lv_obj_t * obj)
     }
 }
 
+/**
+ * Mark the parents of a widget to show that there is a layout update to do in their branch.
+ * The parents above an already marked parent are marked too, so stop there.
+ * @param obj       pointer to a widget whose layout or scroll position needs to be updated
+ */
+static void layout_mark_parents_dirty(lv_obj_t * obj)
+{
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent && !parent->layout_child_inv) {
+        parent->layout_child_inv = 1;
+        parent = lv_obj_get_parent(parent);
+    }
+}
+
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv)
 {
 #if LV_DRAW_TRANSFORM_USE_MATRIX
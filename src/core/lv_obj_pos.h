@@ -159,6 +159,19 @@ void lv_obj_mark_layout_as_dirty(lv_obj_t * obj);
  */
 void lv_obj_update_layout(const lv_obj_t * obj);
 
+/**
+ * Get the number of widgets visited by `lv_obj_update_layout()` since the start.
+ * Only the branches having a widget with an outdated layout are visited.
+ * @return      the number of visited widgets
+ */
+uint32_t lv_obj_get_layout_visited_count(void);
+
+/**
+ * Get the number of widgets whose size and position were recalculated by `lv_obj_update_layout()` since the start.
+ * @return      the number of updated widgets
+ */
+uint32_t lv_obj_get_layout_updated_count(void);
+
 /**
  * Change the alignment of an object.
  * @param obj       pointer to an object to align
@@ -43,6 +43,9 @@ struct _lv_obj_spec_attr_t {
     int32_t ext_click_pad;          /**< Extra click padding in all direction*/
     int32_t ext_draw_size;          /**< EXTend the size in every direction for drawing.*/
 
+    void * layout_cache;            /**< Data stored by the layout between the updates*/
+    uint32_t layout_cache_id;       /**< ID of the layout which stored `layout_cache`*/
+
     uint16_t child_cnt;             /**< Number of children*/
     uint16_t scrollbar_mode : 2;    /**< How to display scrollbars, see `lv_scrollbar_mode_t`*/
     uint16_t scroll_snap_x : 2;     /**< Where to align the snappable children horizontally, see `lv_scroll_snap_t`*/
@@ -60,6 +63,9 @@ struct _lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    lv_obj_style_resolved_cache_t * style_resolved_cache; /**< Allocated on the first style property read*/
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
@@ -69,6 +75,7 @@ struct _lv_obj_t {
     lv_obj_flag_t flags;
     lv_state_t state;
     uint16_t layout_inv : 1;
+    uint16_t layout_child_inv : 1;  /**< A descendant's layout needs to be updated*/
     uint16_t readjust_scroll_after_layout : 1;
     uint16_t scr_layout_inv : 1;
     uint16_t skip_trans : 1;
@@ -76,6 +83,8 @@ struct _lv_obj_t {
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
     uint16_t is_deleting : 1;
+    uint16_t cache_layer_inv : 1;   /**< The cached layer needs to be redrawn. See `LV_OBJ_FLAG_CACHE_LAYER`*/
+    uint16_t layout_item_inv : 1;   /**< The parent's layout needs to measure this widget again*/
 };
 
 /**********************
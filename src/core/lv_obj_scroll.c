@@ -9,10 +9,14 @@
 #include "lv_obj_scroll_private.h"
 #include "../misc/lv_anim_private.h"
 #include "lv_obj_private.h"
+#include "lv_obj_class_private.h"
+#include "lv_obj_draw_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_scroll.h"
 #include "../display/lv_display.h"
-#include "../misc/lv_area.h"
+#include "../misc/lv_area_private.h"
+#include "../misc/lv_event_private.h"
+#include "lv_refr_private.h"
 
 /*********************
  *      DEFINES
@@ -38,6 +42,13 @@ static void scroll_y_anim(void * obj, int32_t v);
 static void scroll_end_cb(lv_anim_t * a);
 static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_point_t * scroll_value,
                                   lv_anim_enable_t anim_en);
+#if LV_USE_SCROLL_SHIFT
+    static bool scroll_shift(lv_obj_t * obj, int32_t x, int32_t y, const lv_area_t * hor_area_ori,
+                             const lv_area_t * ver_area_ori);
+    static bool scroll_shift_get_area(lv_obj_t * obj, lv_area_t * area);
+    static bool draws_like_base_obj(lv_obj_t * obj);
+    static bool children_are_on(lv_obj_t * parent, uint32_t start_idx, const lv_area_t * area);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -416,12 +427,24 @@ lv_result_t lv_obj_scroll_by_raw(lv_obj_t * obj, int32_t x, int32_t y)
 
     lv_obj_allocate_spec_attr(obj);
 
+#if LV_USE_SCROLL_SHIFT
+    /*Save the scrollbars' position as they need to be redrawn there if the pixels are moved*/
+    lv_area_t hor_area_ori;
+    lv_area_t ver_area_ori;
+    lv_obj_get_scrollbar_area(obj, &hor_area_ori, &ver_area_ori);
+#endif
+
     obj->spec_attr->scroll.x += x;
     obj->spec_attr->scroll.y += y;
 
     lv_obj_move_children_by(obj, x, y, true);
     lv_result_t res = lv_obj_send_event(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RESULT_OK) return res;
+
+#if LV_USE_SCROLL_SHIFT
+    if(scroll_shift(obj, x, y, &hor_area_ori, &ver_area_ori)) return LV_RESULT_OK;
+#endif
+
     lv_obj_invalidate(obj);
     return LV_RESULT_OK;
 }
@@ -811,3 +834,173 @@ static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_p
     scroll_value->y += anim_en ? y_scroll : 0;
     lv_obj_scroll_by(parent, x_scroll, y_scroll, anim_en);
 }
+
+#if LV_USE_SCROLL_SHIFT
+
+/**
+ * Move the already rendered pixels of a scrolled widget instead of redrawing it.
+ * Only the revealed parts, the border, and the scrollbars are invalidated.
+ * @param obj           pointer to a widget which was scrolled
+ * @param x             the children were moved by this amount horizontally
+ * @param y             the children were moved by this amount vertically
+ * @param hor_area_ori  the area of the horizontal scrollbar before scrolling
+ * @param ver_area_ori  the area of the vertical scrollbar before scrolling
+ * @return              true: the pixels will be moved; false: the widget needs to be invalidated
+ */
+static bool scroll_shift(lv_obj_t * obj, int32_t x, int32_t y, const lv_area_t * hor_area_ori,
+                         const lv_area_t * ver_area_ori)
+{
+    lv_area_t shift_area;
+    if(!scroll_shift_get_area(obj, &shift_area)) return false;
+    if(!lv_refr_scroll_shift(lv_obj_get_display(obj), &shift_area, x, y)) return false;
+
+    /*The children are moved on the border and the rounded corners too but these parts are not shifted*/
+    lv_area_t areas[10];
+    lv_area_set(&areas[0], obj->coords.x1, obj->coords.y1, obj->coords.x2, shift_area.y1 - 1);
+    lv_area_set(&areas[1], obj->coords.x1, shift_area.y2 + 1, obj->coords.x2, obj->coords.y2);
+    lv_area_set(&areas[2], obj->coords.x1, shift_area.y1, shift_area.x1 - 1, shift_area.y2);
+    lv_area_set(&areas[3], shift_area.x2 + 1, shift_area.y1, obj->coords.x2, shift_area.y2);
+
+    /*The scrollbars don't move with the content so redraw them where they were,
+     *where their pixels were moved, and on their new position*/
+    areas[4] = *hor_area_ori;
+    areas[5] = *ver_area_ori;
+    areas[6] = *hor_area_ori;
+    areas[7] = *ver_area_ori;
+    lv_area_move(&areas[6], x, y);
+    lv_area_move(&areas[7], x, y);
+    lv_obj_get_scrollbar_area(obj, &areas[8], &areas[9]);
+
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        if(lv_area_get_width(&areas[i]) > 0 && lv_area_get_height(&areas[i]) > 0) {
+            lv_obj_invalidate_area(obj, &areas[i]);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Get the area of a scrolled widget whose pixels can be moved.
+ * Only the children can be drawn differently there after scrolling, so the widget needs
+ * to have a plain opaque background and nothing else can be drawn above it.
+ * @param obj       pointer to a widget which was scrolled
+ * @param area      store the area here in screen coordinates
+ * @return          true: `area` can be moved; false: the widget needs to be redrawn
+ */
+static bool scroll_shift_get_area(lv_obj_t * obj, lv_area_t * area)
+{
+    if(lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) != LV_OPA_COVER) return false;
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if(lv_obj_get_style_bg_grad(obj, LV_PART_MAIN) != NULL) return false;
+    if(lv_obj_get_style_bg_image_src(obj, LV_PART_MAIN) != NULL) return false;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+
+    /*Floating children don't move with the others*/
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    uint32_t i;
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING) && !lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) return false;
+    }
+
+    /*Skip the border and the rounded corners*/
+    int32_t w = lv_obj_get_width(obj);
+    int32_t h = lv_obj_get_height(obj);
+    int32_t radius = LV_MIN(lv_obj_get_style_radius(obj, LV_PART_MAIN), LV_MIN(w, h) / 2);
+    int32_t inner = LV_MAX(radius, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    *area = obj->coords;
+    lv_area_increase(area, -inner, -inner);
+    if(!lv_obj_area_is_visible(obj, area)) return false;
+
+    /*The parents need to be drawn directly to the screen and nothing can be drawn above the area*/
+    lv_obj_t * cur = obj;
+    while(1) {
+        if(lv_obj_get_layer_type(cur) != LV_LAYER_TYPE_NONE) return false;
+        if(lv_obj_get_style_opa(cur, LV_PART_MAIN) != LV_OPA_COVER) return false;
+        if(lv_obj_has_flag(cur, LV_OBJ_FLAG_CACHE_LAYER)) return false;
+        if(!draws_like_base_obj(cur)) return false;
+
+        lv_obj_t * parent = lv_obj_get_parent(cur);
+        if(parent == NULL) break;
+
+        if(lv_obj_get_style_border_post(parent, LV_PART_MAIN)) return false;
+
+        lv_area_t hor_area;
+        lv_area_t ver_area;
+        lv_obj_get_scrollbar_area(parent, &hor_area, &ver_area);
+        if(lv_area_get_size(&hor_area) > 0 && lv_area_is_on(&hor_area, area)) return false;
+        if(lv_area_get_size(&ver_area) > 0 && lv_area_is_on(&ver_area, area)) return false;
+
+        /*The siblings are drawn after the widget*/
+        if(children_are_on(parent, lv_obj_get_index(cur) + 1, area)) return false;
+
+        cur = parent;
+    }
+
+    /*Only on the active screen and nothing can be above it on the top and system layers*/
+    lv_display_t * disp = lv_obj_get_display(cur);
+    if(cur != lv_display_get_screen_active(disp)) return false;
+    if(lv_display_get_screen_prev(disp)) return false;
+    if(children_are_on(lv_display_get_layer_top(disp), 0, area)) return false;
+    if(children_are_on(lv_display_get_layer_sys(disp), 0, area)) return false;
+
+    return true;
+}
+
+/**
+ * Check if a widget draws only what `lv_obj_class` draws, that is
+ * nothing is drawn above its children except its scrollbars and border
+ * @param obj       pointer to a widget
+ * @return          true: only the base widget's parts are drawn
+ */
+static bool draws_like_base_obj(lv_obj_t * obj)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS)) return false;
+
+    const lv_obj_class_t * class_p = obj->class_p;
+    while(class_p && class_p != &lv_obj_class) {
+        if(class_p->event_cb) return false;
+        class_p = class_p->base_class;
+    }
+
+    uint32_t event_cnt = lv_obj_get_event_count(obj);
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        lv_event_dsc_t * dsc = lv_obj_get_event_dsc(obj, i);
+        uint32_t code = dsc->filter & ~(LV_EVENT_PREPROCESS | LV_EVENT_MARKED_DELETING);
+        if(code == LV_EVENT_ALL) return false;
+        if(code >= LV_EVENT_COVER_CHECK && code <= LV_EVENT_DRAW_TASK_ADDED) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Check if the visible children of a widget are on an area
+ * @param parent        pointer to a widget
+ * @param start_idx     check the children from this index
+ * @param area          the area to check in screen coordinates
+ * @return              true: at least one child can be drawn on the area
+ */
+static bool children_are_on(lv_obj_t * parent, uint32_t start_idx, const lv_area_t * area)
+{
+    uint32_t child_cnt = lv_obj_get_child_count(parent);
+    uint32_t i;
+    for(i = start_idx; i < child_cnt; i++) {
+        lv_obj_t * child = parent->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return true;
+
+        lv_area_t child_area = child->coords;
+        int32_t ext_size = lv_obj_get_ext_draw_size(child);
+        lv_area_increase(&child_area, ext_size, ext_size);
+        lv_obj_get_transformed_area(child, &child_area, LV_OBJ_POINT_TRANSFORM_FLAG_RECURSIVE);
+        if(lv_area_is_on(&child_area, area)) return true;
+    }
+
+    return false;
+}
+
+#endif /*LV_USE_SCROLL_SHIFT*/
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj_private.h"
 #include "../misc/lv_anim_private.h"
+#include "../misc/lv_style_private.h"
 #include "lv_obj_style_private.h"
 #include "lv_obj_class_private.h"
 #include "../display/lv_display.h"
@@ -24,6 +25,10 @@
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE & (LV_OBJ_STYLE_RESOLVED_CACHE_SIZE - 1)
+#error "LV_OBJ_STYLE_RESOLVED_CACHE_SIZE must be a power of 2"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -66,6 +71,10 @@ static void full_cache_refresh(lv_obj_t * obj, lv_part_t part);
 static void fade_anim_cb(void * obj, int32_t v);
 static void fade_in_anim_completed(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+static lv_obj_style_resolved_t * get_resolved_cache_entry(lv_obj_t * obj, lv_style_selector_t selector,
+                                                          lv_style_prop_t prop);
+#endif
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act);
 
@@ -228,7 +237,7 @@ void lv_obj_remove_style(lv_obj_t * obj, const lv_style_t * style, lv_style_sele
         }
 
         if(obj->styles[i].is_local || obj->styles[i].is_trans) {
-            if(obj->styles[i].style) lv_style_reset((lv_style_t *)obj->styles[i].style);
+            if(obj->styles[i].style) lv_style_reset_owned((lv_style_t *)obj->styles[i].style);
             lv_free((lv_style_t *)obj->styles[i].style);
             obj->styles[i].style = NULL;
         }
@@ -260,6 +269,9 @@ void lv_obj_remove_style_all(lv_obj_t * obj)
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+    /*Any widget might use this style*/
+    lv_style_invalidate_resolved_cache();
+
     if(!style_refr) return;
     lv_display_t * d = lv_display_get_next(NULL);
 
@@ -276,14 +288,19 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*The resolved values might be outdated even if refreshing is disabled.
+     *The children inherit only the properties of the main part*/
+    lv_part_t part = lv_obj_style_get_selector_part(selector);
+    bool inherited = (part == LV_PART_ANY || part == LV_PART_MAIN) &&
+                     (prop == LV_STYLE_PROP_ANY || lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE));
+    lv_obj_style_invalidate_resolved_cache(obj, inherited);
+
     if(!style_refr) return;
 
     LV_PROFILER_STYLE_BEGIN;
 
     lv_obj_invalidate(obj);
 
-    lv_part_t part = lv_obj_style_get_selector_part(selector);
-
     bool is_layout_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYOUT_UPDATE);
     bool is_ext_draw = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_EXT_DRAW_UPDATE);
     bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE);
@@ -300,6 +317,7 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     }
     if((part == LV_PART_ANY || part == LV_PART_MAIN) && (prop == LV_STYLE_PROP_ANY || is_layout_refr)) {
         lv_obj_t * parent = lv_obj_get_parent(obj);
+        obj->layout_item_inv = 1;
         if(parent) lv_obj_mark_layout_as_dirty(parent);
     }
 
@@ -363,13 +381,35 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
     LV_ASSERT_NULL(obj)
 
     lv_style_selector_t selector = part | obj->state;
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    /*Transitions are skipped only temporarily while they are created, so don't cache these values*/
+    lv_obj_style_resolved_t * entry = NULL;
+    if(!obj->skip_trans) {
+        entry = get_resolved_cache_entry((lv_obj_t *)obj, selector, prop);
+        if(entry && entry->prop == prop && entry->selector == selector &&
+           entry->generation == obj->style_resolved_cache->generation) {
+            return entry->value;
+        }
+    }
+#endif
+
     lv_style_value_t value_act = { .ptr = NULL };
     lv_style_res_t found;
 
     found = get_selector_style_prop(obj, selector, prop, &value_act);
-    if(found == LV_STYLE_RES_FOUND) return value_act;
+    if(found != LV_STYLE_RES_FOUND) value_act = lv_style_prop_get_default(prop);
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    if(entry) {
+        entry->value = value_act;
+        entry->generation = obj->style_resolved_cache->generation;
+        entry->selector = selector;
+        entry->prop = prop;
+    }
+#endif
 
-    return lv_style_prop_get_default(prop);
+    return value_act;
 }
 
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
@@ -398,7 +438,7 @@ void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_
         lv_obj_invalidate(obj);
     }
 
-    lv_style_set_prop(style, prop, value);
+    lv_style_set_owned_prop(style, prop, value);
 
 #if LV_OBJ_STYLE_CACHE
     uint32_t prop_shifted = STYLE_PROP_SHIFTED(prop);
@@ -444,7 +484,7 @@ bool lv_obj_remove_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_sty
     /*The style is not found*/
     if(i == obj->style_cnt) return false;
 
-    lv_result_t res = lv_style_remove_prop((lv_style_t *)obj->styles[i].style, prop);
+    lv_result_t res = lv_style_remove_owned_prop((lv_style_t *)obj->styles[i].style, prop);
     if(res == LV_RESULT_OK) {
         full_cache_refresh(obj, lv_obj_style_get_selector_part(selector));
         lv_obj_refresh_style(obj, selector, prop);
@@ -453,6 +493,24 @@ bool lv_obj_remove_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_sty
     return res;
 }
 
+void lv_obj_style_invalidate_resolved_cache(lv_obj_t * obj, bool children)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    if(obj->style_resolved_cache) obj->style_resolved_cache->generation++;
+
+    if(children) {
+        uint32_t i;
+        uint32_t child_cnt = lv_obj_get_child_count(obj);
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_style_invalidate_resolved_cache(obj->spec_attr->children[i], true);
+        }
+    }
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(children);
+#endif
+}
+
 void lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t prev_state, lv_state_t new_state,
                                     const lv_obj_style_transition_dsc_t * tr_dsc)
 {
@@ -472,7 +530,8 @@ void lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t p
     obj->state = new_state;
 
     lv_obj_style_t * style_trans = get_trans_style(obj, part);
-    lv_style_set_prop((lv_style_t *)style_trans->style, tr_dsc->prop, v1);  /*Be sure `trans_style` has a valid value*/
+    /*Be sure `trans_style` has a valid value*/
+    lv_style_set_owned_prop((lv_style_t *)style_trans->style, tr_dsc->prop, v1);
     lv_obj_refresh_style(obj, tr_dsc->selector, tr_dsc->prop);
 
     if(tr_dsc->prop == LV_STYLE_RADIUS) {
@@ -912,7 +971,9 @@ static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, t
             uint32_t i;
             for(i = 0; i < obj->style_cnt; i++) {
                 if(obj->styles[i].is_trans && (part == LV_PART_ANY || obj->styles[i].selector == part)) {
-                    lv_style_remove_prop((lv_style_t *)obj->styles[i].style, tr->prop);
+                    lv_style_remove_owned_prop((lv_style_t *)obj->styles[i].style, tr->prop);
+                    lv_obj_style_invalidate_resolved_cache(obj, lv_style_prop_has_flag(tr->prop,
+                                                                                       LV_STYLE_PROP_FLAG_INHERITABLE));
                 }
             }
 
@@ -985,7 +1046,7 @@ static void trans_anim_cb(void * _tr, int32_t v)
                 refr = false;
             }
         }
-        lv_style_set_prop((lv_style_t *)obj->styles[i].style, tr->prop, value_final);
+        lv_style_set_owned_prop((lv_style_t *)obj->styles[i].style, tr->prop, value_final);
         if(refr) lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
         break;
 
@@ -1011,7 +1072,7 @@ static void trans_anim_start_cb(lv_anim_t * a)
 
     lv_obj_style_t * style_trans = get_trans_style(tr->obj, tr->selector);
     /*Be sure `trans_style` has a valid value*/
-    lv_style_set_prop((lv_style_t *)style_trans->style, tr->prop, tr->start_value);
+    lv_style_set_owned_prop((lv_style_t *)style_trans->style, tr->prop, tr->start_value);
     lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
 
 }
@@ -1042,7 +1103,9 @@ static void trans_anim_completed_cb(lv_anim_t * a)
                 lv_free(tr);
 
                 lv_obj_style_t * obj_style = &obj->styles[i];
-                lv_style_remove_prop((lv_style_t *)obj_style->style, prop);
+                lv_style_remove_owned_prop((lv_style_t *)obj_style->style, prop);
+                lv_obj_style_invalidate_resolved_cache(obj, lv_style_prop_has_flag(prop,
+                                                                                   LV_STYLE_PROP_FLAG_INHERITABLE));
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, (lv_style_t *)obj_style->style, obj_style->selector);
@@ -1156,6 +1219,39 @@ static bool style_has_flag(const lv_style_t * style, uint32_t flag)
     return false;
 }
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+/**
+ * Get the slot of the resolved style cache where a property of a part is stored.
+ * The cache is direct mapped, so the returned entry might hold an other property.
+ * @param obj       pointer to a widget
+ * @param selector  part and state of the property
+ * @param prop      the property
+ * @return          pointer to the entry or NULL if the cache couldn't be allocated
+ */
+static lv_obj_style_resolved_t * get_resolved_cache_entry(lv_obj_t * obj, lv_style_selector_t selector,
+                                                          lv_style_prop_t prop)
+{
+    lv_obj_style_resolved_cache_t * cache = obj->style_resolved_cache;
+    if(cache == NULL) {
+        cache = lv_malloc_zeroed(sizeof(lv_obj_style_resolved_cache_t));
+        if(cache == NULL) return NULL;
+        cache->style_generation = lv_style_get_generation();
+        obj->style_resolved_cache = cache;
+    }
+
+    /*A shared style has changed since the last lookup*/
+    if(cache->style_generation != lv_style_get_generation()) {
+        cache->style_generation = lv_style_get_generation();
+        cache->generation++;
+    }
+
+    /*The parts are in the upper bits of the selector, spread them over the slots too*/
+    uint32_t part_id = lv_obj_style_get_selector_part(selector) >> 16;
+    uint32_t idx = (prop + part_id * 7) & (LV_OBJ_STYLE_RESOLVED_CACHE_SIZE - 1);
+    return &cache->entries[idx];
+}
+#endif
+
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act)
 {
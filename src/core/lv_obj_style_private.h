@@ -32,6 +32,23 @@ struct _lv_obj_style_t {
     uint32_t is_disabled : 1;
 };
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+/** An entry of the per-widget cache of the resolved style properties*/
+struct _lv_obj_style_resolved_t {
+    lv_style_value_t value;         /**< The resolved value (found in a style, inherited or the default)*/
+    uint32_t generation;            /**< The generation of the cache when the value was resolved*/
+    lv_style_selector_t selector;   /**< Part and state the value was resolved for*/
+    lv_style_prop_t prop;           /**< `LV_STYLE_PROP_INV` if the entry is unused*/
+};
+
+/** The per-widget cache of the resolved style properties*/
+struct _lv_obj_style_resolved_cache_t {
+    uint32_t style_generation;      /**< The generation of the shared styles the entries were resolved with*/
+    uint32_t generation;            /**< Increased to make all entries outdated*/
+    lv_obj_style_resolved_t entries[LV_OBJ_STYLE_RESOLVED_CACHE_SIZE];
+};
+#endif
+
 struct _lv_obj_style_transition_dsc_t {
     uint16_t time;
     uint16_t delay;
@@ -58,6 +75,14 @@ void lv_obj_style_init(void);
  */
 void lv_obj_style_deinit(void);
 
+/**
+ * Mark the resolved style properties cached by a widget as outdated.
+ * Called when the styles, state or parent of the widget change.
+ * @param obj       pointer to a widget
+ * @param children  true: the children too, because the values they inherit might have changed
+ */
+void lv_obj_style_invalidate_resolved_cache(lv_obj_t * obj, bool children);
+
 /**
  * Used internally to create a style transition
  * @param obj
@@ -13,6 +13,8 @@
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../misc/lv_anim_private.h"
+#include "../misc/lv_style_private.h"
+#include "lv_obj_style_private.h"
 #include "../misc/lv_async.h"
 #include "../core/lv_global.h"
 
@@ -191,6 +193,9 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 
     obj->parent = parent;
 
+    /*The inherited style properties might be different with the new parent*/
+    lv_obj_style_invalidate_resolved_cache(obj, true);
+
     /*Notify the original parent because one of its children is lost*/
     lv_obj_scrollbar_invalidate(old_parent);
     lv_obj_send_event(old_parent, LV_EVENT_CHILD_CHANGED, obj);
@@ -200,6 +205,7 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     lv_obj_send_event(parent, LV_EVENT_CHILD_CHANGED, obj);
     lv_obj_send_event(parent, LV_EVENT_CHILD_CREATED, NULL);
 
+    obj->layout_item_inv = 1;
     lv_obj_mark_layout_as_dirty(obj);
 
     lv_obj_invalidate(obj);
@@ -274,6 +280,11 @@ void lv_obj_swap(lv_obj_t * obj1, lv_obj_t * obj2)
     parent2->spec_attr->children[index2] = obj1;
     obj1->parent = parent2;
 
+    if(parent != parent2) {
+        lv_obj_style_invalidate_resolved_cache(obj1, true);
+        lv_obj_style_invalidate_resolved_cache(obj2, true);
+    }
+
     lv_obj_send_event(parent, LV_EVENT_CHILD_CHANGED, obj2);
     lv_obj_send_event(parent, LV_EVENT_CHILD_CREATED, obj2);
     lv_obj_send_event(parent2, LV_EVENT_CHILD_CHANGED, obj1);
@@ -23,6 +23,8 @@
 #include "../draw/lv_draw_private.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../stdlib/lv_string.h"
+#include "../misc/cache/lv_cache.h"
+#include "../misc/cache/instance/lv_image_cache.h"
 #include "lv_global.h"
 
 /*********************
@@ -31,17 +33,37 @@
 
 /*Display being refreshed*/
 #define disp_refr LV_GLOBAL_DEFAULT()->disp_refresh
+#define layer_cache_p (LV_GLOBAL_DEFAULT()->layer_cache)
+#define layer_cache_acquired (LV_GLOBAL_DEFAULT()->layer_cache_acquired)
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+typedef struct {
+    lv_cache_slot_size_t slot;
+    const lv_obj_t * obj;       /**< The key*/
+    int32_t w;                  /**< Size of the widget with the ext. draw size*/
+    int32_t h;
+    lv_draw_buf_t * draw_buf;
+    bool rendered;
+} cache_layer_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static int32_t inv_area_join_cost(const lv_area_t * a1_p, const lv_area_t * a2_p);
+static bool inv_area_join_is_cheap(const lv_area_t * a1_p, const lv_area_t * a2_p);
+static void inv_area_remove(lv_display_t * disp, uint32_t idx);
+static void inv_area_coalesce(lv_display_t * disp, lv_area_t * area_p);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
+static void refr_tiles(void);
+static void refr_tiles_of_areas(void);
+static void refr_tile(int32_t col, int32_t row, bool last);
 static void refr_area(const lv_area_t * area_p, int32_t y_offset);
 static void refr_configured_layer(lv_layer_t * layer);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
@@ -51,6 +73,28 @@ static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 static void wait_for_flushing(lv_display_t * disp);
 
+#if LV_USE_SCROLL_SHIFT
+    static void refr_scroll_shift(void);
+#endif
+
+#if LV_USE_OCCLUSION_CULLING
+    static void occluders_collect(lv_layer_t * layer);
+    static void occluders_collect_obj(lv_obj_t * obj, const lv_area_t * clip_area);
+    static void occluder_add(lv_obj_t * obj, const lv_area_t * area);
+    static bool occlusion_clip(lv_obj_t * obj, lv_area_t * area);
+    static bool obj_is_drawn_after(lv_obj_t * obj, lv_obj_t * other);
+    static uint32_t root_get_draw_order(lv_obj_t * root);
+#endif
+
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+    static bool refr_obj_cached(lv_layer_t * layer, lv_obj_t * obj, lv_opa_t opa_layered);
+    static void cache_layer_render(lv_obj_t * obj, cache_layer_t * cached, const lv_area_t * area);
+    static void cache_layer_release_all(void);
+    static bool cache_layer_create_cb(cache_layer_t * node, void * user_data);
+    static void cache_layer_free_cb(cache_layer_t * node, void * user_data);
+    static lv_cache_compare_res_t cache_layer_compare_cb(const cache_layer_t * lhs, const cache_layer_t * rhs);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -73,10 +117,28 @@ static void wait_for_flushing(lv_display_t * disp);
  */
 void lv_refr_init(void)
 {
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)cache_layer_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)cache_layer_create_cb,
+        .free_cb = (lv_cache_free_cb_t)cache_layer_free_cb,
+    };
+
+    layer_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(cache_layer_t),
+                                    LV_DRAW_LAYER_CACHE_MAX_MEMORY, ops);
+    lv_cache_set_name(layer_cache_p, "LAYER");
+    lv_array_init(&layer_cache_acquired, 8, sizeof(lv_cache_entry_t *));
+#endif
 }
 
 void lv_refr_deinit(void)
 {
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+    cache_layer_release_all();
+    lv_array_deinit(&layer_cache_acquired);
+    lv_cache_destroy(layer_cache_p, NULL);
+    layer_cache_p = NULL;
+#endif
 }
 
 void lv_refr_now(lv_display_t * disp)
@@ -112,6 +174,15 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
         LV_PROFILER_REFR_END;
         return;
     }
+
+#if LV_USE_OCCLUSION_CULLING
+    /*Skip the widget or a part of it if it's covered by opaque widgets drawn later*/
+    if(disp_refr && layer == disp_refr->occluder_layer && !occlusion_clip(obj, &clip_coords_for_obj)) {
+        LV_PROFILER_REFR_END;
+        return;
+    }
+#endif
+
     /*If the object is visible on the current clip area*/
     layer->_clip_area = clip_coords_for_obj;
 
@@ -300,6 +371,15 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
         com_area.x2 |= 0x7;    /*Round up: Nx8 - 1*/
     }
 
+    if(disp->render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        /*Always whole tiles are refreshed so align the area to the tiles*/
+        com_area.x1 -= com_area.x1 % LV_DISPLAY_RENDER_TILE_SIZE;
+        com_area.y1 -= com_area.y1 % LV_DISPLAY_RENDER_TILE_SIZE;
+        com_area.x2 += LV_DISPLAY_RENDER_TILE_SIZE - 1 - com_area.x2 % LV_DISPLAY_RENDER_TILE_SIZE;
+        com_area.y2 += LV_DISPLAY_RENDER_TILE_SIZE - 1 - com_area.y2 % LV_DISPLAY_RENDER_TILE_SIZE;
+        lv_area_intersect(&com_area, &com_area, &scr_area);
+    }
+
     /*If there were at least 1 invalid area in full refresh mode, redraw the whole screen*/
     if(disp->render_mode == LV_DISPLAY_RENDER_MODE_FULL) {
         disp->inv_areas[0] = scr_area;
@@ -312,18 +392,34 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     if(res != LV_RESULT_OK) return;
 
     /*Save only if this area is not in one of the saved areas*/
-    uint16_t i;
+    uint32_t i;
     for(i = 0; i < disp->inv_p; i++) {
         if(lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
     }
 
-    /*Save the area*/
-    lv_area_t * tmp_area_p = &com_area;
-    if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        tmp_area_p = &scr_area;
+    /*Merge the saved areas into the new one where it's cheaper than refreshing them separately*/
+    inv_area_coalesce(disp, &com_area);
+
+    /*If there is no place for the new area merge it with the saved area where it causes the least overdraw.
+     *The merged area can cover other saved areas too, so coalesce again.*/
+    while(disp->inv_p >= LV_INV_BUF_SIZE) {
+        uint32_t best_i = 0;
+        int32_t best_cost = INT32_MAX;
+        for(i = 0; i < disp->inv_p; i++) {
+            int32_t cost = inv_area_join_cost(&disp->inv_areas[i], &com_area);
+            if(cost < best_cost) {
+                best_cost = cost;
+                best_i = i;
+            }
+        }
+
+        lv_area_join(&com_area, &com_area, &disp->inv_areas[best_i]);
+        inv_area_remove(disp, best_i);
+        inv_area_coalesce(disp, &com_area);
     }
-    lv_area_copy(&disp->inv_areas[disp->inv_p], tmp_area_p);
+
+    /*Save the area*/
+    lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
     disp->inv_p++;
 
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
@@ -347,6 +443,94 @@ void lv_refr_set_disp_refreshing(lv_display_t * disp)
     disp_refr = disp;
 }
 
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+
+void lv_refr_cache_layer_invalidate(const lv_obj_t * obj)
+{
+    lv_obj_t * parent = (lv_obj_t *)obj;
+    while(parent) {
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_CACHE_LAYER)) parent->cache_layer_inv = 1;
+        parent = lv_obj_get_parent(parent);
+    }
+}
+
+void lv_refr_cache_layer_drop(const lv_obj_t * obj)
+{
+    if(layer_cache_p == NULL) return;
+
+    cache_layer_t search_key;
+    search_key.obj = obj;
+    lv_cache_drop(layer_cache_p, &search_key, NULL);
+}
+
+#endif /*LV_DRAW_LAYER_CACHE_MAX_MEMORY*/
+
+#if LV_USE_SCROLL_SHIFT
+
+bool lv_refr_scroll_shift(lv_display_t * disp, const lv_area_t * area, int32_t x, int32_t y)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) return false;
+    if(!lv_display_is_invalidation_enabled(disp)) return false;
+    if(disp->rendering_in_progress) return false;
+
+    /*Only in direct mode has the draw buffer the previously rendered pixels on their screen position*/
+    if(disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) return false;
+    if(disp->buf_3) return false;
+    if(lv_display_get_rotation(disp) != LV_DISPLAY_ROTATION_0) return false;
+    if(lv_display_get_matrix_rotation(disp)) return false;
+    if(lv_color_format_get_bpp(disp->color_format) < 8) return false;
+
+    lv_area_t scr_area;
+    lv_area_set(&scr_area, 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                lv_display_get_vertical_resolution(disp) - 1);
+
+    lv_area_t shift_area;
+    if(!lv_area_intersect(&shift_area, area, &scr_area)) return false;
+
+    /*Only one area can be moved in a refresh. Scrolling the same area again just moves it further.*/
+    bool pending = disp->scroll_shift.x != 0 || disp->scroll_shift.y != 0;
+    if(pending && lv_memcmp(&shift_area, &disp->scroll_shift_area, sizeof(lv_area_t)) != 0) return false;
+
+    int32_t shift_x = disp->scroll_shift.x + x;
+    int32_t shift_y = disp->scroll_shift.y + y;
+    if(LV_ABS(shift_x) >= lv_area_get_width(&shift_area)) return false;
+    if(LV_ABS(shift_y) >= lv_area_get_height(&shift_area)) return false;
+
+    disp->scroll_shift_area = shift_area;
+    disp->scroll_shift.x = shift_x;
+    disp->scroll_shift.y = shift_y;
+
+    /*The pending areas are redrawn after moving the pixels,
+     *so the moved pixels of these areas are outdated too*/
+    lv_area_t inv_areas[LV_INV_BUF_SIZE];
+    uint32_t inv_cnt = disp->inv_p;
+    lv_memcpy(inv_areas, disp->inv_areas, inv_cnt * sizeof(lv_area_t));
+
+    uint32_t i;
+    for(i = 0; i < inv_cnt; i++) {
+        lv_area_t moved_area;
+        if(!lv_area_intersect(&moved_area, &inv_areas[i], &shift_area)) continue;
+        lv_area_move(&moved_area, x, y);
+        if(lv_area_intersect(&moved_area, &moved_area, &shift_area)) lv_inv_area(disp, &moved_area);
+    }
+
+    /*Invalidate the newly revealed parts*/
+    lv_area_t revealed_area = shift_area;
+    if(y > 0) revealed_area.y2 = shift_area.y1 + y - 1;
+    else if(y < 0) revealed_area.y1 = shift_area.y2 + y + 1;
+    if(y != 0 && lv_area_intersect(&revealed_area, &revealed_area, &shift_area)) lv_inv_area(disp, &revealed_area);
+
+    revealed_area = shift_area;
+    if(x > 0) revealed_area.x2 = shift_area.x1 + x - 1;
+    else if(x < 0) revealed_area.x1 = shift_area.x2 + x + 1;
+    if(x != 0 && lv_area_intersect(&revealed_area, &revealed_area, &shift_area)) lv_inv_area(disp, &revealed_area);
+
+    return true;
+}
+
+#endif /*LV_USE_SCROLL_SHIFT*/
+
 void lv_display_refr_timer(lv_timer_t * tmr)
 {
     LV_PROFILER_REFR_BEGIN;
@@ -421,8 +605,9 @@ void lv_display_refr_timer(lv_timer_t * tmr)
 
 refr_finish:
 
-#if LV_DRAW_SW_COMPLEX == 1
-    lv_draw_sw_mask_cleanup();
+#if LV_USE_SCROLL_SHIFT
+    disp_refr->scroll_shift.x = 0;
+    disp_refr->scroll_shift.y = 0;
 #endif
 
     lv_display_send_event(disp_refr, LV_EVENT_REFR_READY, NULL);
@@ -497,16 +682,9 @@ static void lv_refr_join_area(void)
                 continue;
             }
 
-            /*Check if the areas are on each other*/
-            if(lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
-            }
-
-            lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
-
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
+            /*Join two area only if it's cheaper than refreshing them separately*/
+            if(inv_area_join_is_cheap(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from])) {
+                lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
                 lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
 
                 /*Mark 'join_form' is joined into 'join_in'*/
@@ -517,6 +695,79 @@ static void lv_refr_join_area(void)
     LV_PROFILER_REFR_END;
 }
 
+/**
+ * Get the number of extra pixels which would be redrawn if two areas were refreshed as their bounding box
+ * @param a1_p      pointer to an area
+ * @param a2_p      pointer to an other area
+ * @return          size of the bounding box minus the size of the union of the areas
+ */
+static int32_t inv_area_join_cost(const lv_area_t * a1_p, const lv_area_t * a2_p)
+{
+    lv_area_t joined_area;
+    lv_area_join(&joined_area, a1_p, a2_p);
+
+    int32_t union_size = lv_area_get_size(a1_p) + lv_area_get_size(a2_p);
+    lv_area_t common_area;
+    if(lv_area_intersect(&common_area, a1_p, a2_p)) union_size -= lv_area_get_size(&common_area);
+
+    return lv_area_get_size(&joined_area) - union_size;
+}
+
+/**
+ * Tell if it's cheaper to refresh two areas as their bounding box than one by one.
+ * Refreshing the areas separately renders their common part twice
+ * and has `LV_INV_AREA_JOIN_OVERHEAD` extra cost.
+ * @param a1_p      pointer to an area
+ * @param a2_p      pointer to an other area
+ * @return          true: the areas should be joined
+ */
+static bool inv_area_join_is_cheap(const lv_area_t * a1_p, const lv_area_t * a2_p)
+{
+    lv_area_t joined_area;
+    lv_area_join(&joined_area, a1_p, a2_p);
+
+    return lv_area_get_size(&joined_area) < lv_area_get_size(a1_p) + lv_area_get_size(a2_p) +
+           LV_INV_AREA_JOIN_OVERHEAD;
+}
+
+/**
+ * Remove a saved invalid area and keep the order of the others
+ * @param disp      pointer to a display
+ * @param idx       index of the area to remove
+ */
+static void inv_area_remove(lv_display_t * disp, uint32_t idx)
+{
+    disp->inv_p--;
+    if(idx < disp->inv_p) {
+        lv_memmove(&disp->inv_areas[idx], &disp->inv_areas[idx + 1], (disp->inv_p - idx) * sizeof(lv_area_t));
+    }
+}
+
+/**
+ * Merge the saved invalid areas into a new area if they are covered by it
+ * or if joining them is cheaper than refreshing them separately.
+ * As the new area grows it can swallow other saved areas too, so repeat it until nothing changes.
+ * @param disp      pointer to a display
+ * @param area_p    the new area. It's updated with the merged areas.
+ */
+static void inv_area_coalesce(lv_display_t * disp, lv_area_t * area_p)
+{
+    uint32_t i = 0;
+    while(i < disp->inv_p) {
+        if(lv_area_is_in(&disp->inv_areas[i], area_p, 0)) {
+            inv_area_remove(disp, i);
+        }
+        else if(inv_area_join_is_cheap(&disp->inv_areas[i], area_p)) {
+            lv_area_join(area_p, area_p, &disp->inv_areas[i]);
+            inv_area_remove(disp, i);
+            i = 0; /*The area has grown, check the already visited areas again*/
+        }
+        else {
+            i++;
+        }
+    }
+}
+
 /**
  * Refresh the sync areas
  */
@@ -643,64 +894,197 @@ static void refr_invalid_areas(void)
     disp_refr->last_area = 0;
     disp_refr->last_part = 0;
     disp_refr->rendering_in_progress = true;
+#if LV_USE_OCCLUSION_CULLING
+    disp_refr->culled_px_cnt = 0;
+#endif
 
-    for(i = 0; i < (int32_t)disp_refr->inv_p; i++) {
-        /*Refresh the unjoined areas*/
-        if(disp_refr->inv_area_joined[i]) continue;
+    if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        refr_tiles();
+    }
+    else {
+#if LV_USE_SCROLL_SHIFT
+        if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_DIRECT) refr_scroll_shift();
+#endif
 
-        if(i == last_i) disp_refr->last_area = 1;
-        disp_refr->last_part = 0;
-
-        lv_area_t inv_a = disp_refr->inv_areas[i];
-        if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
-            /*Calculate the max row num*/
-            int32_t w = lv_area_get_width(&inv_a);
-            int32_t h = lv_area_get_height(&inv_a);
-
-            int32_t max_row = get_max_row(disp_refr, w, h);
-
-            int32_t row;
-            int32_t row_last = 0;
-            lv_area_t sub_area;
-            sub_area.x1 = inv_a.x1;
-            sub_area.x2 = inv_a.x2;
-            int32_t y_off = 0;
-            for(row = inv_a.y1; row + max_row - 1 <= inv_a.y2; row += max_row) {
-                /*Calc. the next y coordinates of draw_buf*/
-                sub_area.y1 = row;
-                sub_area.y2 = row + max_row - 1;
-                if(sub_area.y2 > inv_a.y2) sub_area.y2 = inv_a.y2;
-                row_last = sub_area.y2;
-                if(inv_a.y2 == row_last) disp_refr->last_part = 1;
-                refr_area(&sub_area, y_off);
-                y_off += lv_area_get_height(&sub_area);
-                draw_buf_flush(disp_refr);
-            }
+        for(i = 0; i < (int32_t)disp_refr->inv_p; i++) {
+            /*Refresh the unjoined areas*/
+            if(disp_refr->inv_area_joined[i]) continue;
+
+            if(i == last_i) disp_refr->last_area = 1;
+            disp_refr->last_part = 0;
+
+            lv_area_t inv_a = disp_refr->inv_areas[i];
+            if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+                /*Calculate the max row num*/
+                int32_t w = lv_area_get_width(&inv_a);
+                int32_t h = lv_area_get_height(&inv_a);
+
+                int32_t max_row = get_max_row(disp_refr, w, h);
+
+                int32_t row;
+                int32_t row_last = 0;
+                lv_area_t sub_area;
+                sub_area.x1 = inv_a.x1;
+                sub_area.x2 = inv_a.x2;
+                int32_t y_off = 0;
+                for(row = inv_a.y1; row + max_row - 1 <= inv_a.y2; row += max_row) {
+                    /*Calc. the next y coordinates of draw_buf*/
+                    sub_area.y1 = row;
+                    sub_area.y2 = row + max_row - 1;
+                    if(sub_area.y2 > inv_a.y2) sub_area.y2 = inv_a.y2;
+                    row_last = sub_area.y2;
+                    if(inv_a.y2 == row_last) disp_refr->last_part = 1;
+                    refr_area(&sub_area, y_off);
+                    y_off += lv_area_get_height(&sub_area);
+                    draw_buf_flush(disp_refr);
+                }
 
-            /*If the last y coordinates are not handled yet ...*/
-            if(inv_a.y2 != row_last) {
-                /*Calc. the next y coordinates of draw_buf*/
-                sub_area.y1 = row;
-                sub_area.y2 = inv_a.y2;
+                /*If the last y coordinates are not handled yet ...*/
+                if(inv_a.y2 != row_last) {
+                    /*Calc. the next y coordinates of draw_buf*/
+                    sub_area.y1 = row;
+                    sub_area.y2 = inv_a.y2;
+                    disp_refr->last_part = 1;
+                    refr_area(&sub_area, y_off);
+                    y_off += lv_area_get_height(&sub_area);
+                    draw_buf_flush(disp_refr);
+                }
+            }
+            else if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_FULL ||
+                    disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_DIRECT) {
                 disp_refr->last_part = 1;
-                refr_area(&sub_area, y_off);
-                y_off += lv_area_get_height(&sub_area);
+                refr_area(&disp_refr->inv_areas[i], 0);
                 draw_buf_flush(disp_refr);
             }
         }
-        else if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_FULL ||
-                disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_DIRECT) {
-            disp_refr->last_part = 1;
-            refr_area(&disp_refr->inv_areas[i], 0);
-            draw_buf_flush(disp_refr);
-        }
     }
 
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+    /*All the draw tasks are ready, the cached layers are not used anymore*/
+    cache_layer_release_all();
+#endif
+
     lv_display_send_event(disp_refr, LV_EVENT_RENDER_READY, NULL);
     disp_refr->rendering_in_progress = false;
     LV_PROFILER_REFR_END;
 }
 
+/**
+ * Refresh the invalidated tiles one by one in `LV_DISPLAY_RENDER_MODE_TILED`.
+ * The tiles covered by the joined areas are marked as dirty first
+ * so that the tiles shared by multiple areas are rendered and flushed only once.
+ * If there is no memory for the map of the dirty tiles, the tiles of each area are refreshed one by one.
+ */
+static void refr_tiles(void)
+{
+    LV_PROFILER_REFR_BEGIN;
+    const int32_t tile_size = LV_DISPLAY_RENDER_TILE_SIZE;
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp_refr);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp_refr);
+    int32_t col_cnt = (hor_res + tile_size - 1) / tile_size;
+    int32_t row_cnt = (ver_res + tile_size - 1) / tile_size;
+
+    /*Reallocate the map only if the number of tiles has changed (e.g. the display was rotated)*/
+    uint32_t tile_cnt = col_cnt * row_cnt;
+    if(disp_refr->dirty_tile_cnt != tile_cnt) {
+        lv_free(disp_refr->dirty_tiles);
+        disp_refr->dirty_tiles = lv_malloc(tile_cnt);
+        LV_ASSERT_MALLOC(disp_refr->dirty_tiles);
+        if(disp_refr->dirty_tiles == NULL) {
+            disp_refr->dirty_tile_cnt = 0;
+            refr_tiles_of_areas();
+            LV_PROFILER_REFR_END;
+            return;
+        }
+        disp_refr->dirty_tile_cnt = tile_cnt;
+    }
+
+    uint8_t * dirty_tiles = disp_refr->dirty_tiles;
+    lv_memzero(dirty_tiles, tile_cnt);
+
+    uint32_t dirty_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        if(disp_refr->inv_area_joined[i]) continue;
+
+        const lv_area_t * inv_a = &disp_refr->inv_areas[i];
+        int32_t row;
+        int32_t col;
+        for(row = inv_a->y1 / tile_size; row <= inv_a->y2 / tile_size; row++) {
+            for(col = inv_a->x1 / tile_size; col <= inv_a->x2 / tile_size; col++) {
+                if(dirty_tiles[row * col_cnt + col]) continue;
+                dirty_tiles[row * col_cnt + col] = 1;
+                dirty_cnt++;
+            }
+        }
+    }
+
+    int32_t row;
+    int32_t col;
+    for(row = 0; row < row_cnt; row++) {
+        for(col = 0; col < col_cnt; col++) {
+            if(dirty_tiles[row * col_cnt + col] == 0) continue;
+
+            dirty_cnt--;
+            refr_tile(col, row, dirty_cnt == 0);
+        }
+    }
+
+    LV_PROFILER_REFR_END;
+}
+
+/**
+ * Refresh the tiles of the invalidated areas area by area. Used if the dirty tiles can't be collected,
+ * so the tiles shared by multiple areas are refreshed more than once.
+ */
+static void refr_tiles_of_areas(void)
+{
+    const int32_t tile_size = LV_DISPLAY_RENDER_TILE_SIZE;
+
+    int32_t last_i = -1;
+    int32_t i;
+    for(i = 0; i < (int32_t)disp_refr->inv_p; i++) {
+        if(disp_refr->inv_area_joined[i] == 0) last_i = i;
+    }
+
+    for(i = 0; i <= last_i; i++) {
+        if(disp_refr->inv_area_joined[i]) continue;
+
+        /*The invalidated areas are aligned to the tiles*/
+        const lv_area_t * inv_a = &disp_refr->inv_areas[i];
+        int32_t row_last = inv_a->y2 / tile_size;
+        int32_t col_last = inv_a->x2 / tile_size;
+        int32_t row;
+        int32_t col;
+        for(row = inv_a->y1 / tile_size; row <= row_last; row++) {
+            for(col = inv_a->x1 / tile_size; col <= col_last; col++) {
+                refr_tile(col, row, i == last_i && row == row_last && col == col_last);
+            }
+        }
+    }
+}
+
+/**
+ * Render a tile and flush it
+ * @param col       column index of the tile
+ * @param row       row index of the tile
+ * @param last      true: it's the last tile refreshed in this frame
+ */
+static void refr_tile(int32_t col, int32_t row, bool last)
+{
+    const int32_t tile_size = LV_DISPLAY_RENDER_TILE_SIZE;
+    if(last) disp_refr->last_area = 1;
+    disp_refr->last_part = 1;
+
+    lv_area_t tile_area;
+    tile_area.x1 = col * tile_size;
+    tile_area.y1 = row * tile_size;
+    tile_area.x2 = LV_MIN(tile_area.x1 + tile_size - 1, lv_display_get_horizontal_resolution(disp_refr) - 1);
+    tile_area.y2 = LV_MIN(tile_area.y1 + tile_size - 1, lv_display_get_vertical_resolution(disp_refr) - 1);
+    refr_area(&tile_area, 0);
+    draw_buf_flush(disp_refr);
+}
+
 /**
  * Reshape the draw buffer if required
  * @param layer  pointer to a layer which will be drawn
@@ -730,8 +1114,9 @@ static void refr_area(const lv_area_t * area_p, int32_t y_offset)
     layer->phy_clip_area = *area_p;
     layer->partial_y_offset = y_offset;
 
-    if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
-        /*In partial mode render this area to the buffer*/
+    if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL ||
+       disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        /*In partial and tiled mode render this area to the buffer*/
         layer->buf_area = *area_p;
         layer_reshape_draw_buf(layer, LV_STRIDE_AUTO);
     }
@@ -911,6 +1296,10 @@ static void refr_configured_layer(lv_layer_t * layer)
         top_prev_scr = lv_refr_get_top_obj(&layer->_clip_area, disp_refr->prev_scr);
     }
 
+#if LV_USE_OCCLUSION_CULLING
+    occluders_collect(layer);
+#endif
+
     /*Draw a bottom layer background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
         refr_obj_and_children(layer, lv_display_get_layer_bottom(disp_refr));
@@ -941,6 +1330,11 @@ static void refr_configured_layer(lv_layer_t * layer)
     refr_obj_and_children(layer, lv_display_get_layer_top(disp_refr));
     refr_obj_and_children(layer, lv_display_get_layer_sys(disp_refr));
 
+#if LV_USE_OCCLUSION_CULLING
+    disp_refr->occluder_layer = NULL;
+    disp_refr->occluder_cnt = 0;
+#endif
+
     LV_PROFILER_REFR_END;
 }
 
@@ -1150,9 +1544,19 @@ static void refr_obj_matrix(lv_layer_t * layer, lv_obj_t * obj)
 
     layer->_clip_area = clip_area;
 
+#if LV_USE_OCCLUSION_CULLING
+    /* the occluders are in display coordinates, not in the coordinates of the transformed widget */
+    lv_layer_t * occluder_layer = disp_refr->occluder_layer;
+    disp_refr->occluder_layer = NULL;
+#endif
+
     /* redraw obj */
     lv_obj_redraw(layer, obj);
 
+#if LV_USE_OCCLUSION_CULLING
+    disp_refr->occluder_layer = occluder_layer;
+#endif
+
     /* restore original matrix */
     layer->matrix = ori_matrix;
     /* restore clip area */
@@ -1193,6 +1597,10 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
     const lv_opa_t opa_layered = lv_obj_get_style_opa_layered(obj, LV_PART_MAIN);
     if(opa_layered <= LV_OPA_MIN) return;
 
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_LAYER) && refr_obj_cached(layer, obj, opa_layered)) return;
+#endif
+
     const lv_opa_t layer_opa_ori = layer->opa;
     const lv_color32_t layer_recolor = layer->recolor;
 
@@ -1435,3 +1843,387 @@ static void wait_for_flushing(lv_display_t * disp)
     LV_LOG_TRACE("end");
     LV_PROFILER_REFR_END;
 }
+
+#if LV_USE_SCROLL_SHIFT
+
+/**
+ * Move the pixels of the scrolled area in the draw buffer and flush them.
+ * The revealed parts were invalidated when scrolling so they are rendered after this.
+ */
+static void refr_scroll_shift(void)
+{
+    int32_t x = disp_refr->scroll_shift.x;
+    int32_t y = disp_refr->scroll_shift.y;
+    if(x == 0 && y == 0) return;
+
+    LV_PROFILER_REFR_BEGIN;
+
+    lv_area_t dest_area = disp_refr->scroll_shift_area;
+    lv_area_move(&dest_area, x, y);
+    lv_area_intersect(&dest_area, &dest_area, &disp_refr->scroll_shift_area);
+
+    lv_area_t src_area = dest_area;
+    lv_area_move(&src_area, -x, -y);
+
+    lv_draw_buf_t * buf = disp_refr->buf_act;
+    if(lv_display_is_double_buffered(disp_refr)) {
+        /*The other buffer has the previous frame*/
+        lv_draw_buf_t * on_screen = buf == disp_refr->buf_1 ? disp_refr->buf_2 : disp_refr->buf_1;
+        lv_draw_buf_copy(buf, &dest_area, on_screen, &src_area);
+
+        /*Copy the moved pixels to the other buffer too on the next refresh*/
+        lv_area_t * sync_area = lv_ll_ins_tail(&disp_refr->sync_areas);
+        if(sync_area) *sync_area = dest_area;
+    }
+    else {
+        /*Wait until the display has read the buffer and move the pixels in place.
+         *Go in the opposite direction of the moving to not overwrite the rows to move.*/
+        wait_for_flushing(disp_refr);
+
+        uint32_t line_size = lv_area_get_width(&dest_area) * lv_color_format_get_size(buf->header.cf);
+        int32_t h = lv_area_get_height(&dest_area);
+        int32_t row;
+        for(row = 0; row < h; row++) {
+            int32_t row_ofs = y > 0 ? h - 1 - row : row;
+            lv_memmove(lv_draw_buf_goto_xy(buf, dest_area.x1, dest_area.y1 + row_ofs),
+                       lv_draw_buf_goto_xy(buf, src_area.x1, src_area.y1 + row_ofs), line_size);
+        }
+    }
+
+    /*Send the moved pixels to the display before the redrawn areas*/
+    disp_refr->layer_head->draw_buf = buf;
+    disp_refr->refreshed_area = dest_area;
+    draw_buf_flush(disp_refr);
+
+    LV_PROFILER_REFR_END;
+}
+
+#endif /*LV_USE_SCROLL_SHIFT*/
+
+#if LV_USE_OCCLUSION_CULLING
+
+/**
+ * Find the largest opaque widgets on the area of a layer.
+ * Everything drawn before them in their area will be skipped.
+ * @param layer     the layer of the display being refreshed
+ */
+static void occluders_collect(lv_layer_t * layer)
+{
+    LV_PROFILER_REFR_BEGIN;
+    disp_refr->occluder_cnt = 0;
+    disp_refr->occluder_layer = layer;
+
+    /*From front to back*/
+    occluders_collect_obj(disp_refr->sys_layer, &layer->_clip_area);
+    occluders_collect_obj(disp_refr->top_layer, &layer->_clip_area);
+    if(disp_refr->draw_prev_over_act) {
+        if(disp_refr->prev_scr) occluders_collect_obj(disp_refr->prev_scr, &layer->_clip_area);
+        occluders_collect_obj(disp_refr->act_scr, &layer->_clip_area);
+    }
+    else {
+        occluders_collect_obj(disp_refr->act_scr, &layer->_clip_area);
+        if(disp_refr->prev_scr) occluders_collect_obj(disp_refr->prev_scr, &layer->_clip_area);
+    }
+    LV_PROFILER_REFR_END;
+}
+
+static void occluders_collect_obj(lv_obj_t * obj, const lv_area_t * clip_area)
+{
+    if(obj == NULL) return;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    /*The children are clipped to the widget. It can be larger with overflow visible but this is a safe estimate*/
+    lv_area_t obj_area;
+    if(!lv_area_intersect(&obj_area, clip_area, &obj->coords)) return;
+
+    /*Neither the widget nor its children are drawn with full opacity directly to the display*/
+    if(lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return;
+    if(lv_obj_get_style_opa(obj, LV_PART_MAIN) < LV_OPA_MAX) return;
+    if(lv_obj_get_style_clip_corner(obj, LV_PART_MAIN)) return;
+
+    int32_t i;
+    int32_t child_cnt = lv_obj_get_child_count(obj);
+    for(i = child_cnt - 1; i >= 0; i--) {
+        occluders_collect_obj(obj->spec_attr->children[i], &obj_area);
+    }
+
+    occluder_add(obj, &obj_area);
+}
+
+static void occluder_add(lv_obj_t * obj, const lv_area_t * area)
+{
+    /*If there is no free slot replace the smallest occluder if this one is larger*/
+    uint32_t idx = disp_refr->occluder_cnt;
+    if(idx == LV_OCCLUDER_BUF_SIZE) {
+        uint32_t i;
+        idx = 0;
+        for(i = 1; i < LV_OCCLUDER_BUF_SIZE; i++) {
+            if(lv_area_get_size(&disp_refr->occluders[i].area) < lv_area_get_size(&disp_refr->occluders[idx].area)) {
+                idx = i;
+            }
+        }
+        if(lv_area_get_size(area) <= lv_area_get_size(&disp_refr->occluders[idx].area)) return;
+    }
+
+    lv_area_t cover_area = *area;
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = &cover_area;
+    lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+
+    /*A rounded widget still covers the band between the top and bottom corners*/
+    if(info.res == LV_COVER_RES_NOT_COVER) {
+        int32_t short_side = LV_MIN(lv_area_get_width(&obj->coords), lv_area_get_height(&obj->coords));
+        int32_t radius = LV_MIN(lv_obj_get_style_radius(obj, LV_PART_MAIN), short_side >> 1);
+        if(radius <= 0) return;
+
+        cover_area.y1 = LV_MAX(cover_area.y1, obj->coords.y1 + radius);
+        cover_area.y2 = LV_MIN(cover_area.y2, obj->coords.y2 - radius);
+        if(cover_area.y1 > cover_area.y2) return;
+
+        info.res = LV_COVER_RES_COVER;
+        lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+    }
+
+    if(info.res != LV_COVER_RES_COVER) return;
+
+    disp_refr->occluders[idx].area = cover_area;
+    disp_refr->occluders[idx].obj = obj;
+    if(idx == disp_refr->occluder_cnt) disp_refr->occluder_cnt++;
+}
+
+/**
+ * Remove the parts of an area which are covered by the occluders drawn after a widget
+ * @param obj       the widget to draw
+ * @param area      the area of the widget to draw. It will be reduced to the visible part.
+ * @return          false: the widget is fully covered, no need to draw it
+ */
+static bool occlusion_clip(lv_obj_t * obj, lv_area_t * area)
+{
+    uint32_t size_ori = lv_area_get_size(area);
+    uint32_t i;
+    for(i = 0; i < disp_refr->occluder_cnt; i++) {
+        const lv_area_t * occ_area = &disp_refr->occluders[i].area;
+
+        /*Only the occluders spanning the whole width or height can make the visible area smaller*/
+        bool cover_hor = occ_area->x1 <= area->x1 && occ_area->x2 >= area->x2;
+        bool cover_ver = occ_area->y1 <= area->y1 && occ_area->y2 >= area->y2;
+        if(!cover_hor && !cover_ver) continue;
+        if(!lv_area_is_on(occ_area, area)) continue;
+        if(!obj_is_drawn_after(disp_refr->occluders[i].obj, obj)) continue;
+
+        if(cover_hor && cover_ver) {
+            disp_refr->culled_px_cnt += size_ori;
+            return false;
+        }
+
+        if(cover_hor) {
+            if(occ_area->y1 <= area->y1) area->y1 = occ_area->y2 + 1;
+            else if(occ_area->y2 >= area->y2) area->y2 = occ_area->y1 - 1;
+        }
+        else {
+            if(occ_area->x1 <= area->x1) area->x1 = occ_area->x2 + 1;
+            else if(occ_area->x2 >= area->x2) area->x2 = occ_area->x1 - 1;
+        }
+    }
+
+    disp_refr->culled_px_cnt += size_ori - lv_area_get_size(area);
+    return true;
+}
+
+/**
+ * Tell whether a widget is drawn after an other widget and all of its children
+ * @param obj       the widget to check
+ * @param other     the widget to compare to
+ * @return          true: `obj` is drawn later; false: `obj` is drawn earlier or they are in the same subtree
+ */
+static bool obj_is_drawn_after(lv_obj_t * obj, lv_obj_t * other)
+{
+    uint32_t obj_depth = 0;
+    uint32_t other_depth = 0;
+    lv_obj_t * parent;
+    for(parent = lv_obj_get_parent(obj); parent; parent = lv_obj_get_parent(parent)) obj_depth++;
+    for(parent = lv_obj_get_parent(other); parent; parent = lv_obj_get_parent(parent)) other_depth++;
+
+    for(; obj_depth > other_depth; obj_depth--) obj = lv_obj_get_parent(obj);
+    for(; other_depth > obj_depth; other_depth--) other = lv_obj_get_parent(other);
+
+    /*One is the ancestor of the other*/
+    if(obj == other) return false;
+
+    while(lv_obj_get_parent(obj) != lv_obj_get_parent(other)) {
+        obj = lv_obj_get_parent(obj);
+        other = lv_obj_get_parent(other);
+    }
+
+    if(lv_obj_get_parent(obj) == NULL) return root_get_draw_order(obj) > root_get_draw_order(other);
+    else return lv_obj_get_index(obj) > lv_obj_get_index(other);
+}
+
+static uint32_t root_get_draw_order(lv_obj_t * root)
+{
+    if(root == disp_refr->bottom_layer) return 0;
+    if(root == disp_refr->top_layer) return 3;
+    if(root == disp_refr->sys_layer) return 4;
+    if(root == disp_refr->prev_scr) return disp_refr->draw_prev_over_act ? 2 : 1;
+    return disp_refr->draw_prev_over_act ? 1 : 2;
+}
+
+#endif /*LV_USE_OCCLUSION_CULLING*/
+
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+
+/**
+ * Draw a widget from its cached layer. Render the layer first if it's outdated.
+ * @param layer         the layer to draw to
+ * @param obj           the widget to draw
+ * @param opa_layered   the `opa_layered` style property of the widget
+ * @return              false: the widget can't be cached, draw it normally
+ */
+static bool refr_obj_cached(lv_layer_t * layer, lv_obj_t * obj, lv_opa_t opa_layered)
+{
+    /*Don't keep the buffers used outside of the refresh (e.g. in a snapshot)*/
+    if(!disp_refr->rendering_in_progress) return false;
+    if(lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM) return false;
+
+    lv_area_t obj_draw_area;
+    int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, &obj_draw_area);
+    lv_area_increase(&obj_draw_area, ext_draw_size, ext_draw_size);
+
+    lv_area_t clip_area;
+    if(!lv_area_intersect(&clip_area, &layer->_clip_area, &obj_draw_area)) return true;
+
+    cache_layer_t search_key;
+    search_key.obj = obj;
+    search_key.w = lv_area_get_width(&obj_draw_area);
+    search_key.h = lv_area_get_height(&obj_draw_area);
+    search_key.slot.size = lv_draw_buf_width_to_stride(search_key.w, LV_COLOR_FORMAT_ARGB8888) * search_key.h;
+    if(search_key.slot.size > lv_cache_get_max_size(layer_cache_p, NULL)) {
+        /*Free the buffer of the previous size as it won't be used anymore*/
+        lv_cache_drop(layer_cache_p, &search_key, NULL);
+        return false;
+    }
+
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(layer_cache_p, &search_key, NULL);
+    if(entry == NULL) return false;
+
+    cache_layer_t * cached = lv_cache_entry_get_data(entry);
+    if(cached->w != search_key.w || cached->h != search_key.h) {
+        /*The widget was resized, the old buffer is freed when it's not used anymore*/
+        lv_cache_release(layer_cache_p, entry, NULL);
+        lv_cache_drop(layer_cache_p, &search_key, NULL);
+        entry = lv_cache_acquire_or_create(layer_cache_p, &search_key, NULL);
+        if(entry == NULL) return false;
+        cached = lv_cache_entry_get_data(entry);
+    }
+
+    /*Keep the buffer until the draw tasks using it are ready*/
+    if(lv_array_push_back(&layer_cache_acquired, &entry) != LV_RESULT_OK) {
+        lv_cache_release(layer_cache_p, entry, NULL);
+        return false;
+    }
+
+    if(!cached->rendered || obj->cache_layer_inv) {
+        cache_layer_render(obj, cached, &obj_draw_area);
+    }
+
+    /*Blend the layer like a simple layer. The opacity and recolor of the parents are applied here.*/
+    lv_draw_image_dsc_t layer_draw_dsc;
+    lv_draw_image_dsc_init(&layer_draw_dsc);
+    layer_draw_dsc.src = cached->draw_buf;
+    layer_draw_dsc.opa = opa_layered;
+    layer_draw_dsc.recolor = lv_color_make(layer->recolor.red, layer->recolor.green, layer->recolor.blue);
+    layer_draw_dsc.recolor_opa = layer->recolor.alpha;
+    layer_draw_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, 0);
+    layer_draw_dsc.bitmap_mask_src = lv_obj_get_style_bitmap_mask_src(obj, 0);
+    layer_draw_dsc.antialias = disp_refr->antialiasing;
+    lv_draw_image(layer, &layer_draw_dsc, &obj_draw_area);
+
+    return true;
+}
+
+/**
+ * Render a widget and its children into its cached layer
+ * @param obj       the widget to render
+ * @param cached    the cache entry's data
+ * @param area      the area of the widget with the ext. draw size
+ */
+static void cache_layer_render(lv_obj_t * obj, cache_layer_t * cached, const lv_area_t * area)
+{
+    LV_PROFILER_REFR_BEGIN;
+
+    /*Clear it first as the widget might set it again while drawing*/
+    obj->cache_layer_inv = 0;
+
+    lv_draw_buf_clear(cached->draw_buf, NULL);
+
+    /*Only the widget's own opacity and recolor are rendered into the buffer*/
+    lv_layer_t cache_layer;
+    lv_layer_init(&cache_layer);
+    cache_layer.draw_buf = cached->draw_buf;
+    cache_layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    cache_layer.buf_area = *area;
+    cache_layer._clip_area = *area;
+    cache_layer.phy_clip_area = *area;
+
+    const lv_opa_t opa_main = lv_obj_get_style_opa(obj, LV_PART_MAIN);
+    if(opa_main < LV_OPA_MAX) cache_layer.opa = opa_main;
+    cache_layer.recolor = lv_obj_style_apply_recolor(obj, LV_PART_MAIN, cache_layer.recolor);
+
+    /*Render it synchronously the same way as snapshots are taken*/
+    lv_layer_t * layer_head_ori = disp_refr->layer_head;
+    disp_refr->layer_head = &cache_layer;
+
+    lv_obj_redraw(&cache_layer, obj);
+    while(cache_layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+
+    disp_refr->layer_head = layer_head_ori;
+
+    /*The image cache might have the old content*/
+    lv_image_cache_drop(cached->draw_buf);
+    cached->rendered = true;
+
+    LV_PROFILER_REFR_END;
+}
+
+static void cache_layer_release_all(void)
+{
+    uint32_t i;
+    for(i = 0; i < lv_array_size(&layer_cache_acquired); i++) {
+        lv_cache_entry_t ** entry = lv_array_at(&layer_cache_acquired, i);
+        lv_cache_release(layer_cache_p, *entry, NULL);
+    }
+    lv_array_clear(&layer_cache_acquired);
+}
+
+static bool cache_layer_create_cb(cache_layer_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    node->draw_buf = lv_draw_buf_create(node->w, node->h, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    if(node->draw_buf == NULL) return false;
+
+    node->rendered = false;
+    return true;
+}
+
+static void cache_layer_free_cb(cache_layer_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_image_cache_drop(node->draw_buf);
+    lv_draw_buf_destroy(node->draw_buf);
+    node->draw_buf = NULL;
+}
+
+static lv_cache_compare_res_t cache_layer_compare_cb(const cache_layer_t * lhs, const cache_layer_t * rhs)
+{
+    if(lhs->obj != rhs->obj) return lhs->obj > rhs->obj ? 1 : -1;
+    return 0;
+}
+
+#endif /*LV_DRAW_LAYER_CACHE_MAX_MEMORY*/
@@ -58,6 +58,39 @@ lv_display_t * lv_refr_get_disp_refreshing(void);
  */
 void lv_refr_set_disp_refreshing(lv_display_t * disp);
 
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+
+/**
+ * Mark the cached layer of a widget and its parents as outdated.
+ * They will be redrawn when they are drawn the next time.
+ * @param obj   pointer to a widget which has changed
+ */
+void lv_refr_cache_layer_invalidate(const lv_obj_t * obj);
+
+/**
+ * Free the cached layer of a widget
+ * @param obj   pointer to a widget
+ */
+void lv_refr_cache_layer_drop(const lv_obj_t * obj);
+
+#endif /*LV_DRAW_LAYER_CACHE_MAX_MEMORY*/
+
+#if LV_USE_SCROLL_SHIFT
+
+/**
+ * Move the rendered pixels of an area on the next refresh instead of redrawing them.
+ * The revealed parts and the moved part of the pending invalidated areas are invalidated.
+ * Used only in `LV_DISPLAY_RENDER_MODE_DIRECT`.
+ * @param disp      pointer to a display (NULL: use the default display)
+ * @param area      the area to move in screen coordinates
+ * @param x         move the pixels by this amount horizontally
+ * @param y         move the pixels by this amount vertically
+ * @return          true: the pixels will be moved; false: the area needs to be invalidated as usual
+ */
+bool lv_refr_scroll_shift(lv_display_t * disp, const lv_area_t * area, int32_t x, int32_t y);
+
+#endif /*LV_USE_SCROLL_SHIFT*/
+
 /**
  * Search the most top object which fully covers an area
  * @param area_p pointer to an area
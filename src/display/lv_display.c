@@ -218,6 +218,7 @@ void lv_display_delete(lv_display_t * disp)
 
     if(disp->layer_deinit) disp->layer_deinit(disp, disp->layer_head);
     lv_free(disp->layer_head);
+    lv_free(disp->dirty_tiles);
 
     lv_free(disp);
 
@@ -481,6 +482,13 @@ void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint3
         h = buf_size / stride;
         LV_ASSERT_MSG(h != 0, "the buffer is too small");
     }
+    else if(render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        /* for tiled mode the buffer needs to hold only one tile */
+        w = LV_MIN(w, LV_DISPLAY_RENDER_TILE_SIZE);
+        h = LV_MIN(h, LV_DISPLAY_RENDER_TILE_SIZE);
+        stride = lv_draw_buf_width_to_stride(w, cf);
+        LV_ASSERT_MSG(stride * h <= buf_size, "TILED mode requires tile sized buffer(s)");
+    }
     else {
         LV_ASSERT_FORMAT_MSG(stride * h <= buf_size, "%s mode requires screen sized buffer(s)",
                              render_mode == LV_DISPLAY_RENDER_MODE_FULL ? "FULL" : "DIRECT");
@@ -514,6 +522,11 @@ void lv_display_set_buffers_with_stride(lv_display_t * disp, void * buf1, void *
         h = buf_size / stride;
         LV_ASSERT_MSG(h != 0, "the buffer is too small");
     }
+    else if(render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        /* for tiled mode the buffer needs to hold only one tile */
+        h = LV_MIN(h, LV_DISPLAY_RENDER_TILE_SIZE);
+        LV_ASSERT_MSG(stride * h <= buf_size, "TILED mode requires tile sized buffer(s)");
+    }
     else {
         LV_ASSERT_FORMAT_MSG(stride * h <= buf_size, "%s mode requires screen sized buffer(s)",
                              render_mode == LV_DISPLAY_RENDER_MODE_FULL ? "FULL" : "DIRECT");
@@ -1063,6 +1076,16 @@ void lv_display_delete_refr_timer(lv_display_t * disp)
     disp->refr_timer = NULL;
 }
 
+#if LV_USE_OCCLUSION_CULLING
+uint32_t lv_display_get_culled_px_count(lv_display_t * disp)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) return 0;
+
+    return disp->culled_px_cnt;
+}
+#endif
+
 lv_result_t lv_display_send_vsync_event(lv_display_t * disp, void * param)
 {
     if(!disp) disp = lv_display_get_default();
@@ -1196,6 +1219,10 @@ uint32_t lv_display_get_invalidated_draw_buf_size(lv_display_t * disp, uint32_t
         width = lv_display_get_horizontal_resolution(disp);
         height = lv_display_get_vertical_resolution(disp);
     }
+    else if(disp->render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        width = LV_MIN(width, LV_DISPLAY_RENDER_TILE_SIZE);
+        height = LV_MIN(height, LV_DISPLAY_RENDER_TILE_SIZE);
+    }
 
     lv_color_format_t cf = lv_display_get_color_format(disp);
     uint32_t stride = lv_draw_buf_width_to_stride(width, cf);
@@ -57,6 +57,12 @@ typedef enum {
      * With 2 buffers in flush_cb only an address change is required.
      */
     LV_DISPLAY_RENDER_MODE_FULL,
+
+    /**
+     * The screen is divided into `LV_DISPLAY_RENDER_TILE_SIZE` x `LV_DISPLAY_RENDER_TILE_SIZE` sized tiles.
+     * The invalidated tiles are rendered and flushed one by one, so the buffer(s) need to hold only one tile.
+     */
+    LV_DISPLAY_RENDER_MODE_TILED,
 } lv_display_render_mode_t;
 
 typedef enum {
@@ -262,7 +268,7 @@ int32_t lv_display_get_dpi(const lv_display_t * disp);
  * @param buf1              first buffer
  * @param buf2              second buffer (can be `NULL`)
  * @param buf_size          buffer size in byte
- * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL
+ * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL/TILED
  */
 void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint32_t buf_size,
                             lv_display_render_mode_t render_mode);
@@ -277,7 +283,7 @@ void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint3
  * @param buf2              second buffer (can be `NULL`)
  * @param buf_size          buffer size in byte
  * @param stride            buffer stride in bytes
- * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL
+ * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL/TILED
  */
 void lv_display_set_buffers_with_stride(lv_display_t * disp, void * buf1, void * buf2, uint32_t buf_size,
                                         uint32_t stride, lv_display_render_mode_t render_mode);
@@ -302,7 +308,7 @@ void lv_display_set_3rd_draw_buffer(lv_display_t * disp, lv_draw_buf_t * buf3);
 /**
  * Set display render mode
  * @param disp              pointer to a display
- * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL
+ * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL/TILED
  */
 void lv_display_set_render_mode(lv_display_t * disp, lv_display_render_mode_t render_mode);
 
@@ -601,6 +607,16 @@ lv_timer_t * lv_display_get_refr_timer(lv_display_t * disp);
  */
 void lv_display_delete_refr_timer(lv_display_t * disp);
 
+#if LV_USE_OCCLUSION_CULLING
+/**
+ * Get how many pixels of the widgets were not drawn in the last refresh
+ * because opaque widgets drawn later covered them.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          number of skipped pixels
+ */
+uint32_t lv_display_get_culled_px_count(lv_display_t * disp);
+#endif
+
 /**
  * Register vsync event of a display. `LV_EVENT_VSYNC` event will be sent periodically.
  * Please don't use it in display event listeners, as it may cause memory leaks and illegal access issues.
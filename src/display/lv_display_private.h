@@ -29,10 +29,35 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /**< Buffer size for invalid areas */
 #endif
 
+#ifndef LV_DISPLAY_RENDER_TILE_SIZE
+#define LV_DISPLAY_RENDER_TILE_SIZE 64 /**< Width and height of the tiles in `LV_DISPLAY_RENDER_MODE_TILED`*/
+#endif
+
+#ifndef LV_INV_AREA_JOIN_OVERHEAD
+/**
+ * Estimated cost of refreshing an invalid area on its own (in pixels).
+ * Two invalid areas are merged if their bounding box is smaller than
+ * the sum of their sizes plus this overhead.
+ * Larger values result in fewer but larger areas.*/
+#define LV_INV_AREA_JOIN_OVERHEAD 0
+#endif
+
+#ifndef LV_OCCLUDER_BUF_SIZE
+#define LV_OCCLUDER_BUF_SIZE 8 /**< Max number of opaque widgets to use for occlusion culling in an area */
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_OCCLUSION_CULLING
+/** An opaque widget which hides everything drawn before it in its area*/
+typedef struct {
+    lv_area_t area;     /**< The fully covered area*/
+    lv_obj_t * obj;     /**< The covering widget*/
+} lv_display_occluder_t;
+#endif
+
 struct _lv_display_t {
 
     /*---------------------
@@ -107,9 +132,27 @@ struct _lv_display_t {
     uint32_t inv_p;
     int32_t inv_en_cnt;
 
+    /** Dirty tile map of `LV_DISPLAY_RENDER_MODE_TILED`. Kept between the refreshes to not allocate it in each frame.*/
+    uint8_t * dirty_tiles;
+    uint32_t dirty_tile_cnt;
+
     /** Double buffer sync areas (redrawn during last refresh) */
     lv_ll_t sync_areas;
 
+#if LV_USE_OCCLUSION_CULLING
+    /** The largest opaque widgets in the area being refreshed*/
+    lv_display_occluder_t occluders[LV_OCCLUDER_BUF_SIZE];
+    uint32_t occluder_cnt;
+    lv_layer_t * occluder_layer;    /**< The occluders are used only when drawing directly to this layer*/
+    uint32_t culled_px_cnt;         /**< Number of pixels not drawn in the last refresh as they were covered*/
+#endif
+
+#if LV_USE_SCROLL_SHIFT
+    /** Move the rendered pixels of this area by `scroll_shift` before rendering the invalidated areas*/
+    lv_area_t scroll_shift_area;
+    lv_point_t scroll_shift;        /**< (0;0): there is nothing to move*/
+#endif
+
     lv_draw_buf_t _static_buf1; /**< Used when user pass in a raw buffer as display draw buffer */
     lv_draw_buf_t _static_buf2;
     /*---------------------
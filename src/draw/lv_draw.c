@@ -27,15 +27,30 @@
  *********************/
 #define _draw_info LV_GLOBAL_DEFAULT()->draw_info
 
+#define TASK_CHUNK_HEADER_SIZE  LV_ALIGN_UP(sizeof(lv_draw_task_chunk_t), 8)
+#define TASK_CHUNK_DATA_SIZE    (LV_DRAW_TASK_CHUNK_SIZE - TASK_CHUNK_HEADER_SIZE)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+struct _lv_draw_task_chunk_t {
+    uint32_t used;          /**< Number of bytes already allocated from the chunk */
+    uint32_t task_cnt;      /**< Number of draw tasks allocated from the chunk and not freed yet */
+};
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void register_dependencies(lv_draw_task_t * t);
+static bool add_dependent(lv_draw_task_t * t, lv_draw_task_t * dependent);
+static inline lv_draw_task_t ** get_dependents(lv_draw_task_t * t);
 static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
 static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp);
+static lv_draw_task_t * task_alloc(lv_draw_task_type_t type);
+static void task_free(lv_draw_task_t * t);
+static void task_chunk_release(lv_draw_task_chunk_t * chunk);
+static inline size_t get_task_size(lv_draw_task_type_t type);
 static inline size_t get_draw_dsc_size(lv_draw_task_type_t type);
 static lv_draw_task_t * get_first_available_task(lv_layer_t * layer);
 
@@ -80,6 +95,11 @@ void lv_draw_deinit(void)
         lv_free(cur_unit);
     }
     _draw_info.unit_head = NULL;
+
+    lv_free(_draw_info.task_chunk_act);
+    lv_free(_draw_info.task_chunk_spare);
+    _draw_info.task_chunk_act = NULL;
+    _draw_info.task_chunk_spare = NULL;
 }
 
 void * lv_draw_create_unit(size_t size)
@@ -99,9 +119,8 @@ void * lv_draw_create_unit(size_t size)
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords, lv_draw_task_type_t type)
 {
     LV_PROFILER_DRAW_BEGIN;
-    size_t dsc_size = get_draw_dsc_size(type);
-    LV_ASSERT_FORMAT_MSG(dsc_size > 0, "Draw task size is 0 for type %d", type);
-    lv_draw_task_t * new_task = lv_malloc_zeroed(LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + dsc_size);
+    LV_ASSERT_FORMAT_MSG(get_draw_dsc_size(type) > 0, "Draw task size is 0 for type %d", type);
+    lv_draw_task_t * new_task = task_alloc(type);
     LV_ASSERT_MALLOC(new_task);
     new_task->area = *coords;
     new_task->_real_area = *coords;
@@ -115,16 +134,15 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords,
     new_task->draw_dsc = (uint8_t *)new_task + LV_ALIGN_UP(sizeof(lv_draw_task_t), 8);
     new_task->state = LV_DRAW_TASK_STATE_QUEUED;
 
-    /*Find the tail*/
+    /*Append to the tail*/
     if(layer->draw_task_head == NULL) {
         layer->draw_task_head = new_task;
     }
     else {
-        lv_draw_task_t * tail = layer->draw_task_head;
-        while(tail->next) tail = tail->next;
-
-        tail->next = new_task;
+        new_task->prev = layer->draw_task_tail;
+        layer->draw_task_tail->next = new_task;
     }
+    layer->draw_task_tail = new_task;
 
     LV_PROFILER_DRAW_END;
     return new_task;
@@ -169,6 +187,7 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
             t->state = LV_DRAW_TASK_STATE_READY;
         }
         else {
+            register_dependencies(t);
             lv_draw_dispatch();
         }
     }
@@ -187,6 +206,8 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
             }
             u = u->next;
         }
+
+        register_dependencies(t);
     }
     LV_PROFILER_DRAW_END;
 }
@@ -247,6 +268,11 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
                 t_prev->next = t_next;
             else
                 layer->draw_task_head = t_next;
+
+            if(t_next != NULL)
+                t_next->prev = t_prev;
+            else
+                layer->draw_task_tail = t_prev;
         }
         else {
             t_prev = t;
@@ -334,14 +360,15 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
 {
     LV_PROFILER_DRAW_BEGIN;
 
-    /*If the first task is screen sized, there cannot be independent areas*/
+    /*If the first task is screen sized, there cannot be independent areas.
+     *Use `_real_area` as it's reduced if the task was split to bands.*/
     if(layer->draw_task_head) {
         int32_t hor_res = lv_display_get_horizontal_resolution(lv_refr_get_disp_refreshing());
         int32_t ver_res = lv_display_get_vertical_resolution(lv_refr_get_disp_refreshing());
         lv_draw_task_t * t = layer->draw_task_head;
         if(t->state != LV_DRAW_TASK_STATE_QUEUED &&
-           t->area.x1 <= 0 && t->area.x2 >= hor_res - 1 &&
-           t->area.y1 <= 0 && t->area.y2 >= ver_res - 1) {
+           t->_real_area.x1 <= 0 && t->_real_area.x2 >= hor_res - 1 &&
+           t->_real_area.y1 <= 0 && t->_real_area.y2 >= ver_res - 1) {
             LV_PROFILER_DRAW_END;
             return NULL;
         }
@@ -350,9 +377,9 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
     lv_draw_task_t * t = t_prev ? t_prev->next : layer->draw_task_head;
     while(t) {
         /*Find a queued and independent task*/
-        if(t->state == LV_DRAW_TASK_STATE_QUEUED &&
+        if(t->state == LV_DRAW_TASK_STATE_QUEUED && t->dependency_cnt == 0 &&
            (t->preferred_draw_unit_id == LV_DRAW_UNIT_NONE || t->preferred_draw_unit_id == draw_unit_id) &&
-           is_independent(layer, t)) {
+           (!t->dependencies_incomplete || is_independent(layer, t))) {
             LV_PROFILER_DRAW_END;
             return t;
         }
@@ -366,22 +393,59 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
 uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check)
 {
     if(t_check == NULL) return 0;
-    if(t_check->next == NULL) return 0;
+
+    return t_check->dependent_cnt;
+}
+
+lv_draw_task_t * lv_draw_task_split(lv_draw_task_t * t, int32_t y)
+{
+    LV_ASSERT_NULL(t);
+    LV_ASSERT(t->type != LV_DRAW_TASK_TYPE_LAYER && t->type != LV_DRAW_TASK_TYPE_LABEL);
+
+    if(y <= t->clip_area.y1 || y > t->clip_area.y2) return NULL;
 
     LV_PROFILER_DRAW_BEGIN;
-    uint32_t cnt = 0;
+    lv_draw_task_t * new_task = task_alloc(t->type);
+    LV_ASSERT_MALLOC(new_task);
+    if(new_task == NULL) {
+        LV_PROFILER_DRAW_END;
+        return NULL;
+    }
 
-    lv_draw_task_t * t = t_check->next;
-    while(t) {
-        if((t->state == LV_DRAW_TASK_STATE_QUEUED || t->state == LV_DRAW_TASK_STATE_WAITING) &&
-           lv_area_is_on(&t_check->area, &t->area)) {
-            cnt++;
-        }
+    lv_draw_task_chunk_t * chunk = new_task->chunk;
+    lv_memcpy(new_task, t, get_task_size(t->type));
+    new_task->chunk = chunk;
+    new_task->draw_dsc = (uint8_t *)new_task + LV_ALIGN_UP(sizeof(lv_draw_task_t), 8);
 
-        t = t->next;
+    /*The tasks waiting for `t` need to wait for the new part too*/
+    new_task->dependents = NULL;
+    new_task->dependent_cnt = 0;
+    new_task->dependent_size = 0;
+    lv_draw_task_t ** dependents = get_dependents(t);
+    uint32_t i;
+    for(i = 0; i < t->dependent_cnt; i++) {
+        if(!add_dependent(new_task, dependents[i])) dependents[i]->dependencies_incomplete = 1;
     }
+
+    new_task->clip_area.y1 = y;
+    new_task->_real_area.y1 = LV_MAX(new_task->_real_area.y1, y);
+    t->clip_area.y2 = y - 1;
+    t->_real_area.y2 = LV_MIN(t->_real_area.y2, y - 1);
+
+    new_task->next = t->next;
+    new_task->prev = t;
+    if(t->next) t->next->prev = new_task;
+    else t->target_layer->draw_task_tail = new_task;
+    t->next = new_task;
+
     LV_PROFILER_DRAW_END;
-    return cnt;
+    return new_task;
+}
+
+void lv_draw_task_mem_monitor(lv_draw_task_mem_monitor_t * mon_p)
+{
+    LV_ASSERT_NULL(mon_p);
+    *mon_p = _draw_info.task_mem;
 }
 
 void lv_layer_init(lv_layer_t * layer)
@@ -517,8 +581,74 @@ void lv_draw_task_get_area(const lv_draw_task_t * t, lv_area_t * area)
  **********************/
 
 /**
- * Check if there are older draw task overlapping the area of `t_check`
- * @param layer      the draw ctx to search in
+ * Find the older, not finished draw tasks overlapping the area of `t`
+ * and make `t` wait for them.
+ * Scanning stops at the first older task which fully covers `t`: all the older tasks
+ * overlapping `t` overlap that task too, so `t` waits for them indirectly.
+ * @param t     the newly created draw task
+ */
+static void register_dependencies(lv_draw_task_t * t)
+{
+    LV_PROFILER_DRAW_BEGIN;
+    lv_draw_task_t * t_prev = t->prev;
+    while(t_prev) {
+        if(t_prev->state != LV_DRAW_TASK_STATE_READY && lv_area_is_on(&t_prev->_real_area, &t->_real_area)) {
+            if(!add_dependent(t_prev, t)) {
+                /*Fall back to checking all the older tasks when `t` is dispatched*/
+                t->dependencies_incomplete = 1;
+                break;
+            }
+            if(t_prev->dependencies_registered && lv_area_is_in(&t->_real_area, &t_prev->_real_area, 0)) break;
+        }
+        t_prev = t_prev->prev;
+    }
+
+    t->dependencies_registered = 1;
+    LV_PROFILER_DRAW_END;
+}
+
+/**
+ * Make `dependent` wait until `t` is finished and removed
+ * @param t             an older draw task
+ * @param dependent     a newer draw task overlapping `t`
+ * @return              true: the dependency is recorded; false: out of memory
+ */
+static bool add_dependent(lv_draw_task_t * t, lv_draw_task_t * dependent)
+{
+    if(t->dependent_cnt >= LV_DRAW_TASK_INLINE_DEPENDENT_CNT && t->dependent_cnt >= t->dependent_size) {
+        /*The inline array is full, continue on the heap*/
+        uint32_t new_size = t->dependent_size ? t->dependent_size * 2 : LV_DRAW_TASK_INLINE_DEPENDENT_CNT * 2;
+        lv_draw_task_t ** new_dependents = lv_realloc(t->dependents, new_size * sizeof(lv_draw_task_t *));
+        LV_ASSERT_MALLOC(new_dependents);
+        if(new_dependents == NULL) return false;
+
+        if(t->dependents == NULL) {
+            lv_memcpy(new_dependents, t->dependents_inline, sizeof(t->dependents_inline));
+        }
+        t->dependents = new_dependents;
+        t->dependent_size = new_size;
+    }
+
+    get_dependents(t)[t->dependent_cnt] = dependent;
+    t->dependent_cnt++;
+    dependent->dependency_cnt++;
+    return true;
+}
+
+/**
+ * Get the array in which the dependents of a draw task are stored
+ * @param t     pointer to a draw task
+ * @return      `dependents` if it's allocated, else `dependents_inline`
+ */
+static inline lv_draw_task_t ** get_dependents(lv_draw_task_t * t)
+{
+    return t->dependents ? t->dependents : t->dependents_inline;
+}
+
+/**
+ * Check if there are older draw tasks overlapping the area of `t_check`.
+ * Used only if not all the dependencies of `t_check` could be recorded.
+ * @param layer         the layer to search in
  * @param t_check       check this task if it overlaps with the older ones
  * @return              true: `t_check` is not overlapping with older tasks so it's independent
  */
@@ -529,12 +659,9 @@ static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
 
     /*If t_check is outside of the older tasks then it's independent*/
     while(t && t != t_check) {
-        if(t->state != LV_DRAW_TASK_STATE_READY) {
-            lv_area_t a;
-            if(lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) {
-                LV_PROFILER_DRAW_END;
-                return false;
-            }
+        if(t->state != LV_DRAW_TASK_STATE_READY && lv_area_is_on(&t->_real_area, &t_check->_real_area)) {
+            LV_PROFILER_DRAW_END;
+            return false;
         }
         t = t->next;
     }
@@ -595,6 +722,16 @@ static inline size_t get_draw_dsc_size(lv_draw_task_type_t type)
     return 0;
 }
 
+/**
+ * Get the size of a draw task including its draw descriptor
+ * @param type      type of the draw task
+ * @return          the size in bytes
+ */
+static inline size_t get_task_size(lv_draw_task_type_t type)
+{
+    return LV_ALIGN_UP(LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + get_draw_dsc_size(type), 8);
+}
+
 /**
  * Clean-up resources allocated by a finished task
  * @param t         pointer to a draw task
@@ -649,10 +786,120 @@ static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp)
         draw_label_dsc->text = NULL;
     }
 
-    lv_free(t);
+    /*The newer tasks don't need to wait for this task anymore*/
+    lv_draw_task_t ** dependents = get_dependents(t);
+    uint32_t i;
+    for(i = 0; i < t->dependent_cnt; i++) {
+        dependents[i]->dependency_cnt--;
+    }
+    lv_free(t->dependents);
+
+    task_free(t);
     LV_PROFILER_DRAW_END;
 }
 
+/**
+ * Allocate a zeroed draw task with space for its draw descriptor.
+ * Small tasks are allocated from the current chunk, so that `lv_malloc` is called only
+ * when a chunk gets full and there is no spare chunk.
+ * @param type      type of the draw task
+ * @return          the allocated draw task or NULL on error
+ */
+static lv_draw_task_t * task_alloc(lv_draw_task_type_t type)
+{
+    size_t size = get_task_size(type);
+    lv_draw_task_t * t = NULL;
+    lv_draw_task_chunk_t * chunk = NULL;
+    lv_draw_task_mem_monitor_t * mon = &_draw_info.task_mem;
+
+#if LV_DRAW_TASK_CHUNK_SIZE
+    if(size <= TASK_CHUNK_DATA_SIZE) {
+        chunk = _draw_info.task_chunk_act;
+        if(chunk == NULL || chunk->used + size > TASK_CHUNK_DATA_SIZE) {
+            /*The full chunk will be released when its last task is freed*/
+            if(_draw_info.task_chunk_spare) {
+                chunk = _draw_info.task_chunk_spare;
+                _draw_info.task_chunk_spare = NULL;
+            }
+            else {
+                chunk = lv_malloc(LV_DRAW_TASK_CHUNK_SIZE);
+                LV_ASSERT_MALLOC(chunk);
+                if(chunk) {
+                    mon->chunk_cnt++;
+                    mon->max_chunk_cnt = LV_MAX(mon->max_chunk_cnt, mon->chunk_cnt);
+                }
+            }
+
+            if(chunk) {
+                chunk->used = 0;
+                chunk->task_cnt = 0;
+            }
+            _draw_info.task_chunk_act = chunk;
+        }
+
+        if(chunk) {
+            t = (lv_draw_task_t *)((uint8_t *)chunk + TASK_CHUNK_HEADER_SIZE + chunk->used);
+            chunk->used += size;
+            chunk->task_cnt++;
+        }
+    }
+#endif
+
+    if(t == NULL) {
+        t = lv_malloc(size);
+        if(t == NULL) return NULL;
+    }
+
+    lv_memzero(t, size);
+    t->chunk = chunk;
+
+    mon->task_cnt++;
+    mon->max_task_cnt = LV_MAX(mon->max_task_cnt, mon->task_cnt);
+    mon->used_size += size;
+    mon->max_used = LV_MAX(mon->max_used, mon->used_size);
+
+    return t;
+}
+
+/**
+ * Free a draw task allocated by `task_alloc`
+ * @param t     the draw task to free
+ */
+static void task_free(lv_draw_task_t * t)
+{
+    lv_draw_task_mem_monitor_t * mon = &_draw_info.task_mem;
+    mon->task_cnt--;
+    mon->used_size -= get_task_size(t->type);
+
+    lv_draw_task_chunk_t * chunk = t->chunk;
+    if(chunk == NULL) {
+        lv_free(t);
+        return;
+    }
+
+    chunk->task_cnt--;
+    if(chunk->task_cnt > 0) return;
+
+    /*All tasks of the chunk are freed, reuse all of its memory at once*/
+    if(chunk == _draw_info.task_chunk_act) chunk->used = 0;
+    else task_chunk_release(chunk);
+}
+
+/**
+ * Keep an empty chunk as spare or free it if there is already a spare chunk
+ * @param chunk     an empty chunk which is not the current chunk
+ */
+static void task_chunk_release(lv_draw_task_chunk_t * chunk)
+{
+    if(_draw_info.task_chunk_spare == NULL) {
+        _draw_info.task_chunk_spare = chunk;
+    }
+    else {
+        lv_free(chunk);
+        _draw_info.task_mem.chunk_cnt--;
+    }
+}
+
 static lv_draw_task_t * get_first_available_task(lv_layer_t * layer)
 {
     LV_PROFILER_DRAW_BEGIN;
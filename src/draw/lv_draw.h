@@ -72,6 +72,15 @@ typedef enum {
     LV_DRAW_TASK_STATE_READY,
 } lv_draw_task_state_t;
 
+typedef struct {
+    uint32_t task_cnt;          /**< Number of existing draw tasks */
+    uint32_t max_task_cnt;      /**< Max. number of draw tasks existed at the same time */
+    uint32_t used_size;         /**< Memory used by the draw tasks and their descriptors in bytes */
+    uint32_t max_used;          /**< Max. memory used by the draw tasks and their descriptors */
+    uint32_t chunk_cnt;         /**< Number of allocated draw task chunks */
+    uint32_t max_chunk_cnt;     /**< Max. number of draw task chunks allocated at the same time */
+} lv_draw_task_mem_monitor_t;
+
 struct _lv_layer_t  {
     /** Target draw buffer of the layer */
     lv_draw_buf_t * draw_buf;
@@ -79,6 +88,9 @@ struct _lv_layer_t  {
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
 
+    /** The last draw task to add new draw tasks quickly */
+    lv_draw_task_t * draw_task_tail;
+
     /** Parent layer */
     lv_layer_t * parent;
 
@@ -244,6 +256,7 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
 
 /**
  * Tell how many draw task are waiting to be drawn on the area of `t_check`.
+ * Only the tasks directly waiting for `t_check` are counted. It doesn't require traversing the draw tasks.
  * It can be used to determine if a GPU shall combine many draw tasks into one or not.
  * If a lot of tasks are waiting for the current ones it makes sense to draw them one-by-one
  * to not block the dependent tasks' rendering
@@ -252,6 +265,15 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
  */
 uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check);
 
+/**
+ * Give information about the memory used by the draw tasks.
+ * Draw tasks are allocated from larger chunks which are reused when all of their
+ * draw tasks are finished. See `LV_DRAW_TASK_CHUNK_SIZE`.
+ * @param mon_p     pointer to a `lv_draw_task_mem_monitor_t` variable,
+ *                  the result of the analysis will be stored here
+ */
+void lv_draw_task_mem_monitor(lv_draw_task_mem_monitor_t * mon_p);
+
 /**
  * Initialize a layer
  * @param layer pointer to a layer to initialize
@@ -10,6 +10,7 @@
 #include "../misc/lv_area_private.h"
 #include "lv_image_decoder_private.h"
 #include "lv_draw_private.h"
+#include "lv_draw_rect.h"
 #include "../display/lv_display.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_math.h"
@@ -35,6 +36,10 @@ static void img_decode_and_draw(lv_draw_task_t * t, const lv_draw_image_dsc_t *
                                 const lv_area_t * img_area, const lv_area_t * clipped_img_area,
                                 lv_draw_image_core_cb draw_core_cb);
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+    static void draw_placeholder(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -126,6 +131,15 @@ void lv_draw_image(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv
 
     /*Typical case, draw the image as bitmap*/
     if(!(new_image_dsc.header.flags & LV_IMAGE_FLAGS_CUSTOM_DRAW)) {
+#if LV_USE_IMAGE_DECODER_ASYNC
+        /*Don't block the rendering while the image is being decoded in the background*/
+        if(lv_image_decoder_async_draw_placeholder(new_image_dsc.src, &new_image_dsc.header, dsc->base.obj)) {
+            draw_placeholder(layer, &new_image_dsc, image_coords);
+            LV_PROFILER_DRAW_END;
+            return;
+        }
+#endif
+
         lv_draw_task_t * t = lv_draw_add_task(layer, image_coords, LV_DRAW_TASK_TYPE_IMAGE);
         lv_memcpy(t->draw_dsc, &new_image_dsc, sizeof(lv_draw_image_dsc_t));
 
@@ -374,3 +388,25 @@ static void img_decode_and_draw(lv_draw_task_t * t, const lv_draw_image_dsc_t *
         }
     }
 }
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+static void draw_placeholder(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_draw_fill_dsc_t fill_dsc;
+    lv_draw_fill_dsc_init(&fill_dsc);
+    lv_image_decoder_async_get_placeholder(&fill_dsc.color, &fill_dsc.opa);
+    fill_dsc.opa = LV_OPA_MIX2(fill_dsc.opa, dsc->opa);
+    if(fill_dsc.opa <= LV_OPA_MIN) return;
+
+    /*Cover the same area as the transformed image*/
+    lv_area_t area;
+    lv_image_buf_get_transformed_area(&area, lv_area_get_width(coords), lv_area_get_height(coords),
+                                      dsc->rotation, dsc->scale_x, dsc->scale_y, &dsc->pivot);
+    lv_area_move(&area, coords->x1, coords->y1);
+
+    fill_dsc.radius = dsc->clip_radius;
+    fill_dsc.base.obj = dsc->base.obj;
+    fill_dsc.base.part = dsc->base.part;
+    lv_draw_fill(layer, &fill_dsc, &area);
+}
+#endif
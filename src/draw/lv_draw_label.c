@@ -43,6 +43,8 @@ typedef unsigned char cmd_state_t;
  *  STATIC PROTOTYPES
  **********************/
 static uint8_t hex_char_to_num(char hex);
+static int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_text_layout_t * layout, uint32_t line_idx,
+                              uint32_t line_start, uint32_t line_end);
 
 /**********************
  *  STATIC VARIABLES
@@ -247,8 +249,16 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
     uint32_t line_start     = 0;
     int32_t last_line_start = -1;
 
+    /*Use the already calculated lines if they match this text*/
+    const lv_text_layout_t * layout = dsc->text_layout;
+    if(layout && (dsc->text_length != LV_TEXT_LEN_MAX ||
+                  !lv_text_layout_is_up_to_date(layout, dsc->text, font, dsc->letter_space, w, dsc->flag))) {
+        layout = NULL;
+    }
+    uint32_t line_idx = 0;
+
     /*Check the hint to use the cached info*/
-    if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
+    if(layout == NULL && dsc->hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             dsc->hint->line_start = -1;
@@ -263,12 +273,26 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
     }
 
     uint32_t remaining_len = dsc->text_length;
-
-    uint32_t line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space,
-                                                           w, NULL, dsc->flag);
+    uint32_t line_end;
+
+    if(layout) {
+        /*Jump to the first visible line*/
+        int32_t dist = t->clip_area.y1 - (pos.y + line_height_font);
+        if(dist > 0 && line_height > 0) {
+            line_idx = (dist + line_height - 1) / line_height;
+            if(line_idx >= layout->line_cnt) return;
+            pos.y += (int32_t)line_idx * line_height;
+        }
+        line_start = layout->lines[line_idx].start;
+        line_end = layout->lines[line_idx + 1].start;
+    }
+    else {
+        line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space,
+                                                      w, NULL, dsc->flag);
+    }
 
     /*Go the first visible line*/
-    while(pos.y + line_height_font < t->clip_area.y1) {
+    while(layout == NULL && pos.y + line_height_font < t->clip_area.y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space, w, NULL, dsc->flag);
@@ -286,16 +310,13 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space,
-                                                  dsc->flag);
-
+        line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space,
-                                                  dsc->flag);
+        line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -517,22 +538,24 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
         /*Go to next line*/
         remaining_len -= line_end - line_start;
         line_start = line_end;
-        if(remaining_len) {
+        if(layout) {
+            line_idx++;
+            if(line_idx >= layout->line_cnt) break;
+            line_end = layout->lines[line_idx + 1].start;
+        }
+        else if(remaining_len) {
             line_end += lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space, w, NULL, dsc->flag);
         }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
-
+            line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -551,6 +574,24 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the width of a line
+ * @param dsc           the label draw descriptor
+ * @param layout        the already calculated lines or NULL to measure the line now
+ * @param line_idx      index of the line in `layout`
+ * @param line_start    byte index of the line's first character in `dsc->text`
+ * @param line_end      byte index of the next line's first character in `dsc->text`
+ * @return              width of the line in pixels
+ */
+static int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_text_layout_t * layout, uint32_t line_idx,
+                              uint32_t line_start, uint32_t line_end)
+{
+    if(layout) return layout->lines[line_idx].width;
+
+    return lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, dsc->font, dsc->letter_space,
+                                        dsc->flag);
+}
+
 /**
  * Convert a hexadecimal characters to a number (0..15)
  * @param hex Pointer to a hexadecimal character (0..9, A..F)
@@ -107,6 +107,10 @@ typedef struct {
     /**Pointer to an externally stored struct where some data can be cached to speed up rendering*/
     lv_draw_label_hint_t * hint;
 
+    /**Pointer to the already calculated lines of `text`. Used only if it was calculated with the same
+     * text, font, letter space, width and flags. Otherwise the lines are calculated while drawing.*/
+    const lv_text_layout_t * text_layout;
+
     /* Properties of the letter outlines */
     lv_color_t outline_stroke_color;
     int32_t outline_stroke_width;
@@ -26,12 +26,31 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#ifndef LV_DRAW_TASK_CHUNK_SIZE
+/**
+ * Draw tasks and their descriptors are allocated from chunks of this size (in bytes)
+ * instead of calling `lv_malloc` for each. A chunk is reused when all of its draw tasks are removed.
+ * 0: allocate each draw task with `lv_malloc`*/
+#define LV_DRAW_TASK_CHUNK_SIZE (8 * 1024)
+#endif
+
+/**
+ * Number of dependent draw tasks stored in the draw task itself.
+ * `lv_malloc` is called only if more newer tasks overlap a task.*/
+#define LV_DRAW_TASK_INLINE_DEPENDENT_CNT 4
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct _lv_draw_task_chunk_t lv_draw_task_chunk_t;
+
 struct _lv_draw_task_t {
     lv_draw_task_t * next;
+    lv_draw_task_t * prev;
+
+    /** The chunk from which the task was allocated or NULL if it was allocated by `lv_malloc`*/
+    lv_draw_task_chunk_t * chunk;
 
     lv_draw_task_type_t type;
 
@@ -66,6 +85,24 @@ struct _lv_draw_task_t {
 
     volatile int state;              /** int instead of lv_draw_task_state_t to be sure its atomic */
 
+    /** Number of older, not finished draw tasks whose area overlaps with this task's area.
+     * The task can be drawn only if it's 0.*/
+    uint32_t dependency_cnt;
+
+    /** Newer draw tasks waiting for this task. Their `dependency_cnt` is decremented when this task is removed.
+     * They are stored in `dependents_inline` until it gets full, then in the allocated `dependents`*/
+    lv_draw_task_t * dependents_inline[LV_DRAW_TASK_INLINE_DEPENDENT_CNT];
+    lv_draw_task_t ** dependents;
+    uint32_t dependent_cnt;
+    uint32_t dependent_size;        /**< Number of elements allocated in `dependents`*/
+
+    /** 1: the dependencies of this task are already registered by `lv_draw_finalize_task_creation`*/
+    uint8_t dependencies_registered;
+
+    /** 1: a dependency couldn't be recorded (out of memory) so `dependency_cnt` is not reliable.
+     * Check the overlapping older tasks instead.*/
+    uint8_t dependencies_incomplete;
+
     void * draw_dsc;
 
     /** Opacity of the layer */
@@ -185,14 +222,28 @@ typedef struct {
 #else
     volatile int dispatch_req;
 #endif
-    lv_mutex_t circle_cache_mutex;
     bool task_running;
+
+    lv_draw_task_chunk_t * task_chunk_act;      /**< New draw tasks are allocated from this chunk */
+    lv_draw_task_chunk_t * task_chunk_spare;    /**< An empty chunk kept to be used when the current gets full */
+    lv_draw_task_mem_monitor_t task_mem;        /**< Statistics about the draw tasks' memory usage */
 } lv_draw_global_info_t;
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Split a queued draw task horizontally. The rows from `y` are moved into a new draw task
+ * which is inserted right after `t`. Both tasks have the same draw descriptor (copied)
+ * but they are clipped to their own rows, so they can be drawn independently.
+ * Only tasks whose descriptor doesn't own any resources (e.g. fill and image) can be split.
+ * @param t         the draw task to split. Its clip area is reduced to the rows above `y`.
+ * @param y         the first row of the new draw task
+ * @return          the new draw task or NULL if `y` is not inside the clip area or on error
+ */
+lv_draw_task_t * lv_draw_task_split(lv_draw_task_t * t, int32_t y);
+
 /**********************
  *      MACROS
  **********************/
@@ -192,6 +192,46 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
  */
 lv_draw_buf_t * lv_image_decoder_post_process(lv_image_decoder_dsc_t * dsc, lv_draw_buf_t * decoded);
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+/**
+ * Enable or disable decoding the images in the background thread.
+ * If enabled, a placeholder is drawn instead of the images which are not in the image cache yet,
+ * and the Widgets are invalidated when their images are decoded. Enabled by default.
+ * @param en        true: decode the images in the background; false: decode them when they are drawn
+ */
+void lv_image_decoder_set_async(bool en);
+
+/**
+ * Check if the images are decoded in the background thread.
+ * @return          true: async decoding is enabled
+ */
+bool lv_image_decoder_get_async(void);
+
+/**
+ * Set the placeholder to draw while an image is being decoded in the background.
+ * @param color     color of the placeholder
+ * @param opa       opacity of the placeholder. `LV_OPA_TRANSP` to draw nothing.
+ */
+void lv_image_decoder_set_async_placeholder(lv_color_t color, lv_opa_t opa);
+
+/**
+ * Decode an image in the background thread and keep it in the image cache.
+ * Useful to warm the images of a screen before loading it.
+ * @param src       the image source, same as in `lv_image_set_src()`
+ * @return          LV_RESULT_OK: the image is cached or queued; LV_RESULT_INVALID: the image can't be decoded
+ */
+lv_result_t lv_image_decoder_prefetch(const void * src);
+
+/**
+ * Check if an image is being decoded in the background thread.
+ * @param src       the image source
+ * @return          true: the image is queued or the Widgets using it are not invalidated yet
+ */
+bool lv_image_decoder_is_pending(const void * src);
+
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,440 @@
+/**
+ * @file lv_image_decoder_async.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_image_decoder_private.h"
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+#include "../core/lv_global.h"
+#include "../core/lv_obj.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_array.h"
+#include "../misc/lv_ll.h"
+#include "../misc/lv_timer.h"
+#include "../osal/lv_os.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define async_p (LV_GLOBAL_DEFAULT()->img_decoder_async)
+#define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
+
+/*Number of images remembered to be not cached by their decoder*/
+#define NO_CACHE_SRC_CNT 8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    REQUEST_STATE_QUEUED,       /**< Waiting for or being decoded by the thread*/
+    REQUEST_STATE_DONE,         /**< Decoded and added to the image cache*/
+    REQUEST_STATE_NO_CACHE,     /**< The decoder doesn't cache this image, so it's drawn synchronously*/
+} request_state_t;
+
+typedef struct {
+    const void * src;           /**< The image source. Files paths are copied.*/
+    lv_image_src_t src_type;
+    request_state_t state;
+    lv_array_t objs;            /**< The Widgets to invalidate when the image is decoded*/
+} request_t;
+
+typedef struct {
+    const void * src;           /**< The image source. Files paths are copied.*/
+    lv_image_src_t src_type;
+} no_cache_src_t;
+
+typedef struct _lv_image_decoder_async_t {
+    lv_ll_t request_ll;         /**< Protected by `lock`*/
+    lv_mutex_t lock;
+    lv_thread_sync_t sync;      /**< Wakes up the thread when a new request is added*/
+    lv_thread_t thread;
+    lv_timer_t * timer;         /**< Invalidates the Widgets of the decoded images*/
+    no_cache_src_t no_cache_srcs[NO_CACHE_SRC_CNT]; /**< Drawn synchronously, not decoded again. Protected by `lock`*/
+    uint32_t no_cache_next;     /**< Index of the next `no_cache_srcs` slot to overwrite*/
+    lv_color_t placeholder_color;
+    lv_opa_t placeholder_opa;
+    bool enabled;
+    bool thread_started;
+    bool exit;
+} lv_image_decoder_async_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static request_t * find_request(lv_image_decoder_async_t * async, const void * src, lv_image_src_t src_type);
+static request_t * add_request(lv_image_decoder_async_t * async, const void * src, lv_image_src_t src_type);
+static void delete_request(lv_image_decoder_async_t * async, request_t * req);
+static bool is_no_cache(lv_image_decoder_async_t * async, const void * src, lv_image_src_t src_type);
+static void add_no_cache(lv_image_decoder_async_t * async, request_t * req);
+static bool src_is_equal(const void * src1, lv_image_src_t src_type1, const void * src2, lv_image_src_t src_type2);
+static bool is_cached(const void * src, lv_image_src_t src_type);
+static bool needs_decoding(const void * src, const lv_image_header_t * header);
+static void decoder_thread_cb(void * user_data);
+static void timer_cb(lv_timer_t * timer);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_image_decoder_async_init(void)
+{
+    lv_image_decoder_async_t * async = lv_malloc_zeroed(sizeof(lv_image_decoder_async_t));
+    LV_ASSERT_MALLOC(async);
+    if(async == NULL) return;
+
+    lv_ll_init(&async->request_ll, sizeof(request_t));
+    lv_mutex_init(&async->lock);
+    lv_thread_sync_init(&async->sync);
+
+    async->timer = lv_timer_create(timer_cb, LV_DEF_REFR_PERIOD, async);
+    lv_timer_pause(async->timer);
+
+    async->placeholder_color = lv_color_hex3(0xccc);
+    async->placeholder_opa = LV_OPA_50;
+    async->enabled = true;
+
+    async_p = async;
+}
+
+void lv_image_decoder_async_deinit(void)
+{
+    lv_image_decoder_async_t * async = async_p;
+    if(async == NULL) return;
+
+    if(async->thread_started) {
+        lv_mutex_lock(&async->lock);
+        async->exit = true;
+        lv_mutex_unlock(&async->lock);
+
+        lv_thread_sync_signal(&async->sync);
+        lv_thread_delete(&async->thread);
+    }
+
+    request_t * req = lv_ll_get_head(&async->request_ll);
+    while(req) {
+        request_t * next = lv_ll_get_next(&async->request_ll, req);
+        delete_request(async, req);
+        req = next;
+    }
+
+    uint32_t i;
+    for(i = 0; i < NO_CACHE_SRC_CNT; i++) {
+        if(async->no_cache_srcs[i].src_type == LV_IMAGE_SRC_FILE) lv_free((void *)async->no_cache_srcs[i].src);
+    }
+
+    lv_timer_delete(async->timer);
+    lv_thread_sync_delete(&async->sync);
+    lv_mutex_delete(&async->lock);
+    lv_free(async);
+    async_p = NULL;
+}
+
+void lv_image_decoder_set_async(bool en)
+{
+    if(async_p == NULL) return;
+    async_p->enabled = en;
+}
+
+bool lv_image_decoder_get_async(void)
+{
+    if(async_p == NULL) return false;
+    return async_p->enabled;
+}
+
+void lv_image_decoder_set_async_placeholder(lv_color_t color, lv_opa_t opa)
+{
+    if(async_p == NULL) return;
+    async_p->placeholder_color = color;
+    async_p->placeholder_opa = opa;
+}
+
+void lv_image_decoder_async_get_placeholder(lv_color_t * color, lv_opa_t * opa)
+{
+    if(async_p == NULL) {
+        *color = lv_color_black();
+        *opa = LV_OPA_TRANSP;
+        return;
+    }
+
+    *color = async_p->placeholder_color;
+    *opa = async_p->placeholder_opa;
+}
+
+lv_result_t lv_image_decoder_prefetch(const void * src)
+{
+    lv_image_decoder_async_t * async = async_p;
+    if(async == NULL) return LV_RESULT_INVALID;
+    if(src == NULL || !lv_image_cache_is_enabled()) return LV_RESULT_INVALID;
+
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+    if(src_type != LV_IMAGE_SRC_FILE && src_type != LV_IMAGE_SRC_VARIABLE) return LV_RESULT_INVALID;
+
+    lv_mutex_lock(&async->lock);
+    lv_result_t res = LV_RESULT_OK;
+    if(find_request(async, src, src_type) == NULL && !is_no_cache(async, src, src_type) &&
+       !is_cached(src, src_type)) {
+        if(add_request(async, src, src_type) == NULL) res = LV_RESULT_INVALID;
+    }
+    lv_mutex_unlock(&async->lock);
+
+    return res;
+}
+
+bool lv_image_decoder_is_pending(const void * src)
+{
+    lv_image_decoder_async_t * async = async_p;
+    if(async == NULL || src == NULL) return false;
+
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+
+    lv_mutex_lock(&async->lock);
+    request_t * req = find_request(async, src, src_type);
+    bool pending = req && req->state != REQUEST_STATE_NO_CACHE;
+    lv_mutex_unlock(&async->lock);
+
+    return pending;
+}
+
+bool lv_image_decoder_async_draw_placeholder(const void * src, const lv_image_header_t * header, lv_obj_t * obj)
+{
+    lv_image_decoder_async_t * async = async_p;
+    if(async == NULL || !async->enabled || obj == NULL) return false;
+    if(!lv_image_cache_is_enabled()) return false;
+    if(!needs_decoding(src, header)) return false;
+
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+
+    lv_mutex_lock(&async->lock);
+    request_t * req = find_request(async, src, src_type);
+    if(req == NULL) {
+        /*Not requested yet, draw it normally if it's already decoded or can't be cached*/
+        if(!is_no_cache(async, src, src_type) && !is_cached(src, src_type)) req = add_request(async, src, src_type);
+    }
+    else if(req->state != REQUEST_STATE_QUEUED) {
+        /*Decoded meanwhile or can't be cached*/
+        req = NULL;
+    }
+
+    if(req) {
+        uint32_t i;
+        uint32_t obj_cnt = lv_array_size(&req->objs);
+        for(i = 0; i < obj_cnt; i++) {
+            if(*(lv_obj_t **)lv_array_at(&req->objs, i) == obj) break;
+        }
+        if(i == obj_cnt) lv_array_push_back(&req->objs, &obj);
+    }
+    lv_mutex_unlock(&async->lock);
+
+    return req != NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Find the request of an image source. Should be called under `lock`.
+ */
+static request_t * find_request(lv_image_decoder_async_t * async, const void * src, lv_image_src_t src_type)
+{
+    request_t * req;
+    LV_LL_READ(&async->request_ll, req) {
+        if(src_is_equal(req->src, req->src_type, src, src_type)) return req;
+    }
+
+    return NULL;
+}
+
+/**
+ * Queue an image for the thread and start the thread if required. Should be called under `lock`.
+ */
+static request_t * add_request(lv_image_decoder_async_t * async, const void * src, lv_image_src_t src_type)
+{
+    if(!async->thread_started) {
+        lv_result_t res = lv_thread_init(&async->thread, "image_decoder", LV_THREAD_PRIO_LOW, decoder_thread_cb,
+                                         LV_IMAGE_DECODER_ASYNC_STACK_SIZE, async);
+        if(res != LV_RESULT_OK) {
+            LV_LOG_WARN("Couldn't start the image decoder thread");
+            return NULL;
+        }
+        async->thread_started = true;
+    }
+
+    request_t * req = lv_ll_ins_tail(&async->request_ll);
+    LV_ASSERT_MALLOC(req);
+    if(req == NULL) return NULL;
+
+    lv_memzero(req, sizeof(request_t));
+    req->src_type = src_type;
+    req->src = src_type == LV_IMAGE_SRC_FILE ? lv_strdup(src) : src;
+    req->state = REQUEST_STATE_QUEUED;
+    lv_array_init(&req->objs, 1, sizeof(lv_obj_t *));
+
+    lv_timer_resume(async->timer);
+    lv_thread_sync_signal(&async->sync);
+
+    return req;
+}
+
+static void delete_request(lv_image_decoder_async_t * async, request_t * req)
+{
+    if(req->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)req->src);
+    lv_array_deinit(&req->objs);
+    lv_ll_remove(&async->request_ll, req);
+    lv_free(req);
+}
+
+/**
+ * Check if an image was found to be not cached by its decoder. Should be called under `lock`.
+ */
+static bool is_no_cache(lv_image_decoder_async_t * async, const void * src, lv_image_src_t src_type)
+{
+    uint32_t i;
+    for(i = 0; i < NO_CACHE_SRC_CNT; i++) {
+        no_cache_src_t * nc = &async->no_cache_srcs[i];
+        if(nc->src && src_is_equal(nc->src, nc->src_type, src, src_type)) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Remember the source of a request whose image is not cached by its decoder, so that it's not queued again.
+ * The oldest remembered source is dropped. Should be called under `lock`.
+ */
+static void add_no_cache(lv_image_decoder_async_t * async, request_t * req)
+{
+    no_cache_src_t * nc = &async->no_cache_srcs[async->no_cache_next];
+    if(nc->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)nc->src);
+
+    /*Take over the copied path of the request*/
+    nc->src = req->src;
+    nc->src_type = req->src_type;
+    req->src = NULL;
+
+    async->no_cache_next = (async->no_cache_next + 1) % NO_CACHE_SRC_CNT;
+}
+
+static bool src_is_equal(const void * src1, lv_image_src_t src_type1, const void * src2, lv_image_src_t src_type2)
+{
+    if(src_type1 != src_type2) return false;
+    if(src_type1 == LV_IMAGE_SRC_FILE) return lv_strcmp(src1, src2) == 0;
+    return src1 == src2;
+}
+
+static bool is_cached(const void * src, lv_image_src_t src_type)
+{
+    lv_image_cache_data_t search_key;
+    search_key.src_type = src_type;
+    search_key.src = src;
+
+    lv_cache_entry_t * entry = lv_cache_acquire(img_cache_p, &search_key, NULL);
+    if(entry == NULL) return false;
+
+    lv_cache_release(img_cache_p, entry, NULL);
+    return true;
+}
+
+/**
+ * Only files and encoded (e.g. PNG) or compressed variables are worth decoding in the background.
+ * The plain images in variables are used directly.
+ */
+static bool needs_decoding(const void * src, const lv_image_header_t * header)
+{
+    switch(lv_image_src_get_type(src)) {
+        case LV_IMAGE_SRC_FILE:
+            return true;
+        case LV_IMAGE_SRC_VARIABLE:
+            return header->cf == LV_COLOR_FORMAT_RAW || header->cf == LV_COLOR_FORMAT_RAW_ALPHA ||
+                   (header->flags & LV_IMAGE_FLAGS_COMPRESSED);
+        default:
+            return false;
+    }
+}
+
+static void decoder_thread_cb(void * user_data)
+{
+    lv_image_decoder_async_t * async = user_data;
+
+    while(1) {
+        lv_mutex_lock(&async->lock);
+        if(async->exit) {
+            lv_mutex_unlock(&async->lock);
+            break;
+        }
+
+        request_t * req;
+        LV_LL_READ(&async->request_ll, req) {
+            if(req->state == REQUEST_STATE_QUEUED) break;
+        }
+        lv_mutex_unlock(&async->lock);
+
+        if(req == NULL) {
+            lv_thread_sync_wait(&async->sync);
+            continue;
+        }
+
+        /*The queued requests are not removed by the other threads so `req` can be used without locking.
+         *The decoders add the decoded image to the image cache so it's enough to open and close it.*/
+        bool cached = false;
+        lv_image_decoder_dsc_t decoder_dsc;
+        if(lv_image_decoder_open(&decoder_dsc, req->src, NULL) == LV_RESULT_OK) {
+            cached = decoder_dsc.cache_entry != NULL;
+            lv_image_decoder_close(&decoder_dsc);
+        }
+
+        lv_mutex_lock(&async->lock);
+        req->state = cached ? REQUEST_STATE_DONE : REQUEST_STATE_NO_CACHE;
+        lv_mutex_unlock(&async->lock);
+    }
+
+    LV_LOG_INFO("exit image decoder thread");
+}
+
+static void timer_cb(lv_timer_t * timer)
+{
+    lv_image_decoder_async_t * async = lv_timer_get_user_data(timer);
+    bool has_queued = false;
+
+    lv_mutex_lock(&async->lock);
+    request_t * req = lv_ll_get_head(&async->request_ll);
+    while(req) {
+        request_t * next = lv_ll_get_next(&async->request_ll, req);
+        if(req->state == REQUEST_STATE_QUEUED) {
+            has_queued = true;
+        }
+        else {
+            uint32_t i;
+            for(i = 0; i < lv_array_size(&req->objs); i++) {
+                lv_obj_t * obj = *(lv_obj_t **)lv_array_at(&req->objs, i);
+                if(lv_obj_is_valid(obj)) lv_obj_invalidate(obj);
+            }
+
+            /*The images which are not cached are remembered to not decode them again in the background*/
+            if(req->state == REQUEST_STATE_NO_CACHE) add_no_cache(async, req);
+            delete_request(async, req);
+        }
+        req = next;
+    }
+
+    if(!has_queued) lv_timer_pause(timer);
+    lv_mutex_unlock(&async->lock);
+}
+
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
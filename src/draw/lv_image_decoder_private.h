@@ -133,6 +133,37 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void);
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+/**
+ * Initialize the background image decoding. The thread is started only when the first image is queued.
+ */
+void lv_image_decoder_async_init(void);
+
+/**
+ * Stop the background thread and drop the queued images.
+ */
+void lv_image_decoder_async_deinit(void);
+
+/**
+ * Queue an image for background decoding if it's not in the image cache yet.
+ * Used by `lv_draw_image()` to decide whether to draw the image or a placeholder.
+ * @param src       the image source
+ * @param header    the header of the image
+ * @param obj       the Widget to invalidate when the image is decoded. NULL to decode synchronously.
+ * @return          true: the image is not decoded yet, draw the placeholder instead
+ */
+bool lv_image_decoder_async_draw_placeholder(const void * src, const lv_image_header_t * header, lv_obj_t * obj);
+
+/**
+ * Get the placeholder set by `lv_image_decoder_set_async_placeholder()`
+ * @param color     store the color here
+ * @param opa       store the opacity here
+ */
+void lv_image_decoder_async_get_placeholder(lv_color_t * color, lv_opa_t * opa);
+
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,606 @@
+/**
+ * @file lv_blend_sse2.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_draw_sw_blend_private.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2
+
+#include "lv_blend_sse2.h"
+#include "../../../../misc/lv_color.h"
+
+#include <emmintrin.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Mask to spread the channels of an RGB565 color in a 32-bit word (`c | c << 16`) with gaps between them*/
+#define RGB565_SPREAD_MASK  0x07E0F81F
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void blend_to_rgb565(uint16_t * dest_buf, int32_t dest_stride, const uint16_t * src_buf, int32_t src_stride,
+                            uint16_t color, const lv_opa_t * mask_buf, int32_t mask_stride, lv_opa_t opa,
+                            int32_t w, int32_t h);
+
+static void argb8888_blend_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc);
+
+static void blend_to_xrgb8888(uint8_t * dest_buf, int32_t dest_stride, const uint8_t * src_buf, int32_t src_stride,
+                              bool src_has_alpha, uint32_t color, const lv_opa_t * mask_buf, int32_t mask_stride,
+                              lv_opa_t opa, int32_t w, int32_t h);
+
+static void fill_u32(uint32_t * dest_buf, int32_t dest_stride, uint32_t color, int32_t w, int32_t h);
+
+static inline __m128i mix_rgb565_x8(__m128i fg, __m128i bg, __m128i mix);
+
+static inline __m128i mix_argb8888_rgb565_x8(__m128i px0, __m128i px1, __m128i bg, __m128i mix);
+
+static inline __m128i mix_xrgb8888_x4(__m128i fg, __m128i bg, __m128i mix);
+
+static inline __m128i select_si128(__m128i sel, __m128i a, __m128i b);
+
+static inline uint16_t lv_color_24_16_mix(const uint8_t * c1, uint16_t c2, uint8_t mix);
+
+static inline void lv_color_24_24_mix(const uint8_t * src, uint8_t * dest, uint8_t mix);
+
+static inline void * drawbuf_next_row(const void * buf, uint32_t stride);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_color_blend_to_rgb565_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint16_t color16 = lv_color_to_u16(dsc->color);
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    const __m128i color_x8 = _mm_set1_epi16((int16_t)color16);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x <= w - 8; x += 8) {
+            _mm_storeu_si128((__m128i *)&dest_buf_u16[x], color_x8);
+        }
+        for(; x < w; x++) {
+            dest_buf_u16[x] = color16;
+        }
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dsc->dest_stride);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_with_opa_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_to_rgb565(dsc->dest_buf, dsc->dest_stride, NULL, 0, lv_color_to_u16(dsc->color), NULL, 0, dsc->opa,
+                    dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_with_mask_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_to_rgb565(dsc->dest_buf, dsc->dest_stride, NULL, 0, lv_color_to_u16(dsc->color), dsc->mask_buf,
+                    dsc->mask_stride, LV_OPA_COVER, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_mix_mask_opa_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_to_rgb565(dsc->dest_buf, dsc->dest_stride, NULL, 0, lv_color_to_u16(dsc->color), dsc->mask_buf,
+                    dsc->mask_stride, dsc->opa, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_to_rgb565(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0, NULL, 0, dsc->opa,
+                    dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_mask_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_to_rgb565(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0, dsc->mask_buf,
+                    dsc->mask_stride, LV_OPA_COVER, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_to_rgb565(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0, dsc->mask_buf,
+                    dsc->mask_stride, dsc->opa, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_blend_to_rgb565(dsc);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_with_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_blend_to_rgb565(dsc);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_with_mask_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_blend_to_rgb565(dsc);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_blend_to_rgb565(dsc);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_sse2(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    fill_u32(dsc->dest_buf, dsc->dest_stride, lv_color_to_u32(dsc->color), dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_with_opa_sse2(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_to_xrgb8888(dsc->dest_buf, dsc->dest_stride, NULL, 0, false, lv_color_to_u32(dsc->color), NULL, 0,
+                      dsc->opa, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_with_mask_sse2(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_to_xrgb8888(dsc->dest_buf, dsc->dest_stride, NULL, 0, false, lv_color_to_u32(dsc->color), dsc->mask_buf,
+                      dsc->mask_stride, LV_OPA_COVER, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_mix_mask_opa_sse2(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_to_xrgb8888(dsc->dest_buf, dsc->dest_stride, NULL, 0, false, lv_color_to_u32(dsc->color), dsc->mask_buf,
+                      dsc->mask_stride, dsc->opa, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb888_with_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size,
+                                                           uint32_t src_px_size)
+{
+    if(dst_px_size != 4 || src_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_to_xrgb8888(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, false, 0, NULL, 0,
+                      dsc->opa, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb888_with_mask_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size,
+                                                            uint32_t src_px_size)
+{
+    if(dst_px_size != 4 || src_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_to_xrgb8888(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, false, 0, dsc->mask_buf,
+                      dsc->mask_stride, LV_OPA_COVER, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb888_mix_mask_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size,
+                                                               uint32_t src_px_size)
+{
+    if(dst_px_size != 4 || src_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_to_xrgb8888(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, false, 0, dsc->mask_buf,
+                      dsc->mask_stride, dsc->opa, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_to_xrgb8888(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, true, 0, NULL, 0,
+                      LV_OPA_COVER, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_with_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_to_xrgb8888(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, true, 0, NULL, 0,
+                      dsc->opa, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_with_mask_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_to_xrgb8888(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, true, 0, dsc->mask_buf,
+                      dsc->mask_stride, LV_OPA_COVER, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_mix_mask_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                 uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_to_xrgb8888(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, true, 0, dsc->mask_buf,
+                      dsc->mask_stride, dsc->opa, dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    fill_u32(dsc->dest_buf, dsc->dest_stride, lv_color_to_u32(dsc->color), dsc->dest_w, dsc->dest_h);
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Mix a color or an RGB565 image into an RGB565 buffer.
+ * The opacity of the pixels is `opa`, the mask value or their mix if both are used.
+ * @param src_buf   the source image or NULL to use `color`
+ * @param mask_buf  the mask or NULL if there is no mask
+ * @param opa       the overall opacity. `>= LV_OPA_MAX` means fully opaque.
+ */
+static void blend_to_rgb565(uint16_t * dest_buf, int32_t dest_stride, const uint16_t * src_buf, int32_t src_stride,
+                            uint16_t color, const lv_opa_t * mask_buf, int32_t mask_stride, lv_opa_t opa,
+                            int32_t w, int32_t h)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opa_x8 = _mm_set1_epi16(opa);
+    __m128i fg = _mm_set1_epi16((int16_t)color);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x <= w - 8; x += 8) {
+            __m128i mix = opa_x8;
+            if(mask_buf) {
+                mix = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&mask_buf[x]), zero);
+                if(opa < LV_OPA_MAX) mix = _mm_srli_epi16(_mm_mullo_epi16(mix, opa_x8), 8);
+            }
+            if(src_buf) fg = _mm_loadu_si128((const __m128i *)&src_buf[x]);
+
+            __m128i bg = _mm_loadu_si128((const __m128i *)&dest_buf[x]);
+            _mm_storeu_si128((__m128i *)&dest_buf[x], mix_rgb565_x8(fg, bg, mix));
+        }
+
+        for(; x < w; x++) {
+            lv_opa_t mix = opa;
+            if(mask_buf) mix = opa < LV_OPA_MAX ? LV_OPA_MIX2(mask_buf[x], opa) : mask_buf[x];
+            dest_buf[x] = lv_color_16_16_mix(src_buf ? src_buf[x] : color, dest_buf[x], mix);
+        }
+
+        dest_buf = drawbuf_next_row(dest_buf, dest_stride);
+        if(src_buf) src_buf = drawbuf_next_row(src_buf, src_stride);
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+static void argb8888_blend_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint8_t * src_buf_u8 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opa_x8 = _mm_set1_epi16(opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x <= w - 8; x += 8) {
+            __m128i px0 = _mm_loadu_si128((const __m128i *)&src_buf_u8[x * 4]);
+            __m128i px1 = _mm_loadu_si128((const __m128i *)&src_buf_u8[x * 4 + 16]);
+            __m128i mix = _mm_packs_epi32(_mm_srli_epi32(px0, 24), _mm_srli_epi32(px1, 24));
+            if(mask_buf) {
+                __m128i mask = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&mask_buf[x]), zero);
+                mix = _mm_mullo_epi16(mix, mask);
+                /*LV_OPA_MIX3 or LV_OPA_MIX2*/
+                if(opa < LV_OPA_MAX) mix = _mm_mulhi_epu16(mix, opa_x8);
+                else mix = _mm_srli_epi16(mix, 8);
+            }
+            else if(opa < LV_OPA_MAX) {
+                mix = _mm_srli_epi16(_mm_mullo_epi16(mix, opa_x8), 8);
+            }
+
+            __m128i bg = _mm_loadu_si128((const __m128i *)&dest_buf_u16[x]);
+            _mm_storeu_si128((__m128i *)&dest_buf_u16[x], mix_argb8888_rgb565_x8(px0, px1, bg, mix));
+        }
+
+        for(; x < w; x++) {
+            const uint8_t * px = &src_buf_u8[x * 4];
+            lv_opa_t mix = px[3];
+            if(mask_buf) mix = opa < LV_OPA_MAX ? LV_OPA_MIX3(px[3], mask_buf[x], opa) : LV_OPA_MIX2(px[3], mask_buf[x]);
+            else if(opa < LV_OPA_MAX) mix = LV_OPA_MIX2(px[3], opa);
+            dest_buf_u16[x] = lv_color_24_16_mix(px, dest_buf_u16[x], mix);
+        }
+
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        src_buf_u8 += src_stride;
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+/**
+ * Mix a color, an XRGB8888 or an ARGB8888 image into an XRGB8888 buffer.
+ * Only the color channels of the destination are written.
+ * @param src_buf       the source image or NULL to use `color`
+ * @param src_has_alpha true: multiply the opacity with the alpha channel of `src_buf`
+ * @param mask_buf      the mask or NULL if there is no mask
+ * @param opa           the overall opacity. `>= LV_OPA_MAX` means fully opaque.
+ */
+static void blend_to_xrgb8888(uint8_t * dest_buf, int32_t dest_stride, const uint8_t * src_buf, int32_t src_stride,
+                              bool src_has_alpha, uint32_t color, const lv_opa_t * mask_buf, int32_t mask_stride,
+                              lv_opa_t opa, int32_t w, int32_t h)
+{
+    const __m128i opa_x4 = _mm_set1_epi32(opa);
+    __m128i fg = _mm_set1_epi32((int32_t)color);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x <= w - 4; x += 4) {
+            if(src_buf) fg = _mm_loadu_si128((const __m128i *)&src_buf[x * 4]);
+
+            __m128i mix = opa_x4;
+            if(mask_buf) {
+                mix = _mm_setr_epi32(mask_buf[x], mask_buf[x + 1], mask_buf[x + 2], mask_buf[x + 3]);
+            }
+            if(src_has_alpha) {
+                __m128i alpha = _mm_srli_epi32(fg, 24);
+                if(mask_buf) {
+                    /*LV_OPA_MIX3 or LV_OPA_MIX2*/
+                    mix = _mm_mullo_epi16(alpha, mix);
+                    if(opa < LV_OPA_MAX) mix = _mm_mulhi_epu16(mix, opa_x4);
+                    else mix = _mm_srli_epi32(mix, 8);
+                }
+                else if(opa < LV_OPA_MAX) mix = _mm_srli_epi32(_mm_mullo_epi16(alpha, opa_x4), 8);
+                else mix = alpha;
+            }
+            else if(mask_buf && opa < LV_OPA_MAX) {
+                mix = _mm_srli_epi32(_mm_mullo_epi16(mix, opa_x4), 8);
+            }
+
+            __m128i bg = _mm_loadu_si128((const __m128i *)&dest_buf[x * 4]);
+            _mm_storeu_si128((__m128i *)&dest_buf[x * 4], mix_xrgb8888_x4(fg, bg, mix));
+        }
+
+        for(; x < w; x++) {
+            const uint8_t * px = src_buf ? &src_buf[x * 4] : (const uint8_t *)&color;
+            lv_opa_t mix = opa;
+            if(src_has_alpha) {
+                if(mask_buf) mix = opa < LV_OPA_MAX ? LV_OPA_MIX3(px[3], mask_buf[x], opa) : LV_OPA_MIX2(px[3], mask_buf[x]);
+                else mix = opa < LV_OPA_MAX ? LV_OPA_MIX2(px[3], opa) : px[3];
+            }
+            else if(mask_buf) {
+                mix = opa < LV_OPA_MAX ? LV_OPA_MIX2(opa, mask_buf[x]) : mask_buf[x];
+            }
+            lv_color_24_24_mix(px, &dest_buf[x * 4], mix);
+        }
+
+        dest_buf += dest_stride;
+        if(src_buf) src_buf += src_stride;
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+static void fill_u32(uint32_t * dest_buf, int32_t dest_stride, uint32_t color, int32_t w, int32_t h)
+{
+    const __m128i color_x4 = _mm_set1_epi32((int32_t)color);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x <= w - 8; x += 8) {
+            _mm_storeu_si128((__m128i *)&dest_buf[x], color_x4);
+            _mm_storeu_si128((__m128i *)&dest_buf[x + 4], color_x4);
+        }
+        for(; x < w; x++) {
+            dest_buf[x] = color;
+        }
+        dest_buf = drawbuf_next_row(dest_buf, dest_stride);
+    }
+}
+
+/**
+ * The same as `lv_color_16_16_mix` for 8 pixels.
+ * @param fg    8 foreground RGB565 colors
+ * @param bg    8 background RGB565 colors
+ * @param mix   8 opacity values on 16 bits
+ * @return      the 8 mixed colors
+ */
+static inline __m128i mix_rgb565_x8(__m128i fg, __m128i bg, __m128i mix)
+{
+    const __m128i spread_mask = _mm_set1_epi32(RGB565_SPREAD_MASK);
+    __m128i res[2];
+
+    mix = _mm_srli_epi16(_mm_add_epi16(mix, _mm_set1_epi16(4)), 3);
+
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        /*Duplicate the colors and the mix to both halves of 32-bit lanes*/
+        __m128i fg32 = i == 0 ? _mm_unpacklo_epi16(fg, fg) : _mm_unpackhi_epi16(fg, fg);
+        __m128i bg32 = i == 0 ? _mm_unpacklo_epi16(bg, bg) : _mm_unpackhi_epi16(bg, bg);
+        __m128i mix32 = i == 0 ? _mm_unpacklo_epi16(mix, mix) : _mm_unpackhi_epi16(mix, mix);
+        fg32 = _mm_and_si128(fg32, spread_mask);
+        bg32 = _mm_and_si128(bg32, spread_mask);
+
+        /*32-bit multiplication with a value <= 32 from 16-bit multiplications*/
+        __m128i diff = _mm_sub_epi32(fg32, bg32);
+        __m128i prod = _mm_add_epi32(_mm_mullo_epi16(diff, mix32), _mm_slli_epi32(_mm_mulhi_epu16(diff, mix32), 16));
+
+        __m128i r = _mm_and_si128(_mm_add_epi32(_mm_srli_epi32(prod, 5), bg32), spread_mask);
+        r = _mm_or_si128(r, _mm_srli_epi32(r, 16));
+
+        /*Sign extend the lower 16 bits so that the saturating pack keeps them unchanged*/
+        res[i] = _mm_srai_epi32(_mm_slli_epi32(r, 16), 16);
+    }
+
+    return _mm_packs_epi32(res[0], res[1]);
+}
+
+/**
+ * The same as `lv_color_24_16_mix` for 8 pixels.
+ * @param px0   the first 4 ARGB8888 pixels
+ * @param px1   the second 4 ARGB8888 pixels
+ * @param bg    8 background RGB565 colors
+ * @param mix   8 opacity values on 16 bits
+ * @return      the 8 mixed RGB565 colors
+ */
+static inline __m128i mix_argb8888_rgb565_x8(__m128i px0, __m128i px1, __m128i bg, __m128i mix)
+{
+    const __m128i ch_mask = _mm_set1_epi32(0xFF);
+    const __m128i r_mask = _mm_set1_epi16((int16_t)0xF800);
+    const __m128i g_mask = _mm_set1_epi16(0x07E0);
+
+    __m128i b = _mm_packs_epi32(_mm_and_si128(px0, ch_mask), _mm_and_si128(px1, ch_mask));
+    __m128i g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(px0, 8), ch_mask),
+                                _mm_and_si128(_mm_srli_epi32(px1, 8), ch_mask));
+    __m128i r = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(px0, 16), ch_mask),
+                                _mm_and_si128(_mm_srli_epi32(px1, 16), ch_mask));
+
+    __m128i bg_r = _mm_srli_epi16(bg, 11);
+    __m128i bg_g = _mm_and_si128(_mm_srli_epi16(bg, 5), _mm_set1_epi16(0x3F));
+    __m128i bg_b = _mm_and_si128(bg, _mm_set1_epi16(0x1F));
+    __m128i mix_inv = _mm_sub_epi16(_mm_set1_epi16(255), mix);
+
+    __m128i res_r = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(r, 3), mix), _mm_mullo_epi16(bg_r, mix_inv));
+    __m128i res_g = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(g, 2), mix), _mm_mullo_epi16(bg_g, mix_inv));
+    __m128i res_b = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(b, 3), mix), _mm_mullo_epi16(bg_b, mix_inv));
+    __m128i res = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(res_r, 3), r_mask),
+                               _mm_and_si128(_mm_srli_epi16(res_g, 3), g_mask));
+    res = _mm_or_si128(res, _mm_srli_epi16(res_b, 8));
+
+    /*Fully opaque pixels are converted directly, fully transparent ones keep the background*/
+    __m128i cover = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(r, 8), r_mask), _mm_and_si128(_mm_slli_epi16(g, 3), g_mask));
+    cover = _mm_or_si128(cover, _mm_srli_epi16(b, 3));
+    res = select_si128(_mm_cmpeq_epi16(mix, _mm_set1_epi16(255)), cover, res);
+    res = select_si128(_mm_cmpeq_epi16(mix, _mm_setzero_si128()), bg, res);
+
+    return res;
+}
+
+/**
+ * The same as `lv_color_24_24_mix` for 4 XRGB8888 pixels.
+ * @param fg    4 foreground pixels
+ * @param bg    4 background pixels
+ * @param mix   4 opacity values on 32 bits
+ * @return      the 4 mixed pixels with the 4th byte of `bg`
+ */
+static inline __m128i mix_xrgb8888_x4(__m128i fg, __m128i bg, __m128i mix)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i rgb_mask = _mm_set1_epi32(0x00FFFFFF);
+
+    /*Spread the mix values to the 4 channels of the pixels*/
+    __m128i mix16 = _mm_or_si128(mix, _mm_slli_epi32(mix, 16));
+    __m128i mix_lo = _mm_unpacklo_epi32(mix16, mix16);
+    __m128i mix_hi = _mm_unpackhi_epi32(mix16, mix16);
+
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(fg, zero), mix_lo),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(bg, zero), _mm_sub_epi16(full, mix_lo)));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(fg, zero), mix_hi),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(bg, zero), _mm_sub_epi16(full, mix_hi)));
+    __m128i res = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+
+    res = select_si128(_mm_cmpgt_epi32(mix, _mm_set1_epi32(LV_OPA_MAX - 1)), fg, res);
+    res = select_si128(_mm_cmpeq_epi32(mix, zero), bg, res);
+
+    return _mm_or_si128(_mm_and_si128(res, rgb_mask), _mm_andnot_si128(rgb_mask, bg));
+}
+
+/**
+ * Bitwise select
+ * @param sel   all 1 bits where `a` is needed, all 0 bits where `b`
+ * @param a     the first value
+ * @param b     the second value
+ * @return      `(a & sel) | (b & ~sel)`
+ */
+static inline __m128i select_si128(__m128i sel, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(sel, a), _mm_andnot_si128(sel, b));
+}
+
+static inline uint16_t lv_color_24_16_mix(const uint8_t * c1, uint16_t c2, uint8_t mix)
+{
+    if(mix == 0) {
+        return c2;
+    }
+    else if(mix == 255) {
+        return ((c1[2] & 0xF8) << 8)  + ((c1[1] & 0xFC) << 3) + ((c1[0] & 0xF8) >> 3);
+    }
+    else {
+        lv_opa_t mix_inv = 255 - mix;
+
+        return ((((c1[2] >> 3) * mix + ((c2 >> 11) & 0x1F) * mix_inv) << 3) & 0xF800) +
+               ((((c1[1] >> 2) * mix + ((c2 >> 5) & 0x3F) * mix_inv) >> 3) & 0x07E0) +
+               (((c1[0] >> 3) * mix + (c2 & 0x1F) * mix_inv) >> 8);
+    }
+}
+
+static inline void lv_color_24_24_mix(const uint8_t * src, uint8_t * dest, uint8_t mix)
+{
+    if(mix == 0) return;
+
+    if(mix >= LV_OPA_MAX) {
+        dest[0] = src[0];
+        dest[1] = src[1];
+        dest[2] = src[2];
+    }
+    else {
+        lv_opa_t mix_inv = 255 - mix;
+        dest[0] = (uint32_t)((uint32_t)src[0] * mix + dest[0] * mix_inv) >> 8;
+        dest[1] = (uint32_t)((uint32_t)src[1] * mix + dest[1] * mix_inv) >> 8;
+        dest[2] = (uint32_t)((uint32_t)src[2] * mix + dest[2] * mix_inv) >> 8;
+    }
+}
+
+static inline void * drawbuf_next_row(const void * buf, uint32_t stride)
+{
+    return (void *)((uint8_t *)buf + stride);
+}
+
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2*/
@@ -48,6 +48,14 @@
  **********************/
 #if LV_USE_OS
     static void render_thread_cb(void * ptr);
+    static lv_draw_sw_thread_dsc_t * get_thread_to_queue(lv_draw_sw_unit_t * draw_sw_unit);
+    static lv_draw_task_t * take_task(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_sw_thread_dsc_t * thread_dsc);
+    static bool has_idle_thread(lv_draw_sw_unit_t * draw_sw_unit);
+#endif
+
+#if LV_USE_OS && LV_DRAW_SW_DRAW_UNIT_CNT > 1
+    static uint32_t get_band_cnt(lv_draw_task_t * t, uint32_t idle_cnt);
+    static void split_to_bands(lv_draw_task_t * t, uint32_t band_cnt);
 #endif
 
 static void execute_drawing(lv_draw_task_t * t);
@@ -79,6 +87,14 @@ void lv_draw_sw_init(void)
     lv_draw_sw_mask_init();
 #endif
 
+#if LV_DRAW_SW_COMPLEX == 1 && defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    lv_draw_sw_shadow_cache_init(LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE);
+#endif
+
+#if defined(LV_DRAW_SW_GRAD_CACHE_SIZE) && LV_DRAW_SW_GRAD_CACHE_SIZE > 0
+    lv_draw_sw_grad_cache_init(LV_DRAW_SW_GRAD_CACHE_SIZE);
+#endif
+
     lv_draw_sw_unit_t * draw_sw_unit = lv_draw_create_unit(sizeof(lv_draw_sw_unit_t));
     draw_sw_unit->base_unit.dispatch_cb = dispatch;
     draw_sw_unit->base_unit.evaluate_cb = evaluate;
@@ -90,6 +106,8 @@ void lv_draw_sw_init(void)
 #endif
 
 #if LV_USE_OS
+    lv_mutex_init(&draw_sw_unit->task_queue_lock);
+
     uint32_t i;
     for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
         lv_draw_sw_thread_dsc_t * thread_dsc = &draw_sw_unit->thread_dscs[i];
@@ -121,6 +139,14 @@ void lv_draw_sw_deinit(void)
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_deinit();
 #endif
+
+#if LV_DRAW_SW_COMPLEX == 1 && defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    lv_draw_sw_shadow_cache_deinit();
+#endif
+
+#if defined(LV_DRAW_SW_GRAD_CACHE_SIZE) && LV_DRAW_SW_GRAD_CACHE_SIZE > 0
+    lv_draw_sw_grad_cache_deinit();
+#endif
 }
 
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
@@ -141,6 +167,8 @@ static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
         lv_thread_delete(&thread_dsc->thread);
     }
 
+    lv_mutex_delete(&draw_sw_unit->task_queue_lock);
+
     return 0;
 #else
     LV_UNUSED(draw_unit);
@@ -260,48 +288,62 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
      * Otherwise return taken_cnt;
      */
 
-    /*If at least one is busy, it's not all idle*/
+    /*The threads might take tasks from the queues at any time, so check them under lock*/
+    lv_mutex_lock(&draw_sw_unit->task_queue_lock);
     bool all_idle = true;
+    uint32_t idle_cnt = 0;
     for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
-        if(draw_sw_unit->thread_dscs[i].task_act) {
-            all_idle = false;
-            break;
-        }
+        lv_draw_sw_thread_dsc_t * thread_dsc = &draw_sw_unit->thread_dscs[i];
+        if(thread_dsc->task_act || thread_dsc->task_queue_cnt) all_idle = false;
+        else idle_cnt++;
     }
+    lv_mutex_unlock(&draw_sw_unit->task_queue_lock);
 
+    /*Assign as many independent tasks to the threads as their queues can hold.
+     *This way the threads can continue with the next task without waiting for the dispatcher.*/
     lv_draw_task_t * t = NULL;
-    for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
-        lv_draw_sw_thread_dsc_t * thread_dsc = &draw_sw_unit->thread_dscs[i];
-
-        /*Do nothing if busy*/
-        if(thread_dsc->task_act) continue;
-
+    while(1) {
         /*Find an available task. Start from the previously taken task.*/
         t = lv_draw_get_next_available_task(layer, t, DRAW_UNIT_ID_SW);
-
-        /*If there is not available task don't try other threads as there won't be available
-         *tasks for then either*/
-        if(t == NULL) {
-            LV_PROFILER_DRAW_END;
-            if(all_idle) return LV_DRAW_UNIT_IDLE;  /*Couldn't start rendering*/
-            else return taken_cnt;
-        }
+        if(t == NULL) break;
 
         /*Allocate a buffer if not done yet.*/
         void * buf = lv_draw_layer_alloc_buf(layer);
-        /*Do not return is failed. The other thread might already have a buffer can do something. */
-        if(buf == NULL) continue;
+        if(buf == NULL) break;
+
+#if LV_DRAW_SW_DRAW_UNIT_CNT > 1
+        /*Split large tasks to horizontal bands to let the idle threads render them in parallel.
+         *The new bands are inserted after `t` so they will be found as next available tasks.*/
+        uint32_t band_cnt = get_band_cnt(t, idle_cnt);
+        if(band_cnt > 1) {
+            split_to_bands(t, band_cnt);
+            idle_cnt -= band_cnt;
+        }
+#endif
+
+        lv_mutex_lock(&draw_sw_unit->task_queue_lock);
+        lv_draw_sw_thread_dsc_t * thread_dsc = get_thread_to_queue(draw_sw_unit);
+        if(thread_dsc == NULL) {
+            lv_mutex_unlock(&draw_sw_unit->task_queue_lock);
+            break;
+        }
 
         /*Take the task*/
         all_idle = false;
         taken_cnt++;
         t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
-        thread_dsc->task_act = t;
+        t->draw_unit = draw_unit;
+        thread_dsc->task_queue[thread_dsc->task_queue_cnt] = t;
+        thread_dsc->task_queue_cnt++;
+
+        /*Let the render thread work. Busy threads will find the task when they are ready.*/
+        bool signal = thread_dsc->task_act == NULL;
+        lv_mutex_unlock(&draw_sw_unit->task_queue_lock);
 
-        /*Let the render thread work*/
-        if(thread_dsc->inited) lv_thread_sync_signal(&thread_dsc->sync);
+        if(signal && thread_dsc->inited) lv_thread_sync_signal(&thread_dsc->sync);
     }
 
+    LV_PROFILER_DRAW_END;
     if(all_idle) return LV_DRAW_UNIT_IDLE;  /*Couldn't start rendering*/
     else return taken_cnt;
 
@@ -345,39 +387,182 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
 static void render_thread_cb(void * ptr)
 {
     lv_draw_sw_thread_dsc_t * thread_dsc = ptr;
+    lv_draw_sw_unit_t * draw_sw_unit = (lv_draw_sw_unit_t *) thread_dsc->draw_unit;
 
     lv_thread_sync_init(&thread_dsc->sync);
     thread_dsc->inited = true;
 
     while(1) {
-        while(thread_dsc->task_act == NULL) {
+        lv_mutex_lock(&draw_sw_unit->task_queue_lock);
+        lv_draw_task_t * t = take_task(draw_sw_unit, thread_dsc);
+        lv_mutex_unlock(&draw_sw_unit->task_queue_lock);
+
+        if(t == NULL) {
             if(thread_dsc->exit_status) {
+                LV_LOG_INFO("ready to exit software rendering thread");
                 break;
             }
             lv_thread_sync_wait(&thread_dsc->sync);
+            continue;
         }
 
-        if(thread_dsc->exit_status) {
-            LV_LOG_INFO("ready to exit software rendering thread");
-            break;
-        }
-
-        execute_drawing(thread_dsc->task_act);
+        execute_drawing(t);
 #if LV_USE_PARALLEL_DRAW_DEBUG
-        parallel_debug_draw(thread_dsc->task_act, thread_dsc->idx);
+        parallel_debug_draw(t, thread_dsc->idx);
 #endif
-        thread_dsc->task_act->state = LV_DRAW_TASK_STATE_READY;
-        thread_dsc->task_act = NULL;
+        t->state = LV_DRAW_TASK_STATE_READY;
 
-        /*The draw unit is free now. Request a new dispatching as it can get a new task*/
-        lv_draw_dispatch_request();
+        lv_mutex_lock(&draw_sw_unit->task_queue_lock);
+        thread_dsc->task_act = NULL;
+        /*Wake up the dispatcher only if it can do something useful: give new tasks to this or
+         *to an other idle thread. Otherwise this thread just continues with its queued tasks.*/
+        bool request = thread_dsc->task_queue_cnt == 0 || has_idle_thread(draw_sw_unit);
+        lv_mutex_unlock(&draw_sw_unit->task_queue_lock);
 
+        if(request) lv_draw_dispatch_request();
     }
 
     thread_dsc->inited = false;
     lv_thread_sync_delete(&thread_dsc->sync);
     LV_LOG_INFO("exit software rendering thread");
 }
+
+/**
+ * Get the thread with the least queued tasks. Should be called under `task_queue_lock`.
+ * @param draw_sw_unit  pointer to the SW draw unit
+ * @return              a thread whose queue is not full or NULL if all queues are full
+ */
+static lv_draw_sw_thread_dsc_t * get_thread_to_queue(lv_draw_sw_unit_t * draw_sw_unit)
+{
+    lv_draw_sw_thread_dsc_t * thread_min = NULL;
+    uint32_t load_min = LV_DRAW_SW_THREAD_QUEUE_SIZE;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
+        lv_draw_sw_thread_dsc_t * thread_dsc = &draw_sw_unit->thread_dscs[i];
+        if(thread_dsc->task_queue_cnt >= LV_DRAW_SW_THREAD_QUEUE_SIZE) continue;
+
+        uint32_t load = thread_dsc->task_queue_cnt + (thread_dsc->task_act ? 1 : 0);
+        if(thread_min == NULL || load < load_min) {
+            thread_min = thread_dsc;
+            load_min = load;
+        }
+    }
+
+    return thread_min;
+}
+
+/**
+ * Take the next task of a thread. If its queue is empty, steal the last queued task
+ * of the thread with the most queued tasks. Should be called under `task_queue_lock`.
+ * @param draw_sw_unit  pointer to the SW draw unit
+ * @param thread_dsc    the thread which takes the task
+ * @return              the taken task (also stored in `task_act`) or NULL if there are no queued tasks
+ */
+static lv_draw_task_t * take_task(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_sw_thread_dsc_t * thread_dsc)
+{
+    lv_draw_task_t * t = NULL;
+    if(thread_dsc->task_queue_cnt > 0) {
+        t = thread_dsc->task_queue[0];
+        thread_dsc->task_queue_cnt--;
+        lv_memmove(&thread_dsc->task_queue[0], &thread_dsc->task_queue[1],
+                   thread_dsc->task_queue_cnt * sizeof(lv_draw_task_t *));
+    }
+    else {
+        lv_draw_sw_thread_dsc_t * victim = NULL;
+        uint32_t i;
+        for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
+            lv_draw_sw_thread_dsc_t * other = &draw_sw_unit->thread_dscs[i];
+            if(other == thread_dsc || other->task_queue_cnt == 0) continue;
+            if(victim == NULL || other->task_queue_cnt > victim->task_queue_cnt) victim = other;
+        }
+
+        if(victim) {
+            victim->task_queue_cnt--;
+            t = victim->task_queue[victim->task_queue_cnt];
+        }
+    }
+
+    thread_dsc->task_act = t;
+    return t;
+}
+
+/**
+ * Check if there is a thread which neither renders nor has queued tasks.
+ * Should be called under `task_queue_lock`.
+ * @param draw_sw_unit  pointer to the SW draw unit
+ * @return              true: there is at least one idle thread
+ */
+static bool has_idle_thread(lv_draw_sw_unit_t * draw_sw_unit)
+{
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
+        lv_draw_sw_thread_dsc_t * thread_dsc = &draw_sw_unit->thread_dscs[i];
+        if(thread_dsc->task_act == NULL && thread_dsc->task_queue_cnt == 0) return true;
+    }
+
+    return false;
+}
+#endif
+
+#if LV_USE_OS && LV_DRAW_SW_DRAW_UNIT_CNT > 1
+/**
+ * Get in how many horizontal bands a task should be split.
+ * Only large fills and non-transformed images from variables are split
+ * as their descriptors don't own any resources and the bands can be drawn independently.
+ * @param t         the task to check
+ * @param idle_cnt  number of threads with nothing to do
+ * @return          number of bands, 1 if the task shouldn't be split
+ */
+static uint32_t get_band_cnt(lv_draw_task_t * t, uint32_t idle_cnt)
+{
+    if(idle_cnt < 2) return 1;
+
+#if LV_DRAW_TRANSFORM_USE_MATRIX
+    if(!lv_matrix_is_identity(&t->matrix)) return 1;
+#endif
+
+    if(t->type == LV_DRAW_TASK_TYPE_IMAGE) {
+        lv_draw_image_dsc_t * draw_dsc = t->draw_dsc;
+        if(lv_image_src_get_type(draw_dsc->src) != LV_IMAGE_SRC_VARIABLE) return 1;
+        /*Only plain pixel data can be used by the bands without decoding it once more*/
+        if(draw_dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED) return 1;
+        if(draw_dsc->header.cf == LV_COLOR_FORMAT_RAW || draw_dsc->header.cf == LV_COLOR_FORMAT_RAW_ALPHA) return 1;
+        if(LV_COLOR_FORMAT_IS_INDEXED(draw_dsc->header.cf)) return 1;
+        if(draw_dsc->tile || draw_dsc->bitmap_mask_src) return 1;
+        if(draw_dsc->rotation != 0 || draw_dsc->skew_x != 0 || draw_dsc->skew_y != 0) return 1;
+        if(draw_dsc->scale_x != LV_SCALE_NONE || draw_dsc->scale_y != LV_SCALE_NONE) return 1;
+    }
+    else if(t->type != LV_DRAW_TASK_TYPE_FILL) {
+        return 1;
+    }
+
+    lv_area_t draw_area;
+    if(!lv_area_intersect(&draw_area, &t->_real_area, &t->clip_area)) return 1;
+    if(lv_area_get_size(&draw_area) < LV_DRAW_SW_BAND_MIN_SIZE) return 1;
+
+    uint32_t band_cnt = lv_area_get_height(&draw_area) / LV_DRAW_SW_BAND_MIN_HEIGHT;
+    return LV_MIN(band_cnt, idle_cnt);
+}
+
+/**
+ * Split a task to equal height horizontal bands
+ * @param t         the task to split
+ * @param band_cnt  number of bands to create
+ */
+static void split_to_bands(lv_draw_task_t * t, uint32_t band_cnt)
+{
+    LV_PROFILER_DRAW_BEGIN;
+    lv_area_t draw_area;
+    lv_area_intersect(&draw_area, &t->_real_area, &t->clip_area);
+    int32_t band_h = lv_area_get_height(&draw_area) / band_cnt;
+
+    /*Split from the bottom so that `t` always keeps the remaining upper part*/
+    uint32_t i;
+    for(i = band_cnt - 1; i > 0; i--) {
+        if(lv_draw_task_split(t, draw_area.y1 + i * band_h) == NULL) break;
+    }
+    LV_PROFILER_DRAW_END;
+}
 #endif
 
 static void execute_drawing(lv_draw_task_t * t)
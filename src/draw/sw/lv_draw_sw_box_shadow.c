@@ -9,7 +9,7 @@
 #include "../../misc/lv_area_private.h"
 #include "lv_draw_sw_mask_private.h"
 #include "../lv_draw_private.h"
-#include "lv_draw_sw.h"
+#include "lv_draw_sw_private.h"
 #if LV_USE_DRAW_SW
 
 #if LV_DRAW_SW_COMPLEX
@@ -27,9 +27,10 @@
  *********************/
 #define SHADOW_UPSCALE_SHIFT    6
 #define SHADOW_ENHANCE          1
+#define SHADOW_BLUR_STRIP       16      /*Number of columns to blur vertically at once*/
 
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    #define shadow_cache LV_GLOBAL_DEFAULT()->sw_shadow_cache
+    #define shadow_cache_p (LV_GLOBAL_DEFAULT()->sw_shadow_cache)
 #endif
 
 /**********************
@@ -43,6 +44,14 @@ static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t *
                                                                int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf);
 
+#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    static lv_opa_t * shadow_cache_get_corner(const lv_area_t * coords, int32_t sw, int32_t r);
+    static bool shadow_cache_create_cb(lv_draw_sw_shadow_cache_data_t * node, void * user_data);
+    static void shadow_cache_free_cb(lv_draw_sw_shadow_cache_data_t * node, void * user_data);
+    static lv_cache_compare_res_t shadow_cache_compare_cb(const lv_draw_sw_shadow_cache_data_t * lhs,
+                                                          const lv_draw_sw_shadow_cache_data_t * rhs);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -99,26 +108,12 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
 
     lv_opa_t * sh_buf;
 
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
-    lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
-    if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_malloc(corner_size * corner_size);
-        LV_ASSERT_MALLOC(sh_buf);
-        lv_memcpy(sh_buf, cache->cache, corner_size * corner_size);
-    }
-    else {
-        /*A larger buffer is required for calculation*/
+#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    sh_buf = shadow_cache_get_corner(&core_area, dsc->width, r_sh);
+    if(sh_buf == NULL) {
         sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
         LV_ASSERT_MALLOC(sh_buf);
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(cache->cache)) {
-            lv_memcpy(cache->cache, sh_buf, corner_size * corner_size);
-            cache->cache_size = corner_size;
-            cache->cache_r = r_sh;
-        }
     }
 #else
     sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
@@ -559,6 +554,27 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
     lv_free(mask_buf);
 }
 
+#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+void lv_draw_sw_shadow_cache_init(uint32_t size)
+{
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)shadow_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)shadow_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)shadow_cache_free_cb,
+        .create_unlocked = true,    /*The corner is blurred in its own buffer*/
+    };
+
+    shadow_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(lv_draw_sw_shadow_cache_data_t), size, ops);
+    lv_cache_set_name(shadow_cache_p, "SW_SHADOW");
+}
+
+void lv_draw_sw_shadow_cache_deinit(void)
+{
+    lv_cache_destroy(shadow_cache_p, NULL);
+    shadow_cache_p = NULL;
+}
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -664,7 +680,7 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, u
     if((sw & 1) == 0) s_left--;
 
     /*Horizontal blur*/
-    uint16_t * sh_ups_blur_buf = lv_malloc(size * sizeof(uint16_t));
+    uint16_t * sh_ups_blur_buf = lv_malloc(size * SHADOW_BLUR_STRIP * sizeof(uint16_t));
 
     int32_t x;
     int32_t y;
@@ -695,41 +711,124 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, u
     uint32_t i;
     uint32_t max_v = LV_OPA_COVER << SHADOW_UPSCALE_SHIFT;
     uint32_t max_v_div = max_v / sw;
+    /*Divide by multiplying with the rounded up reciprocal. It's exact for 16 bit values.*/
+    uint64_t sw_recip = (((uint64_t)1 << 32) + sw - 1) / sw;
     for(i = 0; i < (uint32_t)size * size; i++) {
         if(sh_ups_buf[i] == 0) continue;
         else if(sh_ups_buf[i] == max_v) sh_ups_buf[i] = max_v_div;
-        else sh_ups_buf[i] = sh_ups_buf[i] / sw;
+        else sh_ups_buf[i] = (uint16_t)((sh_ups_buf[i] * sw_recip) >> 32);
     }
 
-    for(x = 0; x < size; x++) {
-        sh_ups_tmp_buf = &sh_ups_buf[x];
-        int32_t v = sh_ups_tmp_buf[0] * sw;
-        for(y = 0; y < size ; y++, sh_ups_tmp_buf += size) {
-            sh_ups_blur_buf[y] = v < 0 ? 0 : (v >> SHADOW_UPSCALE_SHIFT);
-
-            /*Forget the top pixel*/
-            uint32_t top_val;
-            if(y - s_right <= 0) top_val = sh_ups_tmp_buf[0];
-            else top_val = sh_ups_buf[(y - s_right) * size + x];
-            v -= top_val;
-
-            /*Add the bottom pixel*/
-            uint32_t bottom_val;
-            if(y + s_left + 1 < size) bottom_val = sh_ups_buf[(y + s_left + 1) * size + x];
-            else bottom_val = sh_ups_buf[(size - 1) * size + x];
-            v += bottom_val;
+    /*Blur a strip of columns at once to read the buffer row by row instead of jumping between the rows*/
+    int32_t v[SHADOW_BLUR_STRIP];
+    int32_t x_start;
+    for(x_start = 0; x_start < size; x_start += SHADOW_BLUR_STRIP) {
+        int32_t strip_w = LV_MIN(SHADOW_BLUR_STRIP, size - x_start);
+        uint16_t * col_buf = &sh_ups_buf[x_start];
+        for(x = 0; x < strip_w; x++) v[x] = col_buf[x] * sw;
+
+        sh_ups_tmp_buf = sh_ups_blur_buf;
+        for(y = 0; y < size; y++) {
+            /*Forget the top pixel and add the bottom pixel*/
+            const uint16_t * top_buf = &col_buf[(y - s_right <= 0 ? y : y - s_right) * size];
+            const uint16_t * bottom_buf = &col_buf[(y + s_left + 1 < size ? y + s_left + 1 : size - 1) * size];
+            for(x = 0; x < strip_w; x++) {
+                sh_ups_tmp_buf[x] = v[x] < 0 ? 0 : (v[x] >> SHADOW_UPSCALE_SHIFT);
+                v[x] += (int32_t)bottom_buf[x] - top_buf[x];
+            }
+            sh_ups_tmp_buf += strip_w;
         }
 
         /*Write back the result into `sh_ups_buf`*/
-        sh_ups_tmp_buf = &sh_ups_buf[x];
-        for(y = 0; y < size; y++, sh_ups_tmp_buf += size) {
-            (*sh_ups_tmp_buf) = sh_ups_blur_buf[y];
+        sh_ups_tmp_buf = sh_ups_blur_buf;
+        for(y = 0; y < size; y++) {
+            lv_memcpy(&col_buf[y * size], sh_ups_tmp_buf, strip_w * sizeof(uint16_t));
+            sh_ups_tmp_buf += strip_w;
         }
     }
 
     lv_free(sh_ups_blur_buf);
 }
 
+#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+/**
+ * Get a copy of a blurred corner from the cache. Blur and add it to the cache if it's not cached yet.
+ * @param coords    the area to blur
+ * @param sw        shadow width
+ * @param r         radius
+ * @return          a `(sw + r)^2` sized buffer to free with `lv_free`, or NULL if the corner is too large to cache
+ */
+static lv_opa_t * shadow_cache_get_corner(const lv_area_t * coords, int32_t sw, int32_t r)
+{
+    int32_t size = sw + r;
+    if(size > LV_DRAW_SW_SHADOW_CACHE_SIZE) return NULL;
+
+    /*Only the edges closer than the corner size affect the corner,
+     *so all the larger areas can share the same entry*/
+    lv_draw_sw_shadow_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.sw = sw;
+    search_key.r = r;
+    search_key.w = LV_MIN(lv_area_get_width(coords), 2 * size);
+    search_key.h = LV_MIN(lv_area_get_height(coords), 2 * size);
+    search_key.slot.size = size * size;
+
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(shadow_cache_p, &search_key, NULL);
+    if(entry == NULL) return NULL;
+
+    lv_draw_sw_shadow_cache_data_t * cached = lv_cache_entry_get_data(entry);
+    /*The caller modifies the buffer so return a copy. Allocate as much as for `shadow_draw_corner_buf()`
+     *because with tiny shadows the lines are read a little beyond the corner.*/
+    lv_opa_t * sh_buf = lv_malloc(size * size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(sh_buf);
+    if(sh_buf) lv_memcpy(sh_buf, cached->buf, size * size);
+    lv_cache_release(shadow_cache_p, entry, NULL);
+
+    return sh_buf;
+}
+
+static bool shadow_cache_create_cb(lv_draw_sw_shadow_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    int32_t size = node->sw + node->r;
+    uint16_t * sh_buf = lv_malloc(size * size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(sh_buf);
+    if(sh_buf == NULL) return false;
+
+    lv_area_t coords;
+    lv_area_set(&coords, 0, 0, node->w - 1, node->h - 1);
+    shadow_draw_corner_buf(&coords, sh_buf, node->sw, node->r);
+
+    /*The result is in the first `size * size` bytes*/
+    lv_opa_t * buf = lv_realloc(sh_buf, size * size);
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) {
+        lv_free(sh_buf);
+        return false;
+    }
+
+    node->buf = buf;
+    return true;
+}
+
+static void shadow_cache_free_cb(lv_draw_sw_shadow_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_free(node->buf);
+}
+
+static lv_cache_compare_res_t shadow_cache_compare_cb(const lv_draw_sw_shadow_cache_data_t * lhs,
+                                                      const lv_draw_sw_shadow_cache_data_t * rhs)
+{
+    if(lhs->sw != rhs->sw) return lhs->sw > rhs->sw ? 1 : -1;
+    if(lhs->r != rhs->r) return lhs->r > rhs->r ? 1 : -1;
+    if(lhs->w != rhs->w) return lhs->w > rhs->w ? 1 : -1;
+    if(lhs->h != rhs->h) return lhs->h > rhs->h ? 1 : -1;
+    return 0;
+}
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+
 #else /*LV_DRAW_SW_COMPLEX*/
 
 void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
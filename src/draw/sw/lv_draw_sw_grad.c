@@ -9,9 +9,11 @@
 #include "lv_draw_sw_grad.h"
 #if LV_USE_DRAW_SW
 
+#include "lv_draw_sw_private.h"
 #include "../../misc/lv_types.h"
 #include "../../osal/lv_os.h"
 #include "../../misc/lv_math.h"
+#include "../../core/lv_global.h"
 
 /*********************
  *      DEFINES
@@ -26,6 +28,10 @@
     #define ALIGN(X)    (((X) + 3) & ~3)
 #endif
 
+#if defined(LV_DRAW_SW_GRAD_CACHE_SIZE) && LV_DRAW_SW_GRAD_CACHE_SIZE > 0
+    #define grad_cache_p (LV_GLOBAL_DEFAULT()->sw_grad_cache)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -72,8 +78,17 @@ typedef struct {
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-typedef lv_result_t (*op_cache_t)(lv_draw_sw_grad_calc_t * c, void * ctx);
-static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h);
+static inline size_t get_item_size(int32_t size);
+static lv_draw_sw_grad_calc_t * allocate_item(int32_t size);
+static lv_draw_sw_grad_calc_t * get_maps(const lv_grad_dsc_t * g, int32_t size);
+static void fill_maps(const lv_grad_dsc_t * g, lv_draw_sw_grad_calc_t * item);
+
+#if defined(LV_DRAW_SW_GRAD_CACHE_SIZE) && LV_DRAW_SW_GRAD_CACHE_SIZE > 0
+    static bool grad_cache_create_cb(lv_draw_sw_grad_cache_data_t * node, void * user_data);
+    static void grad_cache_free_cb(lv_draw_sw_grad_cache_data_t * node, void * user_data);
+    static lv_cache_compare_res_t grad_cache_compare_cb(const lv_draw_sw_grad_cache_data_t * lhs,
+                                                        const lv_draw_sw_grad_cache_data_t * rhs);
+#endif
 
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
@@ -89,26 +104,14 @@ static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w
  *   STATIC FUNCTIONS
  **********************/
 
-static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h)
+static inline size_t get_item_size(int32_t size)
 {
-    int32_t size;
-    switch(g->dir) {
-        case LV_GRAD_DIR_HOR:
-        case LV_GRAD_DIR_LINEAR:
-        case LV_GRAD_DIR_RADIAL:
-        case LV_GRAD_DIR_CONICAL:
-            size = w;
-            break;
-        case LV_GRAD_DIR_VER:
-            size = h;
-            break;
-        default:
-            size = 64;
-    }
+    return ALIGN(sizeof(lv_draw_sw_grad_calc_t)) + ALIGN(size * sizeof(lv_color_t)) + ALIGN(size * sizeof(lv_opa_t));
+}
 
-    size_t req_size = ALIGN(sizeof(lv_draw_sw_grad_calc_t)) + ALIGN(size * sizeof(lv_color_t)) + ALIGN(size * sizeof(
-                                                                                                           lv_opa_t));
-    lv_draw_sw_grad_calc_t * item  = lv_malloc(req_size);
+static lv_draw_sw_grad_calc_t * allocate_item(int32_t size)
+{
+    lv_draw_sw_grad_calc_t * item  = lv_malloc(get_item_size(size));
     LV_ASSERT_MALLOC(item);
     if(item == NULL) return NULL;
 
@@ -116,9 +119,93 @@ static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w
     item->color_map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
     item->opa_map = (lv_opa_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_color_t)));
     item->size = size;
+    item->cache_entry = NULL;
+    return item;
+}
+
+static void fill_maps(const lv_grad_dsc_t * g, lv_draw_sw_grad_calc_t * item)
+{
+    uint32_t i;
+    for(i = 0; i < item->size; i++) {
+        lv_draw_sw_grad_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
+    }
+}
+
+/**
+ * Get the color and opacity maps of a gradient from the cache or calculate them.
+ * The maps depend only on the stops and the size, so the same maps serve all the widgets and
+ * draw tasks using the same gradient.
+ */
+static lv_draw_sw_grad_calc_t * get_maps(const lv_grad_dsc_t * g, int32_t size)
+{
+#if defined(LV_DRAW_SW_GRAD_CACHE_SIZE) && LV_DRAW_SW_GRAD_CACHE_SIZE > 0
+    lv_draw_sw_grad_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.slot.size = get_item_size(size);
+    search_key.stops_count = LV_MIN(g->stops_count, LV_GRADIENT_MAX_STOPS);
+    search_key.size = size;
+    lv_memcpy(search_key.stops, g->stops, search_key.stops_count * sizeof(lv_grad_stop_t));
+
+    /*Too large maps would just evict all the others*/
+    if(search_key.slot.size <= lv_cache_get_max_size(grad_cache_p, NULL)) {
+        lv_cache_entry_t * entry = lv_cache_acquire_or_create(grad_cache_p, &search_key, NULL);
+        if(entry) {
+            lv_draw_sw_grad_cache_data_t * cached = lv_cache_entry_get_data(entry);
+            return cached->grad;
+        }
+    }
+#endif
+
+    lv_draw_sw_grad_calc_t * item = allocate_item(size);
+    if(item == NULL) {
+        LV_LOG_WARN("Failed to allocate item for the gradient");
+        return NULL;
+    }
+
+    fill_maps(g, item);
     return item;
 }
 
+#if defined(LV_DRAW_SW_GRAD_CACHE_SIZE) && LV_DRAW_SW_GRAD_CACHE_SIZE > 0
+
+static bool grad_cache_create_cb(lv_draw_sw_grad_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_grad_dsc_t g;
+    lv_memzero(&g, sizeof(g));
+    lv_memcpy(g.stops, node->stops, sizeof(node->stops));
+    g.stops_count = node->stops_count;
+
+    node->grad = allocate_item(node->size);
+    if(node->grad == NULL) return false;
+
+    fill_maps(&g, node->grad);
+    node->grad->cache_entry = lv_cache_entry_get_entry(node, sizeof(lv_draw_sw_grad_cache_data_t));
+    return true;
+}
+
+static void grad_cache_free_cb(lv_draw_sw_grad_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_free(node->grad);
+    node->grad = NULL;
+}
+
+static lv_cache_compare_res_t grad_cache_compare_cb(const lv_draw_sw_grad_cache_data_t * lhs,
+                                                    const lv_draw_sw_grad_cache_data_t * rhs)
+{
+    if(lhs->size != rhs->size) return lhs->size > rhs->size ? 1 : -1;
+    if(lhs->stops_count != rhs->stops_count) return lhs->stops_count > rhs->stops_count ? 1 : -1;
+
+    int cmp_res = lv_memcmp(lhs->stops, rhs->stops, lhs->stops_count * sizeof(lv_grad_stop_t));
+    if(cmp_res != 0) return cmp_res > 0 ? 1 : -1;
+
+    return 0;
+}
+
+#endif /*LV_DRAW_SW_GRAD_CACHE_SIZE*/
+
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
 static inline int32_t extend_w(int32_t w, lv_grad_extend_t extend)
@@ -144,24 +231,48 @@ static inline int32_t extend_w(int32_t w, lv_grad_extend_t extend)
 
 lv_draw_sw_grad_calc_t * lv_draw_sw_grad_get(const lv_grad_dsc_t * g, int32_t w, int32_t h)
 {
-    /* No gradient, no cache */
-    if(g->dir == LV_GRAD_DIR_NONE) return NULL;
-
-    /* Step 1: Search cache for the given key */
-    lv_draw_sw_grad_calc_t * item = allocate_item(g, w, h);
-    if(item == NULL) {
-        LV_LOG_WARN("Failed to allocate item for the gradient");
-        return item;
+    switch(g->dir) {
+        case LV_GRAD_DIR_HOR:
+            return get_maps(g, w);
+        case LV_GRAD_DIR_VER:
+            return get_maps(g, h);
+        case LV_GRAD_DIR_LINEAR:
+        case LV_GRAD_DIR_RADIAL:
+        case LV_GRAD_DIR_CONICAL: {
+                /*The lines are calculated into this buffer from the 256 element maps of the setup*/
+                lv_draw_sw_grad_calc_t * item = allocate_item(w);
+                if(item == NULL) LV_LOG_WARN("Failed to allocate item for the gradient");
+                return item;
+            }
+        default:
+            /* No gradient, no maps */
+            return NULL;
     }
+}
 
-    /* Step 3: Fill it with the gradient, as expected */
-    uint32_t i;
-    for(i = 0; i < item->size; i++) {
-        lv_draw_sw_grad_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
-    }
-    return item;
+#if defined(LV_DRAW_SW_GRAD_CACHE_SIZE) && LV_DRAW_SW_GRAD_CACHE_SIZE > 0
+
+void lv_draw_sw_grad_cache_init(uint32_t size)
+{
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)grad_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)grad_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)grad_cache_free_cb,
+        .create_unlocked = true,    /*Only calculates the color map*/
+    };
+
+    grad_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(lv_draw_sw_grad_cache_data_t), size, ops);
+    lv_cache_set_name(grad_cache_p, "SW_GRAD");
 }
 
+void lv_draw_sw_grad_cache_deinit(void)
+{
+    lv_cache_destroy(grad_cache_p, NULL);
+    grad_cache_p = NULL;
+}
+
+#endif /*LV_DRAW_SW_GRAD_CACHE_SIZE*/
+
 void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_grad_color_calculate(const lv_grad_dsc_t * dsc, int32_t range,
                                                            int32_t frac, lv_color_t * color_out, lv_opa_t * opa_out)
 {
@@ -217,6 +328,13 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_grad_color_calculate(const lv_grad_dsc_t *
 
 void lv_draw_sw_grad_cleanup(lv_draw_sw_grad_calc_t * grad)
 {
+#if defined(LV_DRAW_SW_GRAD_CACHE_SIZE) && LV_DRAW_SW_GRAD_CACHE_SIZE > 0
+    if(grad->cache_entry) {
+        lv_cache_release(grad_cache_p, grad->cache_entry, NULL);
+        return;
+    }
+#endif
+
     lv_free(grad);
 }
 
@@ -295,7 +413,7 @@ void lv_draw_sw_grad_radial_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     LV_ASSERT(r_end != 0);
 
     /* Create gradient color map */
-    state->cgrad = lv_draw_sw_grad_get(dsc, 256, 0);
+    state->cgrad = get_maps(dsc, 256);
 
     state->x0 = start.x;
     state->y0 = start.y;
@@ -464,7 +582,7 @@ void lv_draw_sw_grad_linear_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     dsc->state = state;
 
     /* Create gradient color map */
-    state->cgrad = lv_draw_sw_grad_get(dsc, 256, 0);
+    state->cgrad = get_maps(dsc, 256);
 
     /* Convert from percentage coordinates */
     int32_t wdt = lv_area_get_width(coords);
@@ -492,7 +610,7 @@ void lv_draw_sw_grad_linear_cleanup(lv_grad_dsc_t * dsc)
     if(state == NULL)
         return;
     if(state->cgrad)
-        lv_free(state->cgrad);
+        lv_draw_sw_grad_cleanup(state->cgrad);
     lv_free(state);
 }
 
@@ -539,7 +657,7 @@ void lv_draw_sw_grad_conical_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords
     dsc->state = state;
 
     /* Create gradient color map */
-    state->cgrad = lv_draw_sw_grad_get(dsc, 256, 0);
+    state->cgrad = get_maps(dsc, 256);
 
     /* Convert from percentage coordinates */
     int32_t wdt = lv_area_get_width(coords);
@@ -564,7 +682,7 @@ void lv_draw_sw_grad_conical_cleanup(lv_grad_dsc_t * dsc)
     if(state == NULL)
         return;
     if(state->cgrad)
-        lv_free(state->cgrad);
+        lv_draw_sw_grad_cleanup(state->cgrad);
     lv_free(state);
 }
 
@@ -30,6 +30,7 @@ typedef struct {
     lv_color_t   *  color_map;
     lv_opa_t   *  opa_map;
     uint32_t size;
+    lv_cache_entry_t * cache_entry;     /**< The entry of the gradient cache holding the maps or `NULL`*/
 } lv_draw_sw_grad_calc_t;
 
 
@@ -49,11 +50,19 @@ typedef struct {
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_grad_color_calculate(const lv_grad_dsc_t * dsc, int32_t range,
                                                                  int32_t frac, lv_color_t * color_out, lv_opa_t * opa_out);
 
-/** Get a gradient cache from the given parameters */
+/**
+ * Get the color and opacity maps of a horizontal or vertical gradient.
+ * The maps are taken from the gradient cache if possible and must not be modified.
+ * For linear, radial and conical gradients only a buffer is allocated for the `lv_draw_sw_grad_..._get_line()` functions.
+ * @param gradient  the gradient descriptor
+ * @param w         width of the gradient
+ * @param h         height of the gradient
+ * @return          the gradient maps or `NULL` if there is no gradient or on error
+ */
 lv_draw_sw_grad_calc_t * lv_draw_sw_grad_get(const lv_grad_dsc_t * gradient, int32_t w, int32_t h);
 
 /**
- * Clean up the gradient item after it was get with `lv_grad_get_from_cache`.
+ * Clean up the gradient item after it was get with `lv_draw_sw_grad_get`.
  * @param grad      pointer to a gradient
  */
 void lv_draw_sw_grad_cleanup(lv_draw_sw_grad_calc_t * grad);
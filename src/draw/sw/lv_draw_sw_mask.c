@@ -21,10 +21,7 @@
 /*********************
  *      DEFINES
  *********************/
-#define CIRCLE_CACHE_LIFE_MAX           1000
-#define CIRCLE_CACHE_AGING(life, r)     life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
-#define circle_cache_mutex              LV_GLOBAL_DEFAULT()->draw_info.circle_cache_mutex
-#define _circle_cache                   LV_GLOBAL_DEFAULT()->sw_circle_cache
+#define circle_cache_p                  LV_GLOBAL_DEFAULT()->sw_circle_cache
 
 /**********************
  *      TYPEDEFS
@@ -65,6 +62,10 @@ static void circ_calc_aa4(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radiu
 static lv_opa_t * get_next_line(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t y, int32_t * len,
                                 int32_t * x_start);
 static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
+static bool circle_cache_create_cb(lv_draw_sw_mask_radius_circle_dsc_t * node, void * user_data);
+static void circle_cache_free_cb(lv_draw_sw_mask_radius_circle_dsc_t * node, void * user_data);
+static lv_cache_compare_res_t circle_cache_compare_cb(const lv_draw_sw_mask_radius_circle_dsc_t * lhs,
+                                                      const lv_draw_sw_mask_radius_circle_dsc_t * rhs);
 
 /**********************
  *  STATIC VARIABLES
@@ -80,12 +81,22 @@ static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, l
 
 void lv_draw_sw_mask_init(void)
 {
-    lv_mutex_init(&circle_cache_mutex);
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)circle_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)circle_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)circle_cache_free_cb,
+        .create_unlocked = true,    /*Only calculates the points of the circle*/
+    };
+
+    circle_cache_p = lv_cache_create(&lv_cache_class_lru_rb_count, sizeof(lv_draw_sw_mask_radius_circle_dsc_t),
+                                     LV_DRAW_SW_CIRCLE_CACHE_SIZE, ops);
+    lv_cache_set_name(circle_cache_p, "SW_CIRCLE");
 }
 
 void lv_draw_sw_mask_deinit(void)
 {
-    lv_mutex_delete(&circle_cache_mutex);
+    lv_cache_destroy(circle_cache_p, NULL);
+    circle_cache_p = NULL;
 }
 
 lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_apply(void * masks[], lv_opa_t * mask_buf, int32_t abs_x,
@@ -109,33 +120,19 @@ lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_apply(void * masks[]
 
 void lv_draw_sw_mask_free_param(void * p)
 {
-    lv_mutex_lock(&circle_cache_mutex);
     lv_draw_sw_mask_common_dsc_t * pdsc = p;
     if(pdsc->type == LV_DRAW_SW_MASK_TYPE_RADIUS) {
         lv_draw_sw_mask_radius_param_t * radius_p = (lv_draw_sw_mask_radius_param_t *) p;
         if(radius_p->circle) {
-            if(radius_p->circle->life < 0) {
-                lv_free(radius_p->circle->cir_opa);
-                lv_free(radius_p->circle);
+            if(radius_p->circle->cache_entry) {
+                lv_cache_release(circle_cache_p, radius_p->circle->cache_entry, NULL);
             }
             else {
-                radius_p->circle->used_cnt--;
+                lv_free(radius_p->circle->buf);
+                lv_free(radius_p->circle);
             }
         }
     }
-
-    lv_mutex_unlock(&circle_cache_mutex);
-}
-
-void lv_draw_sw_mask_cleanup(void)
-{
-    uint8_t i;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].buf) {
-            lv_free(_circle_cache[i].buf);
-        }
-        lv_memzero(&(_circle_cache[i]), sizeof(_circle_cache[i]));
-    }
 }
 
 void lv_draw_sw_mask_line_points_init(lv_draw_sw_mask_line_param_t * param, int32_t p1x, int32_t p1y,
@@ -311,47 +308,24 @@ void lv_draw_sw_mask_radius_init(lv_draw_sw_mask_radius_param_t * param, const l
         return;
     }
 
-    lv_mutex_lock(&circle_cache_mutex);
-
-    uint32_t i;
-
-    /*Try to reuse a circle cache entry*/
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].radius == radius) {
-            _circle_cache[i].used_cnt++;
-            CIRCLE_CACHE_AGING(_circle_cache[i].life, radius);
-            param->circle = &(_circle_cache[i]);
-            lv_mutex_unlock(&circle_cache_mutex);
-            return;
-        }
-    }
-
-    /*If not cached use the free entry with lowest life*/
-    lv_draw_sw_mask_radius_circle_dsc_t * entry = NULL;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].used_cnt == 0) {
-            if(!entry) entry = &(_circle_cache[i]);
-            else if(_circle_cache[i].life < entry->life) entry = &(_circle_cache[i]);
-        }
-    }
+    /*The circles are calculated outside of the cache's lock,
+     *so the draw threads wait for each other only while looking up the radius*/
+    lv_draw_sw_mask_radius_circle_dsc_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.radius = radius;
 
-    /*There is no unused entry. Allocate one temporarily*/
-    if(!entry) {
-        entry = lv_malloc_zeroed(sizeof(lv_draw_sw_mask_radius_circle_dsc_t));
-        LV_ASSERT_MALLOC(entry);
-        entry->life = -1;
-    }
-    else {
-        entry->used_cnt++;
-        entry->life = 0;
-        CIRCLE_CACHE_AGING(entry->life, radius);
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(circle_cache_p, &search_key, NULL);
+    if(entry) {
+        param->circle = lv_cache_entry_get_data(entry);
+        return;
     }
 
-    param->circle = entry;
+    /*All the entries are used by other masks. Allocate one temporarily*/
+    param->circle = lv_malloc_zeroed(sizeof(lv_draw_sw_mask_radius_circle_dsc_t));
+    LV_ASSERT_MALLOC(param->circle);
+    if(param->circle == NULL) return;
 
     circ_calc_aa4(param->circle, radius);
-    lv_mutex_unlock(&circle_cache_mutex);
-
 }
 
 void lv_draw_sw_mask_fade_init(lv_draw_sw_mask_fade_param_t * param, const lv_area_t * coords, lv_opa_t opa_top,
@@ -1234,4 +1208,29 @@ static inline lv_opa_t LV_ATTRIBUTE_FAST_MEM mask_mix(lv_opa_t mask_act, lv_opa_
     return LV_UDIV255(mask_act * mask_new);
 }
 
+static bool circle_cache_create_cb(lv_draw_sw_mask_radius_circle_dsc_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    circ_calc_aa4(node, node->radius);
+    if(node->buf == NULL) return false;
+
+    node->cache_entry = lv_cache_entry_get_entry(node, sizeof(lv_draw_sw_mask_radius_circle_dsc_t));
+    return true;
+}
+
+static void circle_cache_free_cb(lv_draw_sw_mask_radius_circle_dsc_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_free(node->buf);
+    node->buf = NULL;
+}
+
+static lv_cache_compare_res_t circle_cache_compare_cb(const lv_draw_sw_mask_radius_circle_dsc_t * lhs,
+                                                      const lv_draw_sw_mask_radius_circle_dsc_t * rhs)
+{
+    if(lhs->radius != rhs->radius) return lhs->radius > rhs->radius ? 1 : -1;
+    return 0;
+}
+
 #endif /*LV_DRAW_SW_COMPLEX*/
@@ -31,9 +31,8 @@ typedef struct  {
     lv_opa_t * cir_opa;         /**< Opacity of values on the circumference of an 1/4 circle */
     uint16_t * x_start_on_y;    /**< The x coordinate of the circle for each y value */
     uint16_t * opa_start_on_y;  /**< The index of `cir_opa` for each y value */
-    int32_t life;               /**< How many times the entry way used */
-    uint32_t used_cnt;          /**< Like a semaphore to count the referencing masks */
     int32_t radius;             /**< The radius of the entry */
+    lv_cache_entry_t * cache_entry; /**< The entry of the circle cache or `NULL` if allocated only for one mask */
 } lv_draw_sw_mask_radius_circle_dsc_t;
 
 struct _lv_draw_sw_mask_common_dsc_t {
@@ -132,18 +131,10 @@ struct _lv_draw_sw_mask_map_param_t {
     } cfg;
 };
 
-typedef lv_draw_sw_mask_radius_circle_dsc_t lv_draw_sw_mask_radius_circle_dsc_arr_t[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
-
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
-/**
- * Called by LVGL the rendering of a screen is ready to clean up
- * the temporal (cache) data of the masks
- */
-void lv_draw_sw_mask_cleanup(void);
-
 /**********************
  *      MACROS
  **********************/
@@ -16,6 +16,7 @@ extern "C" {
 
 #include "lv_draw_sw.h"
 #include "../lv_draw_private.h"
+#include "lv_draw_sw_grad.h"
 
 #if LV_USE_DRAW_SW
 
@@ -23,6 +24,21 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#ifndef LV_DRAW_SW_THREAD_QUEUE_SIZE
+/** Number of draw tasks which can be assigned to a render thread in advance*/
+#define LV_DRAW_SW_THREAD_QUEUE_SIZE 4
+#endif
+
+#ifndef LV_DRAW_SW_BAND_MIN_SIZE
+/** Fills and images smaller than this (in pixels) are not split to bands for parallel rendering*/
+#define LV_DRAW_SW_BAND_MIN_SIZE 10000
+#endif
+
+#ifndef LV_DRAW_SW_BAND_MIN_HEIGHT
+/** Minimal height of a band when a large fill or image is split for parallel rendering*/
+#define LV_DRAW_SW_BAND_MIN_HEIGHT 16
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,6 +49,11 @@ extern "C" {
 
 typedef struct {
     lv_draw_task_t * task_act;
+
+    /** Independent tasks assigned to this thread but not started yet. Other threads can steal them.*/
+    lv_draw_task_t * task_queue[LV_DRAW_SW_THREAD_QUEUE_SIZE];
+    uint32_t task_queue_cnt;
+
     lv_thread_t thread;
     lv_thread_sync_t sync;
     lv_draw_unit_t * draw_unit;
@@ -45,23 +66,69 @@ struct _lv_draw_sw_unit_t {
     lv_draw_unit_t base_unit;
 #if LV_USE_OS
     lv_draw_sw_thread_dsc_t thread_dscs[LV_DRAW_SW_DRAW_UNIT_CNT];
+    lv_mutex_t task_queue_lock;     /**< Protects `task_act` and the task queues of the threads*/
 #else
     lv_draw_task_t * task_act;
 #endif
 };
 
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+/**A blurred shadow corner in the shadow cache*/
 typedef struct {
-    uint8_t cache[LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE];
-    int32_t cache_size;
-    int32_t cache_r;
-} lv_draw_sw_shadow_cache_t;
+    lv_cache_slot_size_t slot;
+
+    int32_t sw;             /**< Shadow width*/
+    int32_t r;              /**< Clamped radius*/
+    int32_t w;              /**< Width of the blurred area, clamped as only the nearby edges affect the corner*/
+    int32_t h;              /**< Height of the blurred area, clamped like `w`*/
+
+    lv_opa_t * buf;         /**< `(sw + r)^2` opacity values*/
+} lv_draw_sw_shadow_cache_data_t;
+#endif
+
+#if defined(LV_DRAW_SW_GRAD_CACHE_SIZE) && LV_DRAW_SW_GRAD_CACHE_SIZE > 0
+/**A gradient color map in the gradient cache*/
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    lv_grad_stop_t stops[LV_GRADIENT_MAX_STOPS];    /**< Only the first `stops_count` are compared*/
+    uint8_t stops_count;
+    int32_t size;                                   /**< Number of colors in the map*/
+
+    lv_draw_sw_grad_calc_t * grad;
+} lv_draw_sw_grad_cache_data_t;
 #endif
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+/**
+ * Create the cache of the blurred shadow corners
+ * @param size      size of the cache in bytes
+ */
+void lv_draw_sw_shadow_cache_init(uint32_t size);
+
+/**
+ * Destroy the cache of the blurred shadow corners
+ */
+void lv_draw_sw_shadow_cache_deinit(void);
+#endif
+
+#if defined(LV_DRAW_SW_GRAD_CACHE_SIZE) && LV_DRAW_SW_GRAD_CACHE_SIZE > 0
+/**
+ * Create the cache of the gradient color maps
+ * @param size      size of the cache in bytes
+ */
+void lv_draw_sw_grad_cache_init(uint32_t size);
+
+/**
+ * Destroy the cache of the gradient color maps
+ */
+void lv_draw_sw_grad_cache_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -51,6 +51,12 @@ typedef struct {
 static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
                                      int32_t * yout);
 
+static inline bool /* LV_ATTRIBUTE_FAST_MEM */ color32_eq(lv_color32_t c1, lv_color32_t c2);
+
+static inline lv_color32_t /* LV_ATTRIBUTE_FAST_MEM */ color_mix32(lv_color32_t fg, lv_color32_t bg);
+
+static inline uint16_t /* LV_ATTRIBUTE_FAST_MEM */ color_16_16_mix(uint16_t c1, uint16_t c2, uint8_t mix);
+
 #if LV_DRAW_SW_SUPPORT_RGB888 || LV_DRAW_SW_SUPPORT_XRGB8888
 static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
@@ -320,10 +326,14 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
+    /*Step the source coordinates incrementally. The accumulators hold `step * x` exactly,
+     *so the sampled coordinates are the same as with `start + ((step * x) >> 8)`*/
+    int32_t xs_acc = 0;
+    int32_t ys_acc = 0;
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = 0; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -334,6 +344,16 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
             continue;
         }
 
+        /*Without anti-aliasing the inner pixels are just copied (nearest neighbor)*/
+        if(!aa && xs_int > 0 && xs_int < src_w - 1 && ys_int > 0 && ys_int < src_h - 1) {
+            const uint8_t * src_u8 = &src[ys_int * src_stride + xs_int * px_size];
+            dest_c32[x].red = src_u8[2];
+            dest_c32[x].green = src_u8[1];
+            dest_c32[x].blue = src_u8[0];
+            dest_c32[x].alpha = 0xff;
+            continue;
+        }
+
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
         int32_t xs_fract = xs_ups & 0xFF;
@@ -384,14 +404,14 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
             px_ver.blue = px_ver_u8[0];
             px_ver.alpha = 0xff;
 
-            if(!lv_color32_eq(dest_c32[x], px_ver)) {
+            if(!color32_eq(dest_c32[x], px_ver)) {
                 px_ver.alpha = ys_fract;
-                dest_c32[x] = lv_color_mix32(px_ver, dest_c32[x]);
+                dest_c32[x] = color_mix32(px_ver, dest_c32[x]);
             }
 
-            if(!lv_color32_eq(dest_c32[x], px_hor)) {
+            if(!color32_eq(dest_c32[x], px_hor)) {
                 px_hor.alpha = xs_fract;
-                dest_c32[x] = lv_color_mix32(px_hor, dest_c32[x]);
+                dest_c32[x] = color_mix32(px_hor, dest_c32[x]);
             }
         }
         /*Partially out of the image*/
@@ -420,10 +440,12 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
+    int32_t xs_acc = 0;
+    int32_t ys_acc = 0;
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = 0; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -434,6 +456,12 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
             continue;
         }
 
+        /*Without anti-aliasing the inner pixels are just copied (nearest neighbor)*/
+        if(!aa && xs_int > 0 && xs_int < src_w - 1 && ys_int > 0 && ys_int < src_h - 1) {
+            dest_c32[x] = *(const lv_color32_t *)(src + ys_int * src_stride + xs_int * 4);
+            continue;
+        }
+
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
         int32_t xs_fract = xs_ups & 0xFF;
@@ -474,19 +502,19 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
             if(px_ver.alpha == 0) {
                 dest_c32[x].alpha = (dest_c32[x].alpha * (0xFF - ys_fract)) >> 8;
             }
-            else if(!lv_color32_eq(dest_c32[x], px_ver)) {
+            else if(!color32_eq(dest_c32[x], px_ver)) {
                 if(dest_c32[x].alpha) dest_c32[x].alpha = ((px_ver.alpha * ys_fract) + (dest_c32[x].alpha * (0xFF - ys_fract))) >> 8;
                 px_ver.alpha = ys_fract;
-                dest_c32[x] = lv_color_mix32(px_ver, dest_c32[x]);
+                dest_c32[x] = color_mix32(px_ver, dest_c32[x]);
             }
 
             if(px_hor.alpha == 0) {
                 dest_c32[x].alpha = (dest_c32[x].alpha * (0xFF - xs_fract)) >> 8;
             }
-            else if(!lv_color32_eq(dest_c32[x], px_hor)) {
+            else if(!color32_eq(dest_c32[x], px_hor)) {
                 if(dest_c32[x].alpha) dest_c32[x].alpha = ((px_hor.alpha * xs_fract) + (dest_c32[x].alpha * (0xFF - xs_fract))) >> 8;
                 px_hor.alpha = xs_fract;
-                dest_c32[x] = lv_color_mix32(px_hor, dest_c32[x]);
+                dest_c32[x] = color_mix32(px_hor, dest_c32[x]);
             }
         }
         /*Partially out of the image*/
@@ -530,10 +558,12 @@ static void transform_argb8888_premultiplied(const uint8_t * src, int32_t src_w,
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
+    int32_t xs_acc = 0;
+    int32_t ys_acc = 0;
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = 0; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -544,6 +574,12 @@ static void transform_argb8888_premultiplied(const uint8_t * src, int32_t src_w,
             continue;
         }
 
+        /*Without anti-aliasing the inner pixels are just copied (nearest neighbor)*/
+        if(!aa && xs_int > 0 && xs_int < src_w - 1 && ys_int > 0 && ys_int < src_h - 1) {
+            dest_c32[x] = *(const lv_color32_t *)(src + ys_int * src_stride + xs_int * 4);
+            continue;
+        }
+
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
         int32_t xs_fract = xs_ups & 0xFF;
@@ -591,19 +627,19 @@ static void transform_argb8888_premultiplied(const uint8_t * src, int32_t src_w,
                 dest_c32[x].alpha = (dest_c32[x].alpha * (0xFF - ys_fract)) >> 8;
 
             }
-            else if(!lv_color32_eq(dest_c32[x], px_ver)) {
+            else if(!color32_eq(dest_c32[x], px_ver)) {
                 if(dest_c32[x].alpha) dest_c32[x].alpha = ((px_ver.alpha * ys_fract) + (dest_c32[x].alpha * (0xFF - ys_fract))) >> 8;
                 px_ver.alpha = ys_fract;
-                dest_c32[x] = lv_color_mix32(px_ver, dest_c32[x]);
+                dest_c32[x] = color_mix32(px_ver, dest_c32[x]);
             }
 
             if(px_hor.alpha == 0) {
                 dest_c32[x].alpha = (dest_c32[x].alpha * (0xFF - xs_fract)) >> 8;
             }
-            else if(!lv_color32_eq(dest_c32[x], px_hor)) {
+            else if(!color32_eq(dest_c32[x], px_hor)) {
                 if(dest_c32[x].alpha) dest_c32[x].alpha = ((px_hor.alpha * xs_fract) + (dest_c32[x].alpha * (0xFF - xs_fract))) >> 8;
                 px_hor.alpha = xs_fract;
-                dest_c32[x] = lv_color_mix32(px_hor, dest_c32[x]);
+                dest_c32[x] = color_mix32(px_hor, dest_c32[x]);
             }
 
             dest_c32[x].red = (dest_c32[x].red * dest_c32[x].alpha) >> 8;
@@ -649,10 +685,12 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
     /*Must be signed type, because we would use negative array index calculated from stride*/
     int32_t alpha_stride = src_stride / 2; /*alpha map stride is always half of RGB map stride*/
 
+    int32_t xs_acc = 0;
+    int32_t ys_acc = 0;
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = 0; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -663,6 +701,14 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
             continue;
         }
 
+        /*Without anti-aliasing the inner pixels are just copied (nearest neighbor)*/
+        if(!aa && xs_int > 0 && xs_int < src_w - 1 && ys_int > 0 && ys_int < src_h - 1) {
+            const uint16_t * src_u16 = (const uint16_t *)(src + (ys_int * src_stride) + xs_int * 2);
+            cbuf[x] = src_u16[0];
+            abuf[x] = src_has_a8 ? src_alpha[(ys_int * alpha_stride) + xs_int] : 0xff;
+            continue;
+        }
+
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
         int32_t xs_fract = xs_ups & 0xFF;
@@ -718,9 +764,9 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
             }
 
             if(cbuf[x] != px_ver || cbuf[x] != px_hor) {
-                uint16_t v = lv_color_16_16_mix(px_ver, cbuf[x], ys_fract);
-                uint16_t h = lv_color_16_16_mix(px_hor, cbuf[x], xs_fract);
-                cbuf[x] = lv_color_16_16_mix(h, v, LV_OPA_50);
+                uint16_t v = color_16_16_mix(px_ver, cbuf[x], ys_fract);
+                uint16_t h = color_16_16_mix(px_hor, cbuf[x], xs_fract);
+                cbuf[x] = color_16_16_mix(h, v, LV_OPA_50);
             }
         }
         /*Partially out of the image*/
@@ -764,10 +810,12 @@ static void transform_rgb565a8_swapped(const uint8_t * src, int32_t src_w, int32
     /*Must be signed type, because we would use negative array index calculated from stride*/
     int32_t alpha_stride = src_stride / 2; /*alpha map stride is always half of RGB map stride*/
 
+    int32_t xs_acc = 0;
+    int32_t ys_acc = 0;
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = 0; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -778,6 +826,14 @@ static void transform_rgb565a8_swapped(const uint8_t * src, int32_t src_w, int32
             continue;
         }
 
+        /*Without anti-aliasing the inner pixels are just copied (nearest neighbor)*/
+        if(!aa && xs_int > 0 && xs_int < src_w - 1 && ys_int > 0 && ys_int < src_h - 1) {
+            const uint16_t * src_u16 = (const uint16_t *)(src + (ys_int * src_stride) + xs_int * 2);
+            cbuf[x] = lv_color_swap_16(src_u16[0]);
+            abuf[x] = src_has_a8 ? src_alpha[(ys_int * alpha_stride) + xs_int] : 0xff;
+            continue;
+        }
+
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
         int32_t xs_fract = xs_ups & 0xFF;
@@ -834,9 +890,9 @@ static void transform_rgb565a8_swapped(const uint8_t * src, int32_t src_w, int32
             }
 
             if(cbuf[x] != px_ver || cbuf[x] != px_hor) {
-                uint16_t v = lv_color_16_16_mix(px_ver, cbuf[x], ys_fract);
-                uint16_t h = lv_color_16_16_mix(px_hor, cbuf[x], xs_fract);
-                cbuf[x] =  lv_color_16_16_mix(h, v, LV_OPA_50);
+                uint16_t v = color_16_16_mix(px_ver, cbuf[x], ys_fract);
+                uint16_t h = color_16_16_mix(px_hor, cbuf[x], xs_fract);
+                cbuf[x] =  color_16_16_mix(h, v, LV_OPA_50);
             }
         }
         /*Partially out of the image*/
@@ -875,10 +931,12 @@ static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int3
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
 
+    int32_t xs_acc = 0;
+    int32_t ys_acc = 0;
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = 0; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -889,6 +947,12 @@ static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int3
             continue;
         }
 
+        /*Without anti-aliasing the inner pixels are just copied (nearest neighbor)*/
+        if(!aa && xs_int > 0 && xs_int < src_w - 1 && ys_int > 0 && ys_int < src_h - 1) {
+            abuf[x] = src[ys_int * src_stride + xs_int];
+            continue;
+        }
+
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
         int32_t xs_fract = xs_ups & 0xFF;
@@ -954,10 +1018,12 @@ static void transform_l8_to_al88(const uint8_t * src, int32_t src_w, int32_t src
     int32_t ys_ups_start = ys_ups;
     lv_color16a_t * dest_al88 = (lv_color16a_t *)dest_buf;
 
+    int32_t xs_acc = 0;
+    int32_t ys_acc = 0;
     int32_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    for(x = 0; x < x_end; x++, xs_acc += xs_step, ys_acc += ys_step) {
+        xs_ups = xs_ups_start + (xs_acc >> 8);
+        ys_ups = ys_ups_start + (ys_acc >> 8);
 
         int32_t xs_int = xs_ups >> 8;
         int32_t ys_int = ys_ups >> 8;
@@ -969,6 +1035,13 @@ static void transform_l8_to_al88(const uint8_t * src, int32_t src_w, int32_t src
             continue;
         }
 
+        /*Without anti-aliasing the inner pixels are just copied (nearest neighbor)*/
+        if(!aa && xs_int > 0 && xs_int < src_w - 1 && ys_int > 0 && ys_int < src_h - 1) {
+            dest_al88[x].lumi = src[ys_int * src_stride + xs_int];
+            dest_al88[x].alpha = 0xff;
+            continue;
+        }
+
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
         int32_t xs_fract = xs_ups & 0xFF;
@@ -1050,4 +1123,48 @@ static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int
     }
 }
 
+/**
+ * Same as `lv_color32_eq()` but inlined as it's called for every pixel
+ */
+static inline bool LV_ATTRIBUTE_FAST_MEM color32_eq(lv_color32_t c1, lv_color32_t c2)
+{
+    return *((uint32_t *)&c1) == *((uint32_t *)&c2);
+}
+
+/**
+ * Same as `lv_color_mix32()` but inlined as it's called for every pixel
+ */
+static inline lv_color32_t LV_ATTRIBUTE_FAST_MEM color_mix32(lv_color32_t fg, lv_color32_t bg)
+{
+    if(fg.alpha >= LV_OPA_MAX) {
+        fg.alpha = bg.alpha;
+        return fg;
+    }
+    if(fg.alpha <= LV_OPA_MIN) {
+        return bg;
+    }
+    bg.red = LV_UDIV255((uint32_t)((uint32_t)fg.red * fg.alpha + (uint32_t)bg.red * (255 - fg.alpha)));
+    bg.green = LV_UDIV255((uint32_t)((uint32_t)fg.green * fg.alpha + (uint32_t)bg.green * (255 - fg.alpha)));
+    bg.blue = LV_UDIV255((uint32_t)((uint32_t)fg.blue * fg.alpha + (uint32_t)bg.blue * (255 - fg.alpha)));
+    return bg;
+}
+
+/**
+ * Same as `lv_color_16_16_mix()` but inlined as it's called for every pixel
+ */
+static inline uint16_t LV_ATTRIBUTE_FAST_MEM color_16_16_mix(uint16_t c1, uint16_t c2, uint8_t mix)
+{
+    if(mix == 255) return c1;
+    if(mix == 0) return c2;
+    if(c1 == c2) return c1;
+
+    mix = (uint32_t)((uint32_t)mix + 4) >> 3;
+
+    /*0x7E0F81F = 0b00000111111000001111100000011111*/
+    uint32_t bg = (uint32_t)(c2 | ((uint32_t)c2 << 16)) & 0x7E0F81F;
+    uint32_t fg = (uint32_t)(c1 | ((uint32_t)c1 << 16)) & 0x7E0F81F;
+    uint32_t result = ((((fg - bg) * mix) >> 5) + bg) & 0x7E0F81F;
+    return (uint16_t)(result >> 16) | result;
+}
+
 #endif /*LV_USE_DRAW_SW*/
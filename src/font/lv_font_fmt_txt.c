@@ -13,6 +13,9 @@
 #include "../misc/lv_types.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
+#include "../misc/lv_array.h"
+#include "../misc/lv_iter.h"
+#include "../misc/cache/lv_cache.h"
 #include "../stdlib/lv_mem.h"
 
 /*********************
@@ -22,6 +25,11 @@
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    #define glyph_cache LV_GLOBAL_DEFAULT()->font_fmt_txt_glyph_cache
+    #define GLYPH_CACHE_NAME "FONT_FMT_TXT_GLYPH"
+#endif /*LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -38,9 +46,21 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
 static int unicode_list_compare(const void * ref, const void * element);
 static int kern_pair_8_compare(const void * ref, const void * element);
 static int kern_pair_16_compare(const void * ref, const void * element);
+static bool decode_glyph(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                         uint16_t stride_in, uint8_t * bitmap_out, uint32_t stride_out);
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    static bool glyph_cache_read(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint16_t stride_in,
+                                 uint8_t * bitmap_out, uint32_t stride_out);
+    static lv_cache_compare_res_t glyph_cache_compare_cb(const lv_font_fmt_txt_glyph_cache_data_t * lhs,
+                                                         const lv_font_fmt_txt_glyph_cache_data_t * rhs);
+    static bool glyph_cache_create_cb(lv_font_fmt_txt_glyph_cache_data_t * data, void * user_data);
+    static void glyph_cache_free_cb(lv_font_fmt_txt_glyph_cache_data_t * data, void * user_data);
+#endif /*LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE*/
 
 #if LV_USE_FONT_COMPRESSED
-    static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint8_t bpp, bool prefilter);
+    static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint32_t stride, uint8_t bpp,
+                           bool prefilter);
     static inline void decompress_line(uint8_t * out, int32_t w);
     static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len);
     static inline void rle_init(const uint8_t * in,  uint8_t bpp);
@@ -99,18 +119,191 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 
     if(g_dsc->req_raw_bitmap) return &fdsc->glyph_bitmap[gdsc->bitmap_index];
 
-    uint8_t * bitmap_out = draw_buf->data;
     int32_t gsize = (int32_t) gdsc->box_w * gdsc->box_h;
     if(gsize == 0) return NULL;
 
-    uint16_t stride_in = g_dsc->stride;
+    uint32_t stride_out = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8);
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    /*Plain 8 bpp bitmaps are only copied, so it's not faster to copy them from the cache*/
+    if(fdsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN || fdsc->bpp != 8) {
+        if(glyph_cache_read(fdsc, gid, g_dsc->stride, draw_buf->data, stride_out)) {
+            lv_draw_buf_flush_cache(draw_buf, NULL);
+            return draw_buf;
+        }
+    }
+#endif
+
+    if(!decode_glyph(fdsc, gdsc, g_dsc->stride, draw_buf->data, stride_out)) return NULL;
+
+    lv_draw_buf_flush_cache(draw_buf, NULL);
+    return draw_buf;
+}
+
+bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
+                                   uint32_t unicode_letter_next)
+{
+    /*It fixes a strange compiler optimization issue: https://github.com/lvgl/lvgl/issues/4370*/
+    bool is_tab = unicode_letter == '\t';
+    if(is_tab) {
+        unicode_letter = ' ';
+    }
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
+    if(!gid) return false;
+
+    int8_t kvalue = 0;
+    if(fdsc->kern_dsc) {
+        uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
+        if(gid_next) {
+            kvalue = get_kern_value(font, gid, gid_next);
+        }
+    }
+
+    /*Put together a glyph dsc*/
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+
+    int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
+
+    uint32_t adv_w = gdsc->adv_w;
+    if(is_tab) adv_w *= 2;
+
+    adv_w += kv;
+    adv_w  = (adv_w + (1 << 3)) >> 4;
+
+    dsc_out->adv_w = adv_w;
+    dsc_out->box_h = gdsc->box_h;
+    dsc_out->box_w = gdsc->box_w;
+    dsc_out->ofs_x = gdsc->ofs_x;
+    dsc_out->ofs_y = gdsc->ofs_y;
+
+    if(fdsc->stride == 0) dsc_out->stride = 0;
+    else {
+        /*e.g. font_dsc stride ==  4 means align to 4 byte boundary.
+         *In glyph_dsc store the actual line length in bytes*/
+        dsc_out->stride = LV_ROUND_UP(dsc_out->box_w, fdsc->stride);
+    }
+
+    dsc_out->format = (uint8_t)fdsc->bpp;
+    dsc_out->is_placeholder = false;
+    dsc_out->gid.index = gid;
+
+    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
+
+    return true;
+}
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
 
+void lv_font_fmt_txt_glyph_cache_init(uint32_t size)
+{
+    if(glyph_cache.cache != NULL) return;
+
+    glyph_cache.cache = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(lv_font_fmt_txt_glyph_cache_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) glyph_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) glyph_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) glyph_cache_free_cb,
+    });
+
+    if(glyph_cache.cache == NULL) {
+        LV_LOG_WARN("Couldn't create the glyph bitmap cache");
+        return;
+    }
+
+    lv_cache_set_name(glyph_cache.cache, GLYPH_CACHE_NAME);
+}
+
+void lv_font_fmt_txt_glyph_cache_deinit(void)
+{
+    if(glyph_cache.cache == NULL) return;
+
+    lv_cache_destroy(glyph_cache.cache, NULL);
+    glyph_cache.cache = NULL;
+}
+
+void lv_font_fmt_txt_glyph_cache_drop(const lv_font_t * font)
+{
+    if(glyph_cache.cache == NULL) return;
+
+    if(font == NULL) {
+        lv_cache_drop_all(glyph_cache.cache, NULL);
+        return;
+    }
+
+    /*The cache can't be modified while iterating, so collect the keys first*/
+    lv_iter_t * iter = lv_cache_iter_create(glyph_cache.cache);
+    if(iter == NULL) return;
+
+    void * elem = lv_malloc(lv_cache_entry_get_size(glyph_cache.cache->node_size));
+    LV_ASSERT_MALLOC(elem);
+    if(elem == NULL) {
+        lv_iter_destroy(iter);
+        return;
+    }
+
+    lv_array_t keys;
+    lv_array_init(&keys, 8, sizeof(lv_font_fmt_txt_glyph_cache_data_t));
+    while(lv_iter_next(iter, elem) == LV_RESULT_OK) {
+        lv_font_fmt_txt_glyph_cache_data_t * data = elem;
+        if(data->fdsc == font->dsc) lv_array_push_back(&keys, data);
+    }
+
+    lv_free(elem);
+    lv_iter_destroy(iter);
+
+    uint32_t i;
+    for(i = 0; i < lv_array_size(&keys); i++) {
+        lv_cache_drop(glyph_cache.cache, lv_array_at(&keys, i), NULL);
+    }
+
+    lv_array_deinit(&keys);
+}
+
+void lv_font_fmt_txt_glyph_cache_resize(uint32_t new_size)
+{
+    if(glyph_cache.cache == NULL) return;
+
+    lv_cache_set_max_size(glyph_cache.cache, new_size, NULL);
+    lv_cache_reserve(glyph_cache.cache, new_size, NULL);
+}
+
+void lv_font_fmt_txt_glyph_cache_get_stats(lv_font_fmt_txt_glyph_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    lv_memzero(stats, sizeof(lv_font_fmt_txt_glyph_cache_stats_t));
+    if(glyph_cache.cache == NULL) return;
+
+    /*Counted by the cache under its lock, so the draw units can update them in parallel*/
+    stats->hit_cnt = lv_cache_get_hit_count(glyph_cache.cache);
+    stats->miss_cnt = lv_cache_get_miss_count(glyph_cache.cache);
+    stats->size = (uint32_t)lv_cache_get_size(glyph_cache.cache, NULL);
+    stats->max_size = (uint32_t)lv_cache_get_max_size(glyph_cache.cache, NULL);
+}
+
+#endif /*LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Convert the bitmap of a glyph to A8 format
+ * @param fdsc          the font descriptor
+ * @param gdsc          the glyph descriptor
+ * @param stride_in     line length of the source bitmap in bytes or 0 if there is no padding
+ * @param bitmap_out    store the A8 bitmap here
+ * @param stride_out    line length of `bitmap_out` in bytes
+ * @return              true: the bitmap is decoded; false: the format of the font is not supported
+ */
+static bool decode_glyph(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                         uint16_t stride_in, uint8_t * bitmap_out, uint32_t stride_out)
+{
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
         const uint8_t * bitmap_in = &fdsc->glyph_bitmap[gdsc->bitmap_index];
         uint8_t * bitmap_out_tmp = bitmap_out;
         int32_t i = 0;
         int32_t x, y;
-        uint32_t stride_out = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8);
         if(fdsc->bpp == 1) {
             for(y = 0; y < gdsc->box_h; y ++) {
                 uint16_t line_rem = stride_in != 0 ? stride_in : gdsc->box_w;
@@ -197,84 +390,22 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
             }
         }
 
-        lv_draw_buf_flush_cache(draw_buf, NULL);
-        return draw_buf;
+        return true;
     }
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h,
+        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h, stride_out,
                    (uint8_t)fdsc->bpp, prefilter);
-        lv_draw_buf_flush_cache(draw_buf, NULL);
-        return draw_buf;
+        return true;
 #else /*!LV_USE_FONT_COMPRESSED*/
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
-        return NULL;
+        return false;
 #endif
     }
-
-    /*If not returned earlier then the letter is not found in this font*/
-    return NULL;
 }
 
-bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
-                                   uint32_t unicode_letter_next)
-{
-    /*It fixes a strange compiler optimization issue: https://github.com/lvgl/lvgl/issues/4370*/
-    bool is_tab = unicode_letter == '\t';
-    if(is_tab) {
-        unicode_letter = ' ';
-    }
-    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
-    uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
-    if(!gid) return false;
-
-    int8_t kvalue = 0;
-    if(fdsc->kern_dsc) {
-        uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
-        if(gid_next) {
-            kvalue = get_kern_value(font, gid, gid_next);
-        }
-    }
-
-    /*Put together a glyph dsc*/
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
-
-    int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
-
-    uint32_t adv_w = gdsc->adv_w;
-    if(is_tab) adv_w *= 2;
-
-    adv_w += kv;
-    adv_w  = (adv_w + (1 << 3)) >> 4;
-
-    dsc_out->adv_w = adv_w;
-    dsc_out->box_h = gdsc->box_h;
-    dsc_out->box_w = gdsc->box_w;
-    dsc_out->ofs_x = gdsc->ofs_x;
-    dsc_out->ofs_y = gdsc->ofs_y;
-
-    if(fdsc->stride == 0) dsc_out->stride = 0;
-    else {
-        /*e.g. font_dsc stride ==  4 means align to 4 byte boundary.
-         *In glyph_dsc store the actual line length in bytes*/
-        dsc_out->stride = LV_ROUND_UP(dsc_out->box_w, fdsc->stride);
-    }
-
-    dsc_out->format = (uint8_t)fdsc->bpp;
-    dsc_out->is_placeholder = false;
-    dsc_out->gid.index = gid;
-
-    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
-
-    return true;
-}
-
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
     if(letter == '\0') return 0;
@@ -410,11 +541,14 @@ static int kern_pair_16_compare(const void * ref, const void * element)
  * The compress a glyph's bitmap
  * @param in the compressed bitmap
  * @param out buffer to store the result
- * @param px_num number of pixels in the glyph (width * height)
+ * @param w width of the glyph
+ * @param h height of the glyph
+ * @param stride line length of `out` in bytes
  * @param bpp bit per pixel (bpp = 3 will be converted to bpp = 4)
  * @param prefilter true: the lines are XORed
  */
-static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint8_t bpp, bool prefilter)
+static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint32_t stride, uint8_t bpp,
+                       bool prefilter)
 {
     const lv_opa_t * opa_table;
     switch(bpp) {
@@ -446,7 +580,6 @@ static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h,
 
     int32_t y;
     int32_t x;
-    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_A8);
 
     for(x = 0; x < w; x++) {
         out[x] = opa_table[line_buf1[x]];
@@ -619,6 +752,103 @@ static int unicode_list_compare(const void * ref, const void * element)
     return (*(uint16_t *)ref) - (*(uint16_t *)element);
 }
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+
+/**
+ * Copy the decoded bitmap of a glyph from the cache. Decode and add it to the cache if it's not cached yet.
+ * @param fdsc          descriptor of the font
+ * @param gid           the glyph id
+ * @param stride_in     line length of the source bitmap in bytes or 0 if there is no padding
+ * @param bitmap_out    copy the A8 bitmap here
+ * @param stride_out    line length of `bitmap_out` in bytes
+ * @return              true: the bitmap is copied; false: the glyph can't be cached
+ */
+static bool glyph_cache_read(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint16_t stride_in,
+                             uint8_t * bitmap_out, uint32_t stride_out)
+{
+    lv_cache_t * cache = glyph_cache.cache;
+    if(cache == NULL || !lv_cache_is_enabled(cache)) return false;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    /*Store the bitmaps without padding to fit more glyphs into the cache*/
+    uint32_t size = (uint32_t)gdsc->box_w * gdsc->box_h;
+    if(size > lv_cache_get_max_size(cache, NULL)) return false;
+
+    lv_font_fmt_txt_glyph_cache_data_t search_key = {
+        .slot.size = size,
+        .fdsc = fdsc,
+        .gid = gid,
+        .stride = stride_in,
+        .bpp = (uint8_t)fdsc->bpp,
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(cache, &search_key, NULL);
+    if(entry == NULL) return false;
+
+    lv_font_fmt_txt_glyph_cache_data_t * data = lv_cache_entry_get_data(entry);
+    if(stride_out == gdsc->box_w) {
+        lv_memcpy(bitmap_out, data->bitmap, size);
+    }
+    else {
+        const uint8_t * bitmap_in = data->bitmap;
+        int32_t y;
+        for(y = 0; y < gdsc->box_h; y++) {
+            lv_memcpy(bitmap_out, bitmap_in, gdsc->box_w);
+            bitmap_out += stride_out;
+            bitmap_in += gdsc->box_w;
+        }
+    }
+    lv_cache_release(cache, entry, NULL);
+
+    return true;
+}
+
+static lv_cache_compare_res_t glyph_cache_compare_cb(const lv_font_fmt_txt_glyph_cache_data_t * lhs,
+                                                     const lv_font_fmt_txt_glyph_cache_data_t * rhs)
+{
+    if(lhs->fdsc != rhs->fdsc) {
+        return lhs->fdsc > rhs->fdsc ? 1 : -1;
+    }
+    if(lhs->gid != rhs->gid) {
+        return lhs->gid > rhs->gid ? 1 : -1;
+    }
+    if(lhs->bpp != rhs->bpp) {
+        return lhs->bpp > rhs->bpp ? 1 : -1;
+    }
+    if(lhs->stride != rhs->stride) {
+        return lhs->stride > rhs->stride ? 1 : -1;
+    }
+    return 0;
+}
+
+static bool glyph_cache_create_cb(lv_font_fmt_txt_glyph_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    data->bitmap = lv_malloc(data->slot.size);
+    LV_ASSERT_MALLOC(data->bitmap);
+    if(data->bitmap == NULL) return false;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &data->fdsc->glyph_dsc[data->gid];
+    if(!decode_glyph(data->fdsc, gdsc, data->stride, data->bitmap, gdsc->box_w)) {
+        lv_free(data->bitmap);
+        data->bitmap = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+static void glyph_cache_free_cb(lv_font_fmt_txt_glyph_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(data->bitmap);
+    data->bitmap = NULL;
+}
+
+#endif /*LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE*/
+
 static lv_font_t * builtin_font_create_cb(const lv_font_info_t * info, const void * src)
 {
     const lv_builtin_font_src_t * font_src = src;
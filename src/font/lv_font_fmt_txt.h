@@ -200,6 +200,16 @@ typedef struct {
 
 LV_ATTRIBUTE_EXTERN_DATA extern const lv_font_class_t lv_builtin_font_class;
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+/** Statistics of the cache of the decoded glyph bitmaps*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of glyphs found in the cache since it was created*/
+    uint32_t miss_cnt;      /**< Number of glyphs which were decoded and added to the cache since it was created*/
+    uint32_t size;          /**< Current size of the cached bitmaps in bytes*/
+    uint32_t max_size;      /**< Size limit of the cache in bytes*/
+} lv_font_fmt_txt_glyph_cache_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -224,6 +234,26 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+/**
+ * Drop the cached glyph bitmaps of a font. Needs to be called before a font is freed.
+ * @param font      pointer to a font or NULL to drop all glyphs
+ */
+void lv_font_fmt_txt_glyph_cache_drop(const lv_font_t * font);
+
+/**
+ * Change the size of the glyph bitmap cache. Glyphs are evicted immediately if the cache is shrunk.
+ * @param new_size  the new size in bytes. 0 disables caching.
+ */
+void lv_font_fmt_txt_glyph_cache_resize(uint32_t new_size);
+
+/**
+ * Get the statistics of the glyph bitmap cache
+ * @param stats     store the result here
+ */
+void lv_font_fmt_txt_glyph_cache_get_stats(lv_font_fmt_txt_glyph_cache_stats_t * stats);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_font_fmt_txt.h"
+#include "../misc/cache/lv_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -41,10 +42,40 @@ typedef struct {
 } lv_font_fmt_rle_t;
 #endif
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    uint32_t gid;
+    uint16_t stride;        /**< Stride of the source bitmap*/
+    uint8_t bpp;
+
+    uint8_t * bitmap;       /**< The decoded A8 bitmap*/
+} lv_font_fmt_txt_glyph_cache_data_t;
+
+typedef struct {
+    lv_cache_t * cache;
+} lv_font_fmt_txt_glyph_cache_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+/**
+ * Create the cache of the decoded glyph bitmaps
+ * @param size      size of the cache in bytes
+ */
+void lv_font_fmt_txt_glyph_cache_init(uint32_t size);
+
+/**
+ * Destroy the cache of the decoded glyph bitmaps
+ */
+void lv_font_fmt_txt_glyph_cache_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -7,8 +7,9 @@
  *      INCLUDES
  *********************/
 #include "lv_flex.h"
-#include "../lv_layout.h"
+#include "../lv_layout_private.h"
 #include "../../core/lv_obj_private.h"
+#include "../../misc/lv_area_private.h"
 
 #if LV_USE_FLEX
 
@@ -17,6 +18,11 @@
  *      DEFINES
  *********************/
 #define layout_list_def LV_GLOBAL_DEFAULT()->layout_list
+#define layout_measured_cnt LV_GLOBAL_DEFAULT()->layout_measured_cnt
+
+/*The flags which affect how an item is placed*/
+#define ITEM_SKIP_FLAGS (LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)
+#define ITEM_FLAGS (ITEM_SKIP_FLAGS | LV_OBJ_FLAG_FLEX_IN_NEW_TRACK)
 
 /**********************
  *      TYPEDEFS
@@ -49,6 +55,27 @@ typedef struct {
     uint32_t grow_dsc_calc : 1;
 } track_t;
 
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t coords;               /*The coordinates set by the layout relative to the content area*/
+    int32_t main_pos;               /*Main position of the next item*/
+    int32_t cross_size;             /*The largest cross size until this item (inclusive)*/
+    lv_obj_flag_t flags;            /*The `ITEM_FLAGS` of the item*/
+} item_cache_t;
+
+/*The state of the last update of single track layouts without grow items*/
+typedef struct {
+    item_cache_t * items;
+    uint32_t item_cnt;
+    uint32_t item_cap;
+    int32_t item_gap;
+    int32_t track_cross_size;
+    int32_t track_ofs;              /*Offset of the track on the cross axis*/
+    lv_flex_align_t cross_place;
+    lv_flex_align_t track_cross_place;
+    uint8_t row : 1;
+} flex_cache_t;
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -61,6 +88,13 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
                               int32_t item_gap, track_t * t);
 static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, int32_t item_last_id, int32_t abs_x,
                            int32_t abs_y, int32_t max_main_size, int32_t item_gap, track_t * t);
+static bool children_repos_cached(lv_obj_t * cont, flex_t * f, lv_flex_align_t track_cross_place, int32_t abs_x,
+                                  int32_t abs_y, int32_t item_gap);
+static void item_repos(lv_obj_t * item, flex_t * f, int32_t abs_x, int32_t abs_y, int32_t main_pos,
+                       int32_t track_cross_size);
+static bool item_cache_is_valid(const item_cache_t * c, const lv_obj_t * item, int32_t abs_x, int32_t abs_y);
+static bool items_are_cacheable(lv_obj_t * cont);
+static void cache_free(void * cache);
 static void place_content(lv_flex_align_t place, int32_t max_size, int32_t content_size, int32_t item_cnt,
                           int32_t * start_pos, int32_t * gap);
 static lv_obj_t * get_next_item(lv_obj_t * cont, bool rev, int32_t * item_id);
@@ -96,6 +130,7 @@ void lv_flex_init(void)
 {
     layout_list_def[LV_LAYOUT_FLEX].cb = flex_update;
     layout_list_def[LV_LAYOUT_FLEX].user_data = NULL;
+    layout_list_def[LV_LAYOUT_FLEX].cache_free_cb = cache_free;
 }
 
 void lv_obj_set_flex_flow(lv_obj_t * obj, lv_flex_flow_t flow)
@@ -165,6 +200,22 @@ static void flex_update(lv_obj_t * cont, void * user_data)
         else if(track_cross_place == LV_FLEX_ALIGN_END) track_cross_place = LV_FLEX_ALIGN_START;
     }
 
+    /*A single track without grow items can be updated from the first changed item.
+     *Can't wrap if the size is auto (i.e. the size depends on the children)*/
+    bool wrap = f.wrap && !((f.row && w_set == LV_SIZE_CONTENT) || (!f.row && h_set == LV_SIZE_CONTENT));
+    if(!wrap && !f.rev && !rtl && f.main_place == LV_FLEX_ALIGN_START &&
+       children_repos_cached(cont, &f, track_cross_place, abs_x, abs_y, item_gap)) {
+        if(w_set == LV_SIZE_CONTENT || h_set == LV_SIZE_CONTENT) {
+            lv_obj_refr_size(cont);
+        }
+
+        lv_obj_send_event(cont, LV_EVENT_LAYOUT_CHANGED, NULL);
+        return;
+    }
+
+    if(lv_layout_get_cache(cont, LV_LAYOUT_FLEX)) lv_layout_free_cache(cont);
+    layout_measured_cnt += cont->spec_attr->child_cnt;
+
     int32_t total_track_cross_size = 0;
     int32_t gap = 0;
     uint32_t track_cnt = 0;
@@ -337,13 +388,10 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
 {
     void (*area_set_main_size)(lv_area_t *, int32_t) = (f->row ? lv_area_set_width : lv_area_set_height);
     int32_t (*area_get_main_size)(const lv_area_t *) = (f->row ? lv_area_get_width : lv_area_get_height);
-    int32_t (*area_get_cross_size)(const lv_area_t *) = (!f->row ? lv_area_get_width : lv_area_get_height);
 
     typedef int32_t (*margin_func_t)(const lv_obj_t *, uint32_t);
     margin_func_t get_margin_main_start = (f->row ? lv_obj_get_style_margin_left : lv_obj_get_style_margin_top);
     margin_func_t get_margin_main_end = (f->row ? lv_obj_get_style_margin_right : lv_obj_get_style_margin_bottom);
-    margin_func_t get_margin_cross_start = (!f->row ? lv_obj_get_style_margin_left : lv_obj_get_style_margin_top);
-    margin_func_t get_margin_cross_end = (!f->row ? lv_obj_get_style_margin_right : lv_obj_get_style_margin_bottom);
 
     /*Calculate the size of grow items first*/
     uint32_t i;
@@ -438,47 +486,9 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
             lv_obj_mark_layout_as_dirty(item);
         }
 
-        int32_t cross_pos = 0;
-        switch(f->cross_place) {
-            case LV_FLEX_ALIGN_CENTER:
-                /*Round up the cross size to avoid rounding error when dividing by 2
-                 *The issue comes up e,g, with column direction with center cross direction if an element's width changes*/
-                cross_pos = (((t->track_cross_size + 1) & (~1)) - area_get_cross_size(&item->coords)) / 2;
-                cross_pos += (get_margin_cross_start(item, LV_PART_MAIN) - get_margin_cross_end(item, LV_PART_MAIN)) / 2;
-                break;
-            case LV_FLEX_ALIGN_END:
-                cross_pos = t->track_cross_size - area_get_cross_size(&item->coords);
-                cross_pos -= get_margin_cross_end(item, LV_PART_MAIN);
-                break;
-            default:
-                cross_pos += get_margin_cross_start(item, LV_PART_MAIN);
-                break;
-        }
-
         if(f->row && rtl) main_pos -= area_get_main_size(&item->coords);
 
-        /*Handle percentage value of translate*/
-        int32_t tr_x = lv_obj_get_style_translate_x(item, LV_PART_MAIN);
-        int32_t tr_y = lv_obj_get_style_translate_y(item, LV_PART_MAIN);
-        int32_t w = lv_obj_get_width(item);
-        int32_t h = lv_obj_get_height(item);
-        if(LV_COORD_IS_PCT(tr_x)) tr_x = (w * LV_COORD_GET_PCT(tr_x)) / 100;
-        if(LV_COORD_IS_PCT(tr_y)) tr_y = (h * LV_COORD_GET_PCT(tr_y)) / 100;
-
-        int32_t diff_x = abs_x - item->coords.x1 + tr_x;
-        int32_t diff_y = abs_y - item->coords.y1 + tr_y;
-        diff_x += f->row ? main_pos + get_margin_main_start(item, LV_PART_MAIN) : cross_pos;
-        diff_y += f->row ? cross_pos : main_pos + get_margin_main_start(item, LV_PART_MAIN);
-
-        if(diff_x || diff_y) {
-            lv_obj_invalidate(item);
-            item->coords.x1 += diff_x;
-            item->coords.x2 += diff_x;
-            item->coords.y1 += diff_y;
-            item->coords.y2 += diff_y;
-            lv_obj_invalidate(item);
-            lv_obj_move_children_by(item, diff_x, diff_y, false);
-        }
+        item_repos(item, f, abs_x, abs_y, main_pos, t->track_cross_size);
 
         if(!(f->row && rtl)) main_pos += area_get_main_size(&item->coords) + item_gap + place_gap
                                              + get_margin_main_start(item, LV_PART_MAIN)
@@ -489,6 +499,220 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
     }
 }
 
+/**
+ * Position the children of a single track without grow items.
+ * Only the items from the first one which has changed since the last update are processed.
+ * @return      false if the layout can't be updated this way
+ */
+static bool children_repos_cached(lv_obj_t * cont, flex_t * f, lv_flex_align_t track_cross_place, int32_t abs_x,
+                                  int32_t abs_y, int32_t item_gap)
+{
+    flex_cache_t * cache = lv_layout_get_cache(cont, LV_LAYOUT_FLEX);
+    if(cache == NULL) {
+        /*Don't allocate a cache which would be freed right away*/
+        if(!items_are_cacheable(cont)) return false;
+
+        cache = lv_malloc_zeroed(sizeof(flex_cache_t));
+        LV_ASSERT_MALLOC(cache);
+        if(cache == NULL) return false;
+        lv_layout_set_cache(cont, LV_LAYOUT_FLEX, cache);
+    }
+
+    uint32_t child_cnt = cont->spec_attr->child_cnt;
+    if(cache->item_cap < child_cnt) {
+        uint32_t item_cap = LV_MAX(child_cnt, cache->item_cap * 2);
+        item_cache_t * items = lv_realloc(cache->items, sizeof(item_cache_t) * item_cap);
+        LV_ASSERT_MALLOC(items);
+        if(items == NULL) return false;
+        cache->items = items;
+        cache->item_cap = item_cap;
+    }
+
+    /*Find the first item which has changed since the last update*/
+    uint32_t first_changed = 0;
+    if(cache->row == f->row && cache->cross_place == f->cross_place &&
+       cache->track_cross_place == track_cross_place && cache->item_gap == item_gap) {
+        uint32_t cnt = LV_MIN(cache->item_cnt, child_cnt);
+        lv_obj_t ** children = cont->spec_attr->children;
+        while(first_changed < cnt &&
+              item_cache_is_valid(&cache->items[first_changed], children[first_changed], abs_x, abs_y)) {
+            first_changed++;
+        }
+    }
+
+    /*Measure the changed items*/
+    int32_t(*get_cross_size)(const lv_obj_t *) = (!f->row ? lv_obj_get_width_with_margin :
+                                                  lv_obj_get_height_with_margin);
+    int32_t track_cross_size = first_changed ? cache->items[first_changed - 1].cross_size : 0;
+    uint32_t i;
+    for(i = first_changed; i < child_cnt; i++) {
+        lv_obj_t * item = cont->spec_attr->children[i];
+        item_cache_t * c = &cache->items[i];
+        c->obj = item;
+        c->flags = item->flags & ITEM_FLAGS;
+
+        if(i != 0 && (c->flags & LV_OBJ_FLAG_FLEX_IN_NEW_TRACK)) return false;
+
+        if(!(c->flags & ITEM_SKIP_FLAGS)) {
+            if(lv_obj_get_style_flex_grow(item, LV_PART_MAIN)) return false;
+            track_cross_size = LV_MAX(get_cross_size(item), track_cross_size);
+        }
+        c->cross_size = track_cross_size;
+    }
+
+    /*Place the track*/
+    int32_t track_abs_x = abs_x;
+    int32_t track_abs_y = abs_y;
+    if(track_cross_place != LV_FLEX_ALIGN_START) {
+        int32_t gap = 0;
+        int32_t max_cross_size = (f->row ? lv_obj_get_content_height(cont) : lv_obj_get_content_width(cont));
+        int32_t * cross_pos = f->row ? &track_abs_y : &track_abs_x;
+        place_content(track_cross_place, max_cross_size, track_cross_size, 1, cross_pos, &gap);
+    }
+
+    /*If the track has moved or its size has changed all the items might need to be moved on the cross axis*/
+    int32_t track_ofs = (track_abs_x - abs_x) + (track_abs_y - abs_y);
+    if(track_ofs != cache->track_ofs ||
+       (track_cross_size != cache->track_cross_size && f->cross_place != LV_FLEX_ALIGN_START)) {
+        first_changed = 0;
+    }
+
+    int32_t (*area_get_main_size)(const lv_area_t *) = (f->row ? lv_area_get_width : lv_area_get_height);
+    int32_t (*get_margin_main_start)(const lv_obj_t *, uint32_t) = (f->row ? lv_obj_get_style_margin_left :
+                                                                     lv_obj_get_style_margin_top);
+    int32_t (*get_margin_main_end)(const lv_obj_t *, uint32_t) = (f->row ? lv_obj_get_style_margin_right :
+                                                                   lv_obj_get_style_margin_bottom);
+
+    int32_t main_pos = first_changed ? cache->items[first_changed - 1].main_pos : 0;
+    for(i = first_changed; i < child_cnt; i++) {
+        lv_obj_t * item = cont->spec_attr->children[i];
+        item_cache_t * c = &cache->items[i];
+        item->layout_item_inv = 0;
+
+        if(!(c->flags & ITEM_SKIP_FLAGS)) {
+            if(item->w_layout || item->h_layout) {
+                item->w_layout = 0;
+                item->h_layout = 0;
+                lv_obj_mark_layout_as_dirty(item);
+            }
+
+            item_repos(item, f, track_abs_x, track_abs_y, main_pos, track_cross_size);
+
+            main_pos += area_get_main_size(&item->coords) + item_gap
+                        + get_margin_main_start(item, LV_PART_MAIN)
+                        + get_margin_main_end(item, LV_PART_MAIN);
+
+            c->coords = item->coords;
+            lv_area_move(&c->coords, -abs_x, -abs_y);
+        }
+        c->main_pos = main_pos;
+    }
+
+    layout_measured_cnt += child_cnt - first_changed;
+
+    cache->item_cnt = child_cnt;
+    cache->item_gap = item_gap;
+    cache->track_cross_size = track_cross_size;
+    cache->track_ofs = track_ofs;
+    cache->cross_place = f->cross_place;
+    cache->track_cross_place = track_cross_place;
+    cache->row = f->row;
+
+    return true;
+}
+
+/**
+ * Move an item to its position in the track
+ */
+static void item_repos(lv_obj_t * item, flex_t * f, int32_t abs_x, int32_t abs_y, int32_t main_pos,
+                       int32_t track_cross_size)
+{
+    int32_t (*area_get_cross_size)(const lv_area_t *) = (!f->row ? lv_area_get_width : lv_area_get_height);
+
+    typedef int32_t (*margin_func_t)(const lv_obj_t *, uint32_t);
+    margin_func_t get_margin_main_start = (f->row ? lv_obj_get_style_margin_left : lv_obj_get_style_margin_top);
+    margin_func_t get_margin_cross_start = (!f->row ? lv_obj_get_style_margin_left : lv_obj_get_style_margin_top);
+    margin_func_t get_margin_cross_end = (!f->row ? lv_obj_get_style_margin_right : lv_obj_get_style_margin_bottom);
+
+    int32_t cross_pos = 0;
+    switch(f->cross_place) {
+        case LV_FLEX_ALIGN_CENTER:
+            /*Round up the cross size to avoid rounding error when dividing by 2
+             *The issue comes up e,g, with column direction with center cross direction if an element's width changes*/
+            cross_pos = (((track_cross_size + 1) & (~1)) - area_get_cross_size(&item->coords)) / 2;
+            cross_pos += (get_margin_cross_start(item, LV_PART_MAIN) - get_margin_cross_end(item, LV_PART_MAIN)) / 2;
+            break;
+        case LV_FLEX_ALIGN_END:
+            cross_pos = track_cross_size - area_get_cross_size(&item->coords);
+            cross_pos -= get_margin_cross_end(item, LV_PART_MAIN);
+            break;
+        default:
+            cross_pos += get_margin_cross_start(item, LV_PART_MAIN);
+            break;
+    }
+
+    /*Handle percentage value of translate*/
+    int32_t tr_x = lv_obj_get_style_translate_x(item, LV_PART_MAIN);
+    int32_t tr_y = lv_obj_get_style_translate_y(item, LV_PART_MAIN);
+    int32_t w = lv_obj_get_width(item);
+    int32_t h = lv_obj_get_height(item);
+    if(LV_COORD_IS_PCT(tr_x)) tr_x = (w * LV_COORD_GET_PCT(tr_x)) / 100;
+    if(LV_COORD_IS_PCT(tr_y)) tr_y = (h * LV_COORD_GET_PCT(tr_y)) / 100;
+
+    int32_t diff_x = abs_x - item->coords.x1 + tr_x;
+    int32_t diff_y = abs_y - item->coords.y1 + tr_y;
+    diff_x += f->row ? main_pos + get_margin_main_start(item, LV_PART_MAIN) : cross_pos;
+    diff_y += f->row ? cross_pos : main_pos + get_margin_main_start(item, LV_PART_MAIN);
+
+    if(diff_x || diff_y) {
+        lv_obj_invalidate(item);
+        item->coords.x1 += diff_x;
+        item->coords.x2 += diff_x;
+        item->coords.y1 += diff_y;
+        item->coords.y2 += diff_y;
+        lv_obj_invalidate(item);
+        lv_obj_move_children_by(item, diff_x, diff_y, false);
+    }
+}
+
+/**
+ * Check if an item is the same and at the same place as in the last update.
+ * Its styles are not checked because the parent's layout is marked as dirty if they change.
+ */
+static bool item_cache_is_valid(const item_cache_t * c, const lv_obj_t * item, int32_t abs_x, int32_t abs_y)
+{
+    if(c->obj != item || item->layout_item_inv) return false;
+    if(c->flags != (item->flags & ITEM_FLAGS)) return false;
+    if(c->flags & ITEM_SKIP_FLAGS) return true;
+
+    lv_area_t coords = item->coords;
+    lv_area_move(&coords, -abs_x, -abs_y);
+    return lv_area_is_equal(&coords, &c->coords);
+}
+
+/**
+ * Check if the items can be in a single track without grow items, i.e. the cache can be used.
+ */
+static bool items_are_cacheable(lv_obj_t * cont)
+{
+    uint32_t i;
+    for(i = 0; i < cont->spec_attr->child_cnt; i++) {
+        lv_obj_t * item = cont->spec_attr->children[i];
+        if(i != 0 && lv_obj_has_flag(item, LV_OBJ_FLAG_FLEX_IN_NEW_TRACK)) return false;
+        if(lv_obj_has_flag_any(item, ITEM_SKIP_FLAGS)) continue;
+        if(lv_obj_get_style_flex_grow(item, LV_PART_MAIN)) return false;
+    }
+
+    return true;
+}
+
+static void cache_free(void * cache)
+{
+    flex_cache_t * c = cache;
+    lv_free(c->items);
+    lv_free(c);
+}
+
 /**
  * Tell a start coordinate and gap for a placement type.
  */
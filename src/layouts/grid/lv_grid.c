@@ -11,13 +11,18 @@
 #if LV_USE_GRID
 
 #include "../../stdlib/lv_string.h"
-#include "../lv_layout.h"
+#include "../lv_layout_private.h"
 #include "../../core/lv_obj_private.h"
 #include "../../core/lv_global.h"
+#include "../../misc/lv_area_private.h"
 /*********************
  *      DEFINES
  *********************/
 #define layout_list_def LV_GLOBAL_DEFAULT()->layout_list
+#define layout_measured_cnt LV_GLOBAL_DEFAULT()->layout_measured_cnt
+
+/*The flags which make the grid ignore an item*/
+#define ITEM_SKIP_FLAGS (LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)
 
 /**
  * Some helper defines
@@ -46,6 +51,26 @@ typedef struct {
     int32_t grid_h;
 } lv_grid_calc_t;
 
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t coords;               /*The coordinates set by the layout relative to the grid*/
+    lv_obj_flag_t flags;            /*The `ITEM_SKIP_FLAGS` of the item*/
+    uint32_t col_pos;
+    uint32_t col_span;
+    uint32_t row_pos;
+    uint32_t row_span;
+    uint32_t changed : 1;           /*Changed since the last update*/
+} item_cache_t;
+
+/*The state of the last update*/
+typedef struct {
+    item_cache_t * items;
+    uint32_t item_cnt;
+    uint32_t item_cap;
+    lv_grid_calc_t calc;
+    bool rtl;                       /*The items inherit the base direction which swaps their alignment*/
+} grid_cache_t;
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -54,10 +79,15 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 static void grid_update(lv_obj_t * cont, void * user_data);
-static void calc(lv_obj_t * obj, lv_grid_calc_t * calc);
+static void calc(lv_obj_t * obj, lv_grid_calc_t * calc, const grid_cache_t * cache);
 static void calc_free(lv_grid_calc_t * calc);
-static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c);
-static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c);
+static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c, const grid_cache_t * cache);
+static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c, const grid_cache_t * cache);
+static uint32_t find_first_changed_track(const int32_t * pos, const int32_t * size, uint32_t num,
+                                         const int32_t * pos_old, const int32_t * size_old, uint32_t num_old);
+static grid_cache_t * get_cache(lv_obj_t * cont);
+static bool item_cache_is_valid(const item_cache_t * c, const lv_obj_t * item, const lv_point_t * grid_abs);
+static void cache_free(void * cache);
 static void item_repos(lv_obj_t * item, lv_grid_calc_t * c, item_repos_hint_t * hint);
 static int32_t grid_align(int32_t cont_size, bool auto_size, lv_grid_align_t align, int32_t gap,
                           uint32_t track_num,
@@ -145,6 +175,7 @@ void lv_grid_init(void)
 {
     layout_list_def[LV_LAYOUT_GRID].cb = grid_update;
     layout_list_def[LV_LAYOUT_GRID].user_data = NULL;
+    layout_list_def[LV_LAYOUT_GRID].cache_free_cb = cache_free;
 }
 
 void lv_obj_set_grid_dsc_array(lv_obj_t * obj, const int32_t col_dsc[], const int32_t row_dsc[])
@@ -193,8 +224,8 @@ static void grid_update(lv_obj_t * cont, void * user_data)
     //    const int32_t * row_templ = get_row_dsc(cont);
     //    if(col_templ == NULL || row_templ == NULL) return;
 
-    lv_grid_calc_t c;
-    calc(cont, &c);
+    grid_cache_t * cache = get_cache(cont);
+    if(cache == NULL) return;
 
     item_repos_hint_t hint;
     lv_memzero(&hint, sizeof(hint));
@@ -206,12 +237,51 @@ static void grid_update(lv_obj_t * cont, void * user_data)
     hint.grid_abs.x = pad_left + cont->coords.x1 - lv_obj_get_scroll_x(cont);
     hint.grid_abs.y = pad_top + cont->coords.y1 - lv_obj_get_scroll_y(cont);
 
+    /*Read the cell of the children which have changed since the last update*/
+    bool rtl = lv_obj_get_style_base_dir(cont, LV_PART_MAIN) == LV_BASE_DIR_RTL;
+    if(rtl != cache->rtl) cache->item_cnt = 0;
+    cache->rtl = rtl;
+
+    uint32_t child_cnt = cont->spec_attr->child_cnt;
     uint32_t i;
-    for(i = 0; i < cont->spec_attr->child_cnt; i++) {
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * item = cont->spec_attr->children[i];
+        item_cache_t * ic = &cache->items[i];
+        ic->changed = i >= cache->item_cnt || !item_cache_is_valid(ic, item, &hint.grid_abs);
+        if(ic->changed) {
+            ic->obj = item;
+            ic->flags = item->flags & ITEM_SKIP_FLAGS;
+            ic->col_pos = get_col_pos(item);
+            ic->col_span = get_col_span(item);
+            ic->row_pos = get_row_pos(item);
+            ic->row_span = get_row_span(item);
+        }
+    }
+    cache->item_cnt = child_cnt;
+
+    lv_grid_calc_t c;
+    calc(cont, &c, cache);
+
+    /*The items in the tracks after the first changed track need to be moved*/
+    lv_grid_calc_t * c_old = &cache->calc;
+    uint32_t first_col = find_first_changed_track(c.x, c.w, c.col_num, c_old->x, c_old->w, c_old->col_num);
+    uint32_t first_row = find_first_changed_track(c.y, c.h, c.row_num, c_old->y, c_old->h, c_old->row_num);
+
+    for(i = 0; i < child_cnt; i++) {
         lv_obj_t * item = cont->spec_attr->children[i];
+        item_cache_t * ic = &cache->items[i];
+        item->layout_item_inv = 0;
+        bool moved = ic->col_pos + ic->col_span > first_col || ic->row_pos + ic->row_span > first_row;
+        if(!ic->changed && (ic->flags || !moved)) continue;
+
         item_repos(item, &c, &hint);
+        ic->coords = item->coords;
+        lv_area_move(&ic->coords, -hint.grid_abs.x, -hint.grid_abs.y);
+        layout_measured_cnt++;
     }
-    calc_free(&c);
+
+    calc_free(&cache->calc);
+    cache->calc = c;
 
     int32_t w_set = lv_obj_get_style_width(cont, LV_PART_MAIN);
     int32_t h_set = lv_obj_get_style_height(cont, LV_PART_MAIN);
@@ -228,17 +298,16 @@ static void grid_update(lv_obj_t * cont, void * user_data)
  * Calculate the grid cells coordinates
  * @param cont an object that has a grid
  * @param calc store the calculated cells sizes here
+ * @param cache the cells of the children
  * @note `lv_grid_calc_free(calc_out)` needs to be called when `calc_out` is not needed anymore
  */
-static void calc(lv_obj_t * cont, lv_grid_calc_t * calc_out)
+static void calc(lv_obj_t * cont, lv_grid_calc_t * calc_out, const grid_cache_t * cache)
 {
-    if(lv_obj_get_child(cont, 0) == NULL) {
-        lv_memzero(calc_out, sizeof(lv_grid_calc_t));
-        return;
-    }
+    lv_memzero(calc_out, sizeof(lv_grid_calc_t));
+    if(lv_obj_get_child(cont, 0) == NULL) return;
 
-    calc_rows(cont, calc_out);
-    calc_cols(cont, calc_out);
+    calc_rows(cont, calc_out, cache);
+    calc_cols(cont, calc_out, cache);
 
     int32_t col_gap = lv_obj_get_style_pad_column(cont, LV_PART_MAIN);
     int32_t row_gap = lv_obj_get_style_pad_row(cont, LV_PART_MAIN);
@@ -272,7 +341,7 @@ static void calc_free(lv_grid_calc_t * calc)
     lv_free(calc->h);
 }
 
-static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c)
+static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c, const grid_cache_t * cache)
 {
 
     const int32_t * col_templ;
@@ -302,27 +371,23 @@ static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c)
     c->x = lv_malloc(sizeof(int32_t) * c->col_num);
     c->w = lv_malloc(sizeof(int32_t) * c->col_num);
 
-    /*Set sizes for CONTENT cells*/
+    /*Set sizes for CONTENT cells from the size of children in them*/
     uint32_t i;
     for(i = 0; i < c->col_num; i++) {
-        int32_t size = LV_COORD_MIN;
-        if(IS_CONTENT(col_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_count(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t col_span = get_col_span(item);
-                if(col_span != 1) continue;
-
-                uint32_t col_pos = get_col_pos(item);
-                if(col_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_width(item));
-            }
-            if(size >= 0) c->w[i] = size;
-            else c->w[i] = 0;
-        }
+        c->w[i] = LV_COORD_MIN;
+    }
+
+    for(i = 0; i < cache->item_cnt; i++) {
+        const item_cache_t * ic = &cache->items[i];
+        if(ic->flags & ITEM_SKIP_FLAGS) continue;
+        if(ic->col_span != 1 || ic->col_pos >= c->col_num) continue;
+        if(!IS_CONTENT(col_templ[ic->col_pos])) continue;
+
+        c->w[ic->col_pos] = LV_MAX(c->w[ic->col_pos], lv_obj_get_width(ic->obj));
+    }
+
+    for(i = 0; i < c->col_num; i++) {
+        if(IS_CONTENT(col_templ[i]) && c->w[i] < 0) c->w[i] = 0;
     }
 
     uint32_t col_fr_cnt = 0;
@@ -365,7 +430,7 @@ static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c)
     }
 }
 
-static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c)
+static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c, const grid_cache_t * cache)
 {
     const int32_t * row_templ;
     row_templ = get_row_dsc(cont);
@@ -391,27 +456,23 @@ static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c)
     c->row_num = count_tracks(row_templ);
     c->y = lv_malloc(sizeof(int32_t) * c->row_num);
     c->h = lv_malloc(sizeof(int32_t) * c->row_num);
-    /*Set sizes for CONTENT cells*/
+    /*Set sizes for CONTENT cells from the size of children in them*/
     uint32_t i;
     for(i = 0; i < c->row_num; i++) {
-        int32_t size = LV_COORD_MIN;
-        if(IS_CONTENT(row_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_count(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t row_span = get_row_span(item);
-                if(row_span != 1) continue;
-
-                uint32_t row_pos = get_row_pos(item);
-                if(row_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_height(item));
-            }
-            if(size >= 0) c->h[i] = size;
-            else c->h[i] = 0;
-        }
+        c->h[i] = LV_COORD_MIN;
+    }
+
+    for(i = 0; i < cache->item_cnt; i++) {
+        const item_cache_t * ic = &cache->items[i];
+        if(ic->flags & ITEM_SKIP_FLAGS) continue;
+        if(ic->row_span != 1 || ic->row_pos >= c->row_num) continue;
+        if(!IS_CONTENT(row_templ[ic->row_pos])) continue;
+
+        c->h[ic->row_pos] = LV_MAX(c->h[ic->row_pos], lv_obj_get_height(ic->obj));
+    }
+
+    for(i = 0; i < c->row_num; i++) {
+        if(IS_CONTENT(row_templ[i]) && c->h[i] < 0) c->h[i] = 0;
     }
 
     uint32_t row_fr_cnt = 0;
@@ -454,6 +515,73 @@ static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c)
     }
 }
 
+/**
+ * Find the first track whose position or size is different
+ * @return      index of the first different track or `num` if all are the same
+ */
+static uint32_t find_first_changed_track(const int32_t * pos, const int32_t * size, uint32_t num,
+                                         const int32_t * pos_old, const int32_t * size_old, uint32_t num_old)
+{
+    uint32_t cnt = LV_MIN(num, num_old);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        if(pos[i] != pos_old[i] || size[i] != size_old[i]) return i;
+    }
+
+    return cnt;
+}
+
+/**
+ * Get the state of the last update of a grid and make room for all the children in it
+ * @param cont      pointer to a grid container
+ * @return          the cache or NULL on error
+ */
+static grid_cache_t * get_cache(lv_obj_t * cont)
+{
+    grid_cache_t * cache = lv_layout_get_cache(cont, LV_LAYOUT_GRID);
+    if(cache == NULL) {
+        cache = lv_malloc_zeroed(sizeof(grid_cache_t));
+        LV_ASSERT_MALLOC(cache);
+        if(cache == NULL) return NULL;
+        lv_layout_set_cache(cont, LV_LAYOUT_GRID, cache);
+    }
+
+    uint32_t child_cnt = cont->spec_attr->child_cnt;
+    if(cache->item_cap < child_cnt) {
+        uint32_t item_cap = LV_MAX(child_cnt, cache->item_cap * 2);
+        item_cache_t * items = lv_realloc(cache->items, sizeof(item_cache_t) * item_cap);
+        LV_ASSERT_MALLOC(items);
+        if(items == NULL) return NULL;
+        cache->items = items;
+        cache->item_cap = item_cap;
+    }
+
+    return cache;
+}
+
+/**
+ * Check if an item is the same and at the same place as in the last update.
+ * Its styles are not checked because the parent's layout is marked as dirty if they change.
+ */
+static bool item_cache_is_valid(const item_cache_t * c, const lv_obj_t * item, const lv_point_t * grid_abs)
+{
+    if(c->obj != item || item->layout_item_inv) return false;
+    if(c->flags != (item->flags & ITEM_SKIP_FLAGS)) return false;
+    if(c->flags) return true;
+
+    lv_area_t coords = item->coords;
+    lv_area_move(&coords, -grid_abs->x, -grid_abs->y);
+    return lv_area_is_equal(&coords, &c->coords);
+}
+
+static void cache_free(void * cache)
+{
+    grid_cache_t * c = cache;
+    calc_free(&c->calc);
+    lv_free(c->items);
+    lv_free(c);
+}
+
 /**
  * Reposition a grid item in its cell
  * @param item a grid item to reposition
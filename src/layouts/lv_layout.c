@@ -8,13 +8,14 @@
  *********************/
 #include "lv_layout_private.h"
 #include "../core/lv_global.h"
-#include "../core/lv_obj.h"
+#include "../core/lv_obj_private.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define layout_cnt LV_GLOBAL_DEFAULT()->layout_count
 #define layout_list_def LV_GLOBAL_DEFAULT()->layout_list
+#define layout_measured_cnt LV_GLOBAL_DEFAULT()->layout_measured_cnt
 
 /**********************
  *      TYPEDEFS
@@ -39,7 +40,7 @@
 void lv_layout_init(void)
 {
     /*Malloc a list for the built in layouts*/
-    layout_list_def = lv_malloc(layout_cnt * sizeof(lv_layout_dsc_t));
+    layout_list_def = lv_malloc_zeroed(layout_cnt * sizeof(lv_layout_dsc_t));
 
 #if LV_USE_FLEX
     lv_flex_init();
@@ -62,9 +63,15 @@ uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data)
 
     layout_list_def[layout_cnt].cb = cb;
     layout_list_def[layout_cnt].user_data = user_data;
+    layout_list_def[layout_cnt].cache_free_cb = NULL;
     return layout_cnt++;
 }
 
+uint32_t lv_layout_get_measured_count(void)
+{
+    return layout_measured_cnt;
+}
+
 void lv_layout_apply(lv_obj_t * obj)
 {
     lv_layout_t layout_id = lv_obj_get_style_layout(obj, LV_PART_MAIN);
@@ -74,6 +81,37 @@ void lv_layout_apply(lv_obj_t * obj)
     }
 }
 
+void * lv_layout_get_cache(const lv_obj_t * obj, uint32_t layout)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->layout_cache_id != layout) return NULL;
+    return obj->spec_attr->layout_cache;
+}
+
+void lv_layout_set_cache(lv_obj_t * obj, uint32_t layout, void * cache)
+{
+    lv_obj_allocate_spec_attr(obj);
+    if(obj->spec_attr->layout_cache != cache) lv_layout_free_cache(obj);
+
+    obj->spec_attr->layout_cache = cache;
+    obj->spec_attr->layout_cache_id = layout;
+}
+
+void lv_layout_free_cache(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->layout_cache == NULL) return;
+
+    uint32_t layout_id = obj->spec_attr->layout_cache_id;
+    if(layout_id < layout_cnt && layout_list_def[layout_id].cache_free_cb) {
+        layout_list_def[layout_id].cache_free_cb(obj->spec_attr->layout_cache);
+    }
+    else {
+        lv_free(obj->spec_attr->layout_cache);
+    }
+
+    obj->spec_attr->layout_cache = NULL;
+    obj->spec_attr->layout_cache_id = LV_LAYOUT_NONE;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -48,6 +48,13 @@ typedef enum {
  */
 uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data);
 
+/**
+ * Get the number of children measured and positioned by the built-in layouts since the start.
+ * The layouts remember the measured children and process only the changed ones in the next updates.
+ * @return          the number of measured children
+ */
+uint32_t lv_layout_get_measured_count(void);
+
 /**********************
  *      MACROS
  **********************/
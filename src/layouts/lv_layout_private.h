@@ -24,9 +24,12 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+typedef void (*lv_layout_cache_free_cb_t)(void * cache);
+
 typedef struct {
     lv_layout_update_cb_t cb;
     void * user_data;
+    lv_layout_cache_free_cb_t cache_free_cb;    /**< Free the data stored by the layout. If NULL `lv_free` is used*/
 } lv_layout_dsc_t;
 
 /**********************
@@ -47,6 +50,29 @@ void lv_layout_deinit(void);
  */
 void lv_layout_apply(lv_obj_t * obj);
 
+/**
+ * Get the data stored by a layout in a widget in a previous update
+ * @param obj       pointer to a widget
+ * @param layout    ID of the layout, e.g. `LV_LAYOUT_FLEX`
+ * @return          the stored data or NULL if there is no data or another layout has stored it
+ */
+void * lv_layout_get_cache(const lv_obj_t * obj, uint32_t layout);
+
+/**
+ * Store data in a widget to speed up the next updates of a layout.
+ * The previously stored data is freed (if it's different), and `cache` is freed when the widget is deleted.
+ * @param obj       pointer to a widget
+ * @param layout    ID of the layout which stores the data
+ * @param cache     the data to store. Freed by the `cache_free_cb` of the layout.
+ */
+void lv_layout_set_cache(lv_obj_t * obj, uint32_t layout, void * cache);
+
+/**
+ * Free the data stored by a layout in a widget
+ * @param obj       pointer to a widget
+ */
+void lv_layout_free_cache(lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
@@ -28,6 +28,7 @@
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_SSE2         3
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 #define LV_NEMA_HAL_CUSTOM          0
@@ -366,6 +367,39 @@
     #endif
 #endif
 
+/* Max memory used to keep the rendered content of the widgets having `LV_OBJ_FLAG_CACHE_LAYER`.
+ * The least recently drawn ones are dropped if the limit is reached.
+ * Set it to 0 to ignore `LV_OBJ_FLAG_CACHE_LAYER`. */
+#ifndef LV_DRAW_LAYER_CACHE_MAX_MEMORY
+    #ifdef CONFIG_LV_DRAW_LAYER_CACHE_MAX_MEMORY
+        #define LV_DRAW_LAYER_CACHE_MAX_MEMORY CONFIG_LV_DRAW_LAYER_CACHE_MAX_MEMORY
+    #else
+        #define LV_DRAW_LAYER_CACHE_MAX_MEMORY 0  /**< [bytes]*/
+    #endif
+#endif
+
+/** Don't draw the widgets or the parts of the widgets which are covered by opaque widgets drawn later.
+ *  Only non-transformed widgets with full opacity are considered as covering.
+ *  Use `lv_display_get_culled_px_count()` to see how many pixels were skipped in the last refresh. */
+#ifndef LV_USE_OCCLUSION_CULLING
+    #ifdef CONFIG_LV_USE_OCCLUSION_CULLING
+        #define LV_USE_OCCLUSION_CULLING CONFIG_LV_USE_OCCLUSION_CULLING
+    #else
+        #define LV_USE_OCCLUSION_CULLING 0
+    #endif
+#endif
+
+/** In `LV_DISPLAY_RENDER_MODE_DIRECT` move the already rendered pixels of the scrolled widgets
+ *  and redraw only the newly revealed parts. Used only if nothing else is drawn on the scrolled area
+ *  (e.g. the widget has an opaque plain background and there are no floating widgets above it). */
+#ifndef LV_USE_SCROLL_SHIFT
+    #ifdef CONFIG_LV_USE_SCROLL_SHIFT
+        #define LV_USE_SCROLL_SHIFT CONFIG_LV_USE_SCROLL_SHIFT
+    #else
+        #define LV_USE_SCROLL_SHIFT 0
+    #endif
+#endif
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -593,7 +627,7 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /** Allow buffering some shadow calculation.
          *  LV_DRAW_SW_SHADOW_CACHE_SIZE is the maximum shadow size to buffer, where shadow size is
-         *  `shadow_width + radius`.  Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost. */
+         *  `shadow_width + radius`.  Caching a shadow has `shadow size`^2 RAM cost. */
         #ifndef LV_DRAW_SW_SHADOW_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
                 #define LV_DRAW_SW_SHADOW_CACHE_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
@@ -601,10 +635,22 @@
                 #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
             #endif
         #endif
+        #if LV_DRAW_SW_SHADOW_CACHE_SIZE
+            /** Size in bytes of the cache of the blurred shadow corners.
+             *  The least recently used corners are dropped when it's full. */
+            #ifndef LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE
+                #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE
+                    #define LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE
+                #else
+                    #define LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE (32 * 1024)
+                #endif
+            #endif
+        #endif
 
         /** Set number of maximally-cached circle data.
          *  The circumference of 1/4 circle are saved for anti-aliasing.
-         *  `radius * 4` bytes are used per circle (the most often used radiuses are saved).
+         *  `radius * 6` bytes are used per circle (the least recently used radiuses are dropped).
+         *  The cache is shared by the draw threads and kept between the refreshes.
          *  - 0: disables caching */
         #ifndef LV_DRAW_SW_CIRCLE_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
@@ -613,6 +659,18 @@
                 #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
             #endif
         #endif
+
+        /** Size in bytes of the cache of the gradient color maps.
+         *  A map costs `4 * gradient length` bytes and is shared by all the draw tasks using the same stops.
+         *  E.g. `(8 * 1024)` keeps the maps of a few screen wide gradients.
+         *  - 0: disables caching */
+        #ifndef LV_DRAW_SW_GRAD_CACHE_SIZE
+            #ifdef CONFIG_LV_DRAW_SW_GRAD_CACHE_SIZE
+                #define LV_DRAW_SW_GRAD_CACHE_SIZE CONFIG_LV_DRAW_SW_GRAD_CACHE_SIZE
+            #else
+                #define LV_DRAW_SW_GRAD_CACHE_SIZE 0
+            #endif
+        #endif
     #endif
 
     #ifndef LV_USE_DRAW_SW_ASM
@@ -1339,6 +1397,29 @@
     #endif
 #endif
 
+/** 1: Decode the images in a background thread.
+ *  While an image is not in the image cache yet a placeholder is drawn instead of blocking the rendering,
+ *  and the Widget is invalidated when the decoded image is ready.
+ *  Requires `LV_USE_OS` and the image cache (`LV_CACHE_DEF_SIZE > 0`).
+ *  Images can be decoded in advance with `lv_image_decoder_prefetch()` too. */
+#ifndef LV_USE_IMAGE_DECODER_ASYNC
+    #ifdef CONFIG_LV_USE_IMAGE_DECODER_ASYNC
+        #define LV_USE_IMAGE_DECODER_ASYNC CONFIG_LV_USE_IMAGE_DECODER_ASYNC
+    #else
+        #define LV_USE_IMAGE_DECODER_ASYNC 0
+    #endif
+#endif
+#if LV_USE_IMAGE_DECODER_ASYNC
+    /** Stack size of the decoder thread. Image decoders (e.g. PNG or JPEG) might need a lot of stack. */
+    #ifndef LV_IMAGE_DECODER_ASYNC_STACK_SIZE
+        #ifdef CONFIG_LV_IMAGE_DECODER_ASYNC_STACK_SIZE
+            #define LV_IMAGE_DECODER_ASYNC_STACK_SIZE CONFIG_LV_IMAGE_DECODER_ASYNC_STACK_SIZE
+        #else
+            #define LV_IMAGE_DECODER_ASYNC_STACK_SIZE   (32 * 1024)     /**< [bytes]*/
+        #endif
+    #endif
+#endif
+
 /** Number of stops allowed per gradient. Increase this to allow more stops.
  *  This adds (sizeof(lv_color_t) + 1) bytes per additional stop. */
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -1372,6 +1453,18 @@
     #endif
 #endif
 
+/** Cache this many resolved style properties per widget (for each part and state).
+ *  A cached property is returned without looking up the styles of the widget and its parents.
+ *  The cache is allocated when a style property of the widget is read the first time.
+ *  Must be a power of 2. 0: disable the cache */
+#ifndef LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+        #define LV_OBJ_STYLE_RESOLVED_CACHE_SIZE CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    #else
+        #define LV_OBJ_STYLE_RESOLVED_CACHE_SIZE    0
+    #endif
+#endif
+
 /** Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -1914,6 +2007,17 @@
     #endif
 #endif
 
+/** Size in bytes of the cache of the decoded glyph bitmaps of the `lv_font_fmt_txt` fonts (e.g. built-in fonts).
+ *  Glyphs found in the cache don't need to be decompressed or converted to A8 again.
+ *  0: to disable caching */
+#ifndef LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE 0
+    #endif
+#endif
+
 /** Enables/disables support for compressed fonts. */
 #ifndef LV_USE_FONT_COMPRESSED
     #ifdef CONFIG_LV_USE_FONT_COMPRESSED
@@ -145,11 +145,6 @@ static inline void lv_global_init(lv_global_t * global)
     void LV_LOG_PRINT_CB(lv_log_level_t, const char * txt);
     global->custom_log_print_cb = LV_LOG_PRINT_CB;
 #endif
-
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    global->sw_shadow_cache.cache_size = -1;
-    global->sw_shadow_cache.cache_r = -1;
-#endif
 }
 
 static inline void lv_cleanup_devices(lv_global_t * global)
@@ -288,6 +283,10 @@ void lv_init(void)
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    lv_font_fmt_txt_glyph_cache_init(LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE);
+#endif
+
 #if LV_USE_DRAW_VG_LITE
     lv_draw_vg_lite_init();
 #endif
@@ -453,6 +452,10 @@ void lv_deinit(void)
 
     lv_image_decoder_deinit();
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    lv_font_fmt_txt_glyph_cache_deinit();
+#endif
+
     lv_refr_deinit();
 
     lv_obj_style_deinit();
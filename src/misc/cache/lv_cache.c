@@ -20,12 +20,24 @@
  *      TYPEDEFS
  **********************/
 
+/**
+ * A thread waiting for an entry which is being created by an other thread
+ */
+typedef struct _lv_cache_waiter_t {
+    lv_cache_entry_t * entry;           /**< The pending entry */
+    lv_thread_sync_t sync;              /**< Signaled when the entry is created or its creation failed */
+    struct _lv_cache_waiter_t * next;   /**< The next waiter of the cache */
+} lv_cache_waiter_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void cache_drop_internal_no_lock(lv_cache_t * cache, const void * key, void * user_data);
 static bool cache_evict_one_internal_no_lock(lv_cache_t * cache, void * user_data);
 static lv_cache_entry_t * cache_add_internal_no_lock(lv_cache_t * cache, const void * key, void * user_data);
+static void cache_release_internal_no_lock(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data);
+static bool cache_wait_pending_no_lock(lv_cache_t * cache, lv_cache_entry_t * entry);
+static void cache_wake_waiters_no_lock(lv_cache_t * cache, lv_cache_entry_t * entry);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -55,6 +67,10 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
     cache->max_size = max_size;
     cache->size = 0;
     cache->ops = ops;
+    cache->waiters = NULL;
+    cache->wait_cnt = 0;
+    cache->hit_cnt = 0;
+    cache->miss_cnt = 0;
 
     if(cache->clz->init_cb(cache) == false) {
         LV_LOG_ERROR("Cache init failed");
@@ -88,6 +104,7 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     lv_mutex_lock(&cache->lock);
 
     if(cache->size == 0) {
+        cache->miss_cnt++;
         lv_mutex_unlock(&cache->lock);
 
         LV_PROFILER_CACHE_END;
@@ -95,8 +112,16 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     }
 
     lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
-    if(entry != NULL) {
+    if(entry == NULL) {
+        cache->miss_cnt++;
+    }
+    else {
+        cache->hit_cnt++;
         lv_cache_entry_acquire_data(entry);
+        if(lv_cache_entry_is_pending(entry) && !cache_wait_pending_no_lock(cache, entry)) {
+            cache_release_internal_no_lock(cache, entry, user_data);
+            entry = NULL;
+        }
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -110,12 +135,7 @@ void lv_cache_release(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
-    lv_cache_entry_release_data(entry, user_data);
-
-    if(lv_cache_entry_get_ref(entry) == 0 && lv_cache_entry_is_invalid(entry)) {
-        cache->ops.free_cb(lv_cache_entry_get_data(entry), user_data);
-        lv_cache_entry_delete(entry);
-    }
+    cache_release_internal_no_lock(cache, entry, user_data);
     lv_mutex_unlock(&cache->lock);
 
     LV_PROFILER_CACHE_END;
@@ -157,7 +177,12 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
     if(cache->size != 0) {
         entry = cache->clz->get_cb(cache, key, user_data);
         if(entry != NULL) {
+            cache->hit_cnt++;
             lv_cache_entry_acquire_data(entry);
+            if(lv_cache_entry_is_pending(entry) && !cache_wait_pending_no_lock(cache, entry)) {
+                cache_release_internal_no_lock(cache, entry, user_data);
+                entry = NULL;
+            }
             lv_mutex_unlock(&cache->lock);
 
             LV_PROFILER_CACHE_END;
@@ -165,6 +190,7 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         }
     }
 
+    cache->miss_cnt++;
     if(cache->max_size == 0) {
         lv_mutex_unlock(&cache->lock);
 
@@ -179,15 +205,45 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         LV_PROFILER_CACHE_END;
         return NULL;
     }
+
+    if(!cache->ops.create_unlocked) {
+        bool create_res = cache->ops.create_cb(lv_cache_entry_get_data(entry), user_data);
+        if(create_res == false) {
+            cache->clz->remove_cb(cache, entry, user_data);
+            cache->ops.free_cb(lv_cache_entry_get_data(entry), user_data);
+            lv_cache_entry_delete(entry);
+            entry = NULL;
+        }
+        else {
+            lv_cache_entry_acquire_data(entry);
+        }
+        lv_mutex_unlock(&cache->lock);
+
+        LV_PROFILER_CACHE_END;
+        return entry;
+    }
+
+    /*Creating the data can be slow (e.g. decoding or rendering), so don't block the whole cache meanwhile.
+     *The entry is referenced to not be evicted, and marked as pending so that
+     *the others looking for the same key will wait until it's ready.*/
+    lv_cache_entry_acquire_data(entry);
+    lv_cache_entry_set_pending(entry, true);
+    lv_mutex_unlock(&cache->lock);
+
     bool create_res = cache->ops.create_cb(lv_cache_entry_get_data(entry), user_data);
-    if(create_res == false) {
+
+    lv_mutex_lock(&cache->lock);
+    lv_cache_entry_set_pending(entry, false);
+    if(create_res == false && lv_cache_entry_is_invalid(entry) == false) {
+        /*Make the waiters give up too and free the entry with the last reference*/
         cache->clz->remove_cb(cache, entry, user_data);
-        cache->ops.free_cb(lv_cache_entry_get_data(entry), user_data);
-        lv_cache_entry_delete(entry);
-        entry = NULL;
+        lv_cache_entry_set_invalid(entry, true);
     }
-    else {
-        lv_cache_entry_acquire_data(entry);
+    cache_wake_waiters_no_lock(cache, entry);
+
+    if(create_res == false) {
+        cache_release_internal_no_lock(cache, entry, user_data);
+        entry = NULL;
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -295,6 +351,24 @@ const char * lv_cache_get_name(lv_cache_t * cache)
     return cache->name;
 }
 
+uint32_t lv_cache_get_wait_count(lv_cache_t * cache)
+{
+    LV_ASSERT_NULL(cache);
+    return cache->wait_cnt;
+}
+
+uint32_t lv_cache_get_hit_count(lv_cache_t * cache)
+{
+    LV_ASSERT_NULL(cache);
+    return cache->hit_cnt;
+}
+
+uint32_t lv_cache_get_miss_count(lv_cache_t * cache)
+{
+    LV_ASSERT_NULL(cache);
+    return cache->miss_cnt;
+}
+
 lv_iter_t * lv_cache_iter_create(lv_cache_t * cache)
 {
     LV_ASSERT_NULL(cache);
@@ -356,3 +430,57 @@ static lv_cache_entry_t * cache_add_internal_no_lock(lv_cache_t * cache, const v
 
     return entry;
 }
+
+static void cache_release_internal_no_lock(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data)
+{
+    lv_cache_entry_release_data(entry, user_data);
+
+    if(lv_cache_entry_get_ref(entry) == 0 && lv_cache_entry_is_invalid(entry)) {
+        cache->ops.free_cb(lv_cache_entry_get_data(entry), user_data);
+        lv_cache_entry_delete(entry);
+    }
+}
+
+/**
+ * Wait until an other thread finishes creating the data of `entry`.
+ * The cache lock is released while waiting and it's taken again before returning.
+ * @param cache     pointer to a cache
+ * @param entry     a pending entry acquired by the caller
+ * @return          true: the data is ready; false: the creation has failed or the entry was dropped
+ */
+static bool cache_wait_pending_no_lock(lv_cache_t * cache, lv_cache_entry_t * entry)
+{
+    cache->wait_cnt++;
+
+#if LV_USE_OS != LV_OS_NONE
+    lv_cache_waiter_t waiter;
+    waiter.entry = entry;
+    lv_thread_sync_init(&waiter.sync);
+    waiter.next = cache->waiters;
+    cache->waiters = &waiter;
+
+    /*The creator removes the waiter from the list and signals it after clearing the pending flag*/
+    lv_mutex_unlock(&cache->lock);
+    lv_thread_sync_wait(&waiter.sync);
+    lv_mutex_lock(&cache->lock);
+
+    lv_thread_sync_delete(&waiter.sync);
+#endif
+
+    return lv_cache_entry_is_invalid(entry) == false;
+}
+
+static void cache_wake_waiters_no_lock(lv_cache_t * cache, lv_cache_entry_t * entry)
+{
+    lv_cache_waiter_t ** waiter_p = &cache->waiters;
+    while(*waiter_p) {
+        lv_cache_waiter_t * waiter = *waiter_p;
+        if(waiter->entry == entry) {
+            *waiter_p = waiter->next;
+            lv_thread_sync_signal(&waiter->sync);
+        }
+        else {
+            waiter_p = &waiter->next;
+        }
+    }
+}
@@ -72,6 +72,8 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
  * If you want to use this API to simplify the code, you should provide a `lv_cache_ops_t::create_cb` that creates a new entry with the given key.
  * This API is a combination of lv_cache_acquire() and lv_cache_add(). The effect is the same as calling lv_cache_acquire() and lv_cache_add() separately.
  * And the internal impact on cache is also consistent with these two APIs.
+ * `create_cb` is called without holding the cache's lock, so other threads can use the cache meanwhile.
+ * Until it returns, the threads acquiring the same key wait for the new entry.
  * @param cache         The cache object pointer to acquire the entry.
  * @param key           The key of the entry to acquire or create.
  * @param user_data     A user data pointer that will be passed to the create callback.
@@ -215,6 +217,30 @@ void lv_cache_set_name(lv_cache_t * cache, const char * name);
  */
 const char * lv_cache_get_name(lv_cache_t * cache);
 
+/**
+ * Get how many times a thread had to wait for an entry which was being created by an other thread.
+ * Only the threads looking for the same key wait, the other keys can be used meanwhile.
+ * A high value means that the threads often need the same data at the same time.
+ * @param cache         The cache object pointer to get the counter.
+ * @return              Returns the number of waits since the cache was created.
+ */
+uint32_t lv_cache_get_wait_count(lv_cache_t * cache);
+
+/**
+ * Get how many times `lv_cache_acquire()` or `lv_cache_acquire_or_create()` found the entry in the cache.
+ * Together with `lv_cache_get_miss_count()` it tells the hit rate, i.e. whether the cache is large enough.
+ * @param cache         The cache object pointer to get the counter.
+ * @return              Returns the number of hits since the cache was created.
+ */
+uint32_t lv_cache_get_hit_count(lv_cache_t * cache);
+
+/**
+ * Get how many times `lv_cache_acquire()` or `lv_cache_acquire_or_create()` didn't find the entry in the cache.
+ * @param cache         The cache object pointer to get the counter.
+ * @return              Returns the number of misses since the cache was created.
+ */
+uint32_t lv_cache_get_miss_count(lv_cache_t * cache);
+
 /**
  * Create an iterator for the cache object. The iterator is used to iterate over all cache entries.
  * @param cache         The cache object pointer to create the iterator.
@@ -26,6 +26,7 @@ struct _lv_cache_entry_t {
     uint32_t node_size;
 
     bool is_invalid;
+    bool is_pending;
 };
 /**********************
  *  STATIC PROTOTYPES
@@ -98,6 +99,18 @@ bool lv_cache_entry_is_invalid(lv_cache_entry_t * entry)
     return entry->is_invalid;
 }
 
+void lv_cache_entry_set_pending(lv_cache_entry_t * entry, bool is_pending)
+{
+    LV_ASSERT_NULL(entry);
+    entry->is_pending = is_pending;
+}
+
+bool lv_cache_entry_is_pending(lv_cache_entry_t * entry)
+{
+    LV_ASSERT_NULL(entry);
+    return entry->is_pending;
+}
+
 void * lv_cache_entry_get_data(lv_cache_entry_t * entry)
 {
     LV_ASSERT_NULL(entry);
@@ -170,6 +183,7 @@ void lv_cache_entry_init(lv_cache_entry_t * entry, const lv_cache_t * cache, con
     entry->node_size = node_size;
     entry->ref_cnt = 0;
     entry->is_invalid = false;
+    entry->is_pending = false;
 }
 
 void lv_cache_entry_delete(lv_cache_entry_t * entry)
@@ -55,6 +55,13 @@ uint32_t lv_cache_entry_get_node_size(lv_cache_entry_t * entry);
  */
 bool     lv_cache_entry_is_invalid(lv_cache_entry_t * entry);
 
+/**
+ * Check if the data of a cache entry is still being created by `lv_cache_acquire_or_create()`.
+ * @param entry        The cache entry to check.
+ * @return             True: the data is being created. False: the data is ready.
+ */
+bool     lv_cache_entry_is_pending(lv_cache_entry_t * entry);
+
 /**
  * Get the data of a cache entry.
  * @param entry        The cache entry to get the data of.
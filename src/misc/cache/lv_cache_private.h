@@ -38,6 +38,7 @@ struct _lv_cache_ops_t;
 struct _lv_cache_t;
 struct _lv_cache_class_t;
 struct _lv_cache_entry_t;
+struct _lv_cache_waiter_t;
 
 typedef struct _lv_cache_ops_t lv_cache_ops_t;
 typedef struct _lv_cache_class_t lv_cache_class_t;
@@ -118,6 +119,8 @@ struct _lv_cache_ops_t {
     lv_cache_compare_cb_t compare_cb;    /**< Compare function for keys */
     lv_cache_create_cb_t create_cb;      /**< Create function for nodes */
     lv_cache_free_cb_t free_cb;          /**< Free function for nodes */
+    bool create_unlocked;                /**< true: `create_cb` is thread safe, so it runs without locking the cache.
+                                          *   Only the threads acquiring the same key wait for it. */
 };
 
 /**
@@ -137,6 +140,11 @@ struct _lv_cache_t {
 
     lv_mutex_t lock;                  /**< Cache lock used to protect the cache in multithreading environments */
 
+    struct _lv_cache_waiter_t * waiters; /**< Threads waiting for entries being created by other threads */
+    uint32_t wait_cnt;                /**< Number of times a thread had to wait for an entry being created */
+    uint32_t hit_cnt;                 /**< Number of lookups which found the entry */
+    uint32_t miss_cnt;                /**< Number of lookups which didn't find the entry */
+
     const char * name;                /**< Name of the cache */
 };
 
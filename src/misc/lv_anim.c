@@ -29,6 +29,9 @@
 /**In an anim. time this bit indicates that the value is speed, and not time*/
 #define LV_ANIM_SPEED_MASK 0x80000000
 
+/**Initial number of buckets in the `var` index of the animations*/
+#define LV_ANIM_HASH_BUCKET_CNT_MIN 16
+
 #define state LV_GLOBAL_DEFAULT()->anim_state
 #define anim_ll_p &(state.anim_ll)
 
@@ -49,6 +52,12 @@ static void lv_anim_pause_for_internal(lv_anim_t * a, uint32_t ms);
 static void resolve_time(lv_anim_t * a);
 static bool remove_concurrent_anims(const lv_anim_t * a_current);
 static void remove_anim(void * a);
+static void delete_anim(lv_anim_t * a, bool completed);
+static void free_deleted_anims(void);
+static lv_anim_t ** get_bucket(const void * var);
+static bool hash_reserve(void);
+static void hash_add(lv_anim_t * a);
+static void hash_remove(lv_anim_t * a);
 
 /**********************
  *  STATIC VARIABLES
@@ -79,6 +88,10 @@ void lv_anim_core_init(void)
 void lv_anim_core_deinit(void)
 {
     lv_anim_delete_all();
+
+    lv_free(state.hash_buckets);
+    state.hash_buckets = NULL;
+    state.hash_bucket_cnt = 0;
 }
 
 void lv_anim_enable_vsync_mode(bool enable)
@@ -125,6 +138,8 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         remove_concurrent_anims(a);
     }
 
+    if(!hash_reserve()) return NULL;
+
     /*Add the new animation to the animation linked list*/
     lv_anim_t * new_anim = lv_ll_ins_head(anim_ll_p);
     LV_ASSERT_MALLOC(new_anim);
@@ -136,6 +151,9 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
     new_anim->run_round = state.anim_run_round;
     new_anim->last_timer_run = lv_tick_get();
     new_anim->is_paused = false;
+    new_anim->is_deleted = false;
+    hash_add(new_anim);
+    state.anim_cnt++;
 
     /*Set the start value*/
     if(new_anim->early_apply) {
@@ -183,20 +201,40 @@ bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
 {
     lv_anim_t * a;
     bool del_any = false;
-    a        = lv_ll_get_head(anim_ll_p);
+
+    /*Without `var` all the animations need to be checked*/
+    if(var == NULL) {
+        a = lv_ll_get_head(anim_ll_p);
+        while(a != NULL) {
+            bool del = false;
+            if(!a->is_deleted && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+                remove_anim(a);
+                del_any = true;
+                del = true;
+            }
+
+            /*Always start from the head on delete, because we don't know
+             *how `anim_ll_p` was changes in `a->deleted_cb` */
+            a = del ? lv_ll_get_head(anim_ll_p) : lv_ll_get_next(anim_ll_p, a);
+        }
+
+        return del_any;
+    }
+
+    if(state.hash_bucket_cnt == 0) return false;
+
+    a = *get_bucket(var);
     while(a != NULL) {
         bool del = false;
-        if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+        if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             remove_anim(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
             del_any = true;
             del = true;
         }
 
-        /*Always start from the head on delete, because we don't know
-         *how `anim_ll_p` was changes in `a->deleted_cb` */
-        a = del ? lv_ll_get_head(anim_ll_p) : lv_ll_get_next(anim_ll_p, a);
+        /*Always start from the head of the bucket on delete, because
+         *the animations might be changed in `a->deleted_cb` */
+        a = del ? *get_bucket(var) : a->hash_next;
     }
 
     return del_any;
@@ -204,17 +242,34 @@ bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
 
 void lv_anim_delete_all(void)
 {
-    lv_ll_clear_custom(anim_ll_p, remove_anim);
+    lv_anim_t * a = lv_ll_get_head(anim_ll_p);
+    while(a != NULL) {
+        /*Already deleted in `anim_timer`, only waiting to be freed*/
+        if(a->is_deleted) {
+            a = lv_ll_get_next(anim_ll_p, a);
+            continue;
+        }
+
+        remove_anim(a);
+
+        /*In `anim_timer` the animation is only marked as deleted and stays in the list.
+         *Else it's freed and `a->deleted_cb` might have changed `anim_ll_p` so start from the head*/
+        a = state.anim_timer_depth ? lv_ll_get_next(anim_ll_p, a) : lv_ll_get_head(anim_ll_p);
+    }
+
     anim_mark_list_change();
 }
 
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    LV_LL_READ(anim_ll_p, a) {
+    if(state.hash_bucket_cnt == 0) return NULL;
+
+    lv_anim_t * a = *get_bucket(var);
+    while(a) {
         if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             return a;
         }
+        a = a->hash_next;
     }
 
     return NULL;
@@ -227,11 +282,7 @@ lv_timer_t * lv_anim_get_timer(void)
 
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    LV_LL_READ(anim_ll_p, a) cnt++;
-
-    return cnt;
+    return (uint16_t)state.anim_cnt;
 }
 
 uint32_t lv_anim_speed_clamped(uint32_t speed, uint32_t min_time, uint32_t max_time)
@@ -570,8 +621,17 @@ static void anim_timer(lv_timer_t * param)
     /*Flip the run round*/
     state.anim_run_round = state.anim_run_round ? false : true;
 
+    /*While the animations are processed the deleted ones are only marked as deleted
+     *and stay in the list. This way the list can be read further from any animation.*/
+    state.anim_timer_depth++;
+
     lv_anim_t * a = lv_ll_get_head(anim_ll_p);
     while(a != NULL) {
+        if(a->is_deleted) {
+            a = lv_ll_get_next(anim_ll_p, a);
+            continue;
+        }
+
         uint32_t elaps = lv_tick_elaps(a->last_timer_run);
 
         if(a->is_paused) {
@@ -590,14 +650,12 @@ static void anim_timer(lv_timer_t * param)
         }
         a->last_timer_run = lv_tick_get();
 
-        /*It can be set by `lv_anim_delete()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_completed_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
+        /*It can be set by `lv_anim_delete()` or `lv_anim_start()` typically in `exec_cb`.
+         *If set, this animation might be deleted or replaced, so don't process it further.*/
         state.anim_list_changed = false;
 
         if(!a->is_paused && a->run_round != state.anim_run_round) {
-            a->run_round = state.anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
+            a->run_round = state.anim_run_round; /*Nested calls (e.g. `lv_anim_refr_now()`) need to know which anim has run already*/
             /*The animation will run now for the first time. Call `start_cb`*/
             if(!a->start_cb_called && a->act_time >= 0) {
 
@@ -644,14 +702,12 @@ static void anim_timer(lv_timer_t * param)
             }
         }
 
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(state.anim_list_changed)
-            a = lv_ll_get_head(anim_ll_p);
-        else
-            a = lv_ll_get_next(anim_ll_p, a);
+        /*New animations are added to the head and deleted ones stay in the list, so just go on*/
+        a = lv_ll_get_next(anim_ll_p, a);
     }
 
+    state.anim_timer_depth--;
+    if(state.anim_timer_depth == 0 && state.anim_deleted) free_deleted_anims();
 }
 
 /**
@@ -671,16 +727,9 @@ static void anim_completed_handler(lv_anim_t * a)
      * - no repeat, reverse play enabled (reverse_duration != 0) and reverse play is completed. */
     if(a->repeat_cnt == 0 && (a->reverse_duration == 0 || a->reverse_play_in_progress == 1)) {
 
-        /*Delete the animation from the list.
+        /*Delete the animation before calling the callbacks.
          * This way the `completed_cb` will see the animations like it's animation is already deleted*/
-        lv_ll_remove(anim_ll_p, a);
-        /*Flag that the list has changed*/
-        anim_mark_list_change();
-
-        /*Call the callback function at the end*/
-        if(a->completed_cb != NULL) a->completed_cb(a);
-        if(a->deleted_cb != NULL) a->deleted_cb(a);
-        lv_free(a);
+        delete_anim(a, true);
     }
     /*If the animation is not deleted then restart it*/
     else {
@@ -717,7 +766,7 @@ static void anim_vsync_event(lv_event_t * e)
 static void anim_mark_list_change(void)
 {
     state.anim_list_changed = true;
-    if(lv_ll_get_head(anim_ll_p) == NULL) {
+    if(state.anim_cnt == 0) {
         if(state.timer) {
             lv_timer_pause(state.timer);
             return;
@@ -782,9 +831,13 @@ static bool remove_concurrent_anims(const lv_anim_t * a_current)
 {
     if(a_current->exec_cb == NULL && a_current->custom_exec_cb == NULL) return false;
 
+    if(state.hash_bucket_cnt == 0) return false;
+
+    /*Only the animations of the same `var` needs to be checked*/
+    void * var = a_current->var;
     lv_anim_t * a;
     bool del_any = false;
-    a = lv_ll_get_head(anim_ll_p);
+    a = *get_bucket(var);
     while(a != NULL) {
         bool del = false;
         /*We can't test for custom_exec_cb equality because in the MicroPython binding
@@ -792,22 +845,17 @@ static bool remove_concurrent_anims(const lv_anim_t * a_current)
          *Therefore equality check would remove all animations.*/
         if(a != a_current &&
            (a->act_time >= 0 || a->early_apply) &&
-           (a->var == a_current->var) &&
+           (a->var == var) &&
            ((a->exec_cb && a->exec_cb == a_current->exec_cb)
             /*|| (a->custom_exec_cb && a->custom_exec_cb == a_current->custom_exec_cb)*/)) {
-            lv_ll_remove(anim_ll_p, a);
-            if(a->deleted_cb != NULL) a->deleted_cb(a);
-            lv_free(a);
-            /*Read by `anim_timer`. It need to know if a delete occurred in the linked list*/
-            anim_mark_list_change();
-
+            delete_anim(a, false);
             del_any = true;
             del = true;
         }
 
-        /*Always start from the head on delete, because we don't know
-         *how `anim_ll_p` was changes in `a->deleted_cb` */
-        a = del ? lv_ll_get_head(anim_ll_p) : lv_ll_get_next(anim_ll_p, a);
+        /*Always start from the head of the bucket on delete, because
+         *the animations might be changed in `a->deleted_cb` */
+        a = del ? *get_bucket(var) : a->hash_next;
     }
 
     return del_any;
@@ -815,8 +863,146 @@ static bool remove_concurrent_anims(const lv_anim_t * a_current)
 
 static void remove_anim(void * a)
 {
-    lv_anim_t * anim = a;
-    lv_ll_remove(anim_ll_p, a);
-    if(anim->deleted_cb != NULL) anim->deleted_cb(anim);
-    lv_free(a);
+    delete_anim(a, false);
+}
+
+/**
+ * Delete an animation and call its callbacks.
+ * While the animations are processed in `anim_timer` the animation is only marked as deleted
+ * and it's freed when the processing is finished.
+ * @param a             pointer to an animation
+ * @param completed     true: the animation is deleted because it's completed; call `completed_cb` too
+ */
+static void delete_anim(lv_anim_t * a, bool completed)
+{
+    hash_remove(a);
+    state.anim_cnt--;
+
+    if(state.anim_timer_depth) {
+        a->is_deleted = true;
+        state.anim_deleted = true;
+    }
+    else {
+        lv_ll_remove(anim_ll_p, a);
+    }
+
+    /*Read by `anim_timer`. It need to know if a delete occurred*/
+    anim_mark_list_change();
+
+    if(completed && a->completed_cb != NULL) a->completed_cb(a);
+    if(a->deleted_cb != NULL) a->deleted_cb(a);
+    if(!a->is_deleted) lv_free(a);
+}
+
+/**
+ * Free the animations which were deleted while the animations were processed
+ */
+static void free_deleted_anims(void)
+{
+    state.anim_deleted = false;
+
+    lv_anim_t * a = lv_ll_get_head(anim_ll_p);
+    while(a != NULL) {
+        lv_anim_t * a_next = lv_ll_get_next(anim_ll_p, a);
+        if(a->is_deleted) {
+            lv_ll_remove(anim_ll_p, a);
+            lv_free(a);
+        }
+        a = a_next;
+    }
+}
+
+/**
+ * Get the bucket of the `var` index where the animations of a variable are stored
+ * @param var   the animated variable
+ * @return      pointer to the first animation of the bucket
+ */
+static lv_anim_t ** get_bucket(const void * var)
+{
+    /*The lower bits of the pointers are usually 0 because of the alignment, so mix in the upper bits too*/
+    lv_uintptr_t h = (lv_uintptr_t)var;
+    h ^= h >> 16;
+    h ^= h >> 7;
+    return &state.hash_buckets[h & (state.hash_bucket_cnt - 1)];
+}
+
+/**
+ * Make sure that the `var` index has enough buckets for one more animation
+ * @return      false: the index couldn't be allocated
+ */
+static bool hash_reserve(void)
+{
+    if(state.hash_bucket_cnt != 0 && state.anim_cnt < state.hash_bucket_cnt) return true;
+
+    uint32_t new_cnt = state.hash_bucket_cnt ? state.hash_bucket_cnt * 2 : LV_ANIM_HASH_BUCKET_CNT_MIN;
+    lv_anim_t ** new_buckets = lv_malloc_zeroed(new_cnt * sizeof(lv_anim_t *));
+    if(new_buckets == NULL) {
+        /*Just use longer buckets if there is already an index*/
+        LV_ASSERT_MALLOC(state.hash_buckets);
+        return state.hash_buckets != NULL;
+    }
+
+    lv_anim_t ** old_buckets = state.hash_buckets;
+    uint32_t old_cnt = state.hash_bucket_cnt;
+    state.hash_buckets = new_buckets;
+    state.hash_bucket_cnt = new_cnt;
+
+    /*Move the animations to the new buckets keeping their order (newest first)*/
+    uint32_t i;
+    for(i = 0; i < old_cnt; i++) {
+        lv_anim_t * a = old_buckets[i];
+        while(a) {
+            lv_anim_t * a_next = a->hash_next;
+            lv_anim_t ** tail = get_bucket(a->var);
+            while(*tail) tail = &(*tail)->hash_next;
+            *tail = a;
+            a->hash_next = NULL;
+            a = a_next;
+        }
+    }
+
+    lv_free(old_buckets);
+    return true;
+}
+
+/**
+ * Add a new animation to the head of its bucket in the `var` index
+ * @param a     pointer to an animation
+ */
+static void hash_add(lv_anim_t * a)
+{
+    lv_anim_t ** bucket = get_bucket(a->var);
+    a->hash_next = *bucket;
+    *bucket = a;
+}
+
+/**
+ * Remove an animation from the `var` index
+ * @param a     pointer to an animation
+ */
+static void hash_remove(lv_anim_t * a)
+{
+    lv_anim_t ** link = get_bucket(a->var);
+    while(*link) {
+        if(*link == a) {
+            *link = a->hash_next;
+            a->hash_next = NULL;
+            return;
+        }
+        link = &(*link)->hash_next;
+    }
+
+    /*`var` was changed after starting the animation, so it's in an other bucket*/
+    uint32_t i;
+    for(i = 0; i < state.hash_bucket_cnt; i++) {
+        link = &state.hash_buckets[i];
+        while(*link) {
+            if(*link == a) {
+                *link = a->hash_next;
+                a->hash_next = NULL;
+                return;
+            }
+            link = &(*link)->hash_next;
+        }
+    }
 }
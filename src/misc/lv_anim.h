@@ -155,6 +155,8 @@ struct _lv_anim_t {
                                                * time animation timer executes), indicates this animation needs to be updated. */
     uint8_t start_cb_called : 1;              /**< Indicates that `start_cb` was already called */
     uint8_t early_apply  : 1;                 /**< 1: Apply start value immediately even is there is a `delay` */
+    uint8_t is_deleted : 1;                   /**< Deleted while the animations are processed, will be freed later */
+    lv_anim_t * hash_next;                    /**< Next animation in the same bucket of the `var` index */
 };
 
 /**********************
@@ -28,8 +28,15 @@ typedef struct {
     bool anim_list_changed;
     bool anim_run_round;
     bool anim_vsync_registered;
+    bool anim_deleted;              /**< Some animations were deleted in `anim_timer` and need to be freed*/
+    uint8_t anim_timer_depth;       /**< >0: the animations are being processed, deleted ones are only marked*/
     lv_timer_t * timer;
     lv_ll_t anim_ll;
+    uint32_t anim_cnt;              /**< Number of not deleted animations*/
+
+    /** Hash table of the animations by `var`. Each bucket is a list linked by `lv_anim_t::hash_next`*/
+    lv_anim_t ** hash_buckets;
+    uint32_t hash_bucket_cnt;       /**< Always a power of 2*/
 } lv_anim_state_t;
 
 /**********************
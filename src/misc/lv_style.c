@@ -19,6 +19,7 @@
 #define lv_style_custom_prop_flag_lookup_table_size LV_GLOBAL_DEFAULT()->style_custom_table_size
 #define lv_style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define last_custom_prop_id LV_GLOBAL_DEFAULT()->style_last_custom_prop_id
+#define style_generation LV_GLOBAL_DEFAULT()->style_generation
 
 /**********************
  *      TYPEDEFS
@@ -190,6 +191,13 @@ void lv_style_init(lv_style_t * style)
 }
 
 void lv_style_reset(lv_style_t * style)
+{
+    /*The widgets using this style might have cached its values*/
+    lv_style_invalidate_resolved_cache();
+    lv_style_reset_owned(style);
+}
+
+void lv_style_reset_owned(lv_style_t * style)
 {
     LV_ASSERT_STYLE(style);
 
@@ -200,6 +208,16 @@ void lv_style_reset(lv_style_t * style)
 #endif
 }
 
+void lv_style_invalidate_resolved_cache(void)
+{
+    style_generation++;
+}
+
+uint32_t lv_style_get_generation(void)
+{
+    return style_generation;
+}
+
 
 void lv_style_copy(lv_style_t * dst, const lv_style_t * src)
 {
@@ -272,6 +290,15 @@ lv_style_prop_t lv_style_get_num_custom_props(void)
 }
 
 bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
+{
+    if(!lv_style_remove_owned_prop(style, prop)) return false;
+
+    /*The widgets using this style might have cached the removed value*/
+    lv_style_invalidate_resolved_cache();
+    return true;
+}
+
+bool lv_style_remove_owned_prop(lv_style_t * style, lv_style_prop_t prop)
 {
     LV_ASSERT_STYLE(style);
 
@@ -325,6 +352,13 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
 }
 
 void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
+{
+    /*The widgets using this style might have cached the old value*/
+    lv_style_invalidate_resolved_cache();
+    lv_style_set_owned_prop(style, prop, value);
+}
+
+void lv_style_set_owned_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
 {
     LV_ASSERT_STYLE(style);
 
@@ -338,15 +372,23 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     lv_style_prop_t * props;
     int32_t i;
 
+    /*Find the first property which is not less than `prop`. The properties are kept sorted
+     *to allow binary search in `lv_style_get_prop`*/
+    int32_t idx = 0;
     if(style->values_and_props) {
         props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            if(props[i] == prop) {
-                lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
-                values[i] = value;
-                LV_PROFILER_STYLE_END;
-                return;
-            }
+        int32_t last = style->prop_cnt;
+        while(idx < last) {
+            int32_t middle = (idx + last) >> 1;
+            if(props[middle] < prop) idx = middle + 1;
+            else last = middle;
+        }
+
+        if(idx < style->prop_cnt && props[idx] == prop) {
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            values[idx] = value;
+            LV_PROFILER_STYLE_END;
+            return;
         }
     }
 
@@ -359,20 +401,25 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
 
     style->values_and_props = values_and_props;
 
+    /*Shift all props to make place for the new value before them, and leave a gap at `idx` for the new prop.
+     *Go backward because the new place of the props overlaps with the old one.*/
     props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-    /*Shift all props to make place for the value before them*/
-    for(i = style->prop_cnt - 1; i >= 0; i--) {
-        props[i + sizeof(lv_style_value_t) / sizeof(lv_style_prop_t)] = props[i];
+    lv_style_prop_t * new_props = values_and_props + (style->prop_cnt + 1) * sizeof(lv_style_value_t);
+    for(i = style->prop_cnt - 1; i >= idx; i--) {
+        new_props[i + 1] = props[i];
+    }
+    for(; i >= 0; i--) {
+        new_props[i] = props[i];
     }
-    style->prop_cnt++;
 
-    /*Go to the new position with the props*/
-    props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    /*Make place for the new value too*/
     lv_style_value_t * values = (lv_style_value_t *)values_and_props;
+    lv_memmove(&values[idx + 1], &values[idx], (style->prop_cnt - idx) * sizeof(lv_style_value_t));
+    style->prop_cnt++;
 
     /*Set the new property and value*/
-    props[style->prop_cnt - 1] = prop;
-    values[style->prop_cnt - 1] = value;
+    new_props[idx] = prop;
+    values[idx] = value;
 
     uint32_t group = lv_style_get_prop_group(prop);
     style->has_group |= (uint32_t)1 << group;
@@ -325,6 +325,8 @@ typedef struct {
     uint32_t sentinel;
 #endif
 
+    /** `prop_cnt` values followed by `prop_cnt` property IDs. The property IDs are sorted in
+     * ascending order (except in constant styles) so that they can be found with binary search.*/
     void * values_and_props;
 
     uint32_t has_group;
@@ -478,14 +480,20 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
         }
     }
     else {
+        /*The properties are sorted so use binary search*/
         lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        uint32_t i;
-        for(i = 0; i < style->prop_cnt; i++) {
-            if(props[i] == prop) {
+        uint32_t first = 0;
+        uint32_t last = style->prop_cnt;
+        while(first < last) {
+            uint32_t middle = (first + last) >> 1;
+            if(props[middle] == prop) {
                 lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
-                *value = values[i];
+                *value = values[middle];
                 return LV_STYLE_RES_FOUND;
             }
+
+            if(props[middle] < prop) first = middle + 1;
+            else last = middle;
         }
     }
     return LV_STYLE_RES_NOT_FOUND;
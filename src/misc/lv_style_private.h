@@ -28,6 +28,42 @@ extern "C" {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Mark the resolved style properties cached by all widgets as outdated.
+ * Called when a style which can be shared by many widgets changes.
+ */
+void lv_style_invalidate_resolved_cache(void);
+
+/**
+ * Get the current generation of the shared styles. It's increased by `lv_style_invalidate_resolved_cache()`.
+ * @return      the current style generation
+ */
+uint32_t lv_style_get_generation(void);
+
+/**
+ * Set a property of a style owned by a single widget (a local or transition style).
+ * Unlike `lv_style_set_prop()` it doesn't mark the resolved values of all widgets as outdated,
+ * so `lv_obj_refresh_style()` needs to be called on the owner widget.
+ * @param style     pointer to a style
+ * @param prop      the ID of a property
+ * @param value     the new value of the property
+ */
+void lv_style_set_owned_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value);
+
+/**
+ * Remove a property of a style owned by a single widget. See `lv_style_set_owned_prop()`.
+ * @param style     pointer to a style
+ * @param prop      the ID of a property
+ * @return          true: the property was found and removed; false: the property wasn't found
+ */
+bool lv_style_remove_owned_prop(lv_style_t * style, lv_style_prop_t prop);
+
+/**
+ * Clear all properties of a style owned by a single widget. See `lv_style_set_owned_prop()`.
+ * @param style     pointer to a style
+ */
+void lv_style_reset_owned(lv_style_t * style);
+
 /**********************
  *      MACROS
  **********************/
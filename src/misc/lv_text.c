@@ -47,6 +47,8 @@
     static uint32_t lv_text_iso8859_1_get_char_id(const char * txt, uint32_t byte_id);
     static uint32_t lv_text_iso8859_1_get_length(const char * txt);
 #endif
+static bool update_edited_lines(lv_text_layout_t * layout, const char * text, uint32_t text_len);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -137,6 +139,158 @@ void lv_text_get_size(lv_point_t * size_res, const char * text, const lv_font_t
         size_res->y -= line_space;
 }
 
+void lv_text_layout_init(lv_text_layout_t * layout)
+{
+    lv_memzero(layout, sizeof(lv_text_layout_t));
+}
+
+void lv_text_layout_deinit(lv_text_layout_t * layout)
+{
+    lv_free(layout->lines);
+    lv_memzero(layout, sizeof(lv_text_layout_t));
+}
+
+void lv_text_layout_invalidate(lv_text_layout_t * layout)
+{
+    layout->valid = 0;
+    layout->edited = 0;
+}
+
+bool lv_text_layout_is_up_to_date(const lv_text_layout_t * layout, const char * text, const lv_font_t * font,
+                                  int32_t letter_space, int32_t max_width, lv_text_flag_t flag)
+{
+    if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
+
+    return layout->valid && !layout->edited && layout->text == text && layout->font == font &&
+           layout->letter_space == letter_space && layout->max_width == max_width && layout->flag == flag;
+}
+
+void lv_text_layout_set_edited(lv_text_layout_t * layout, uint32_t prefix_len, uint32_t suffix_len)
+{
+    if(!layout->valid) return;
+
+    if(layout->edited) {
+        layout->edit_prefix = LV_MIN(layout->edit_prefix, prefix_len);
+        layout->edit_suffix = LV_MIN(layout->edit_suffix, suffix_len);
+    }
+    else {
+        layout->edit_prefix = prefix_len;
+        layout->edit_suffix = suffix_len;
+        layout->edited = 1;
+    }
+}
+
+bool lv_text_layout_update(lv_text_layout_t * layout, const char * text, const lv_font_t * font,
+                           int32_t letter_space, int32_t max_width, lv_text_flag_t flag)
+{
+    if(text == NULL || font == NULL) return false;
+
+    if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
+    if(lv_text_layout_is_up_to_date(layout, text, font, letter_space, max_width, flag)) return true;
+
+    bool only_edited = layout->valid && layout->edited && layout->font == font &&
+                       layout->letter_space == letter_space && layout->max_width == max_width && layout->flag == flag;
+
+    uint32_t text_len = lv_strlen(text);
+    if(only_edited) {
+        uint32_t old_len = layout->lines[layout->line_cnt].start;
+        if(layout->edit_prefix + layout->edit_suffix > LV_MIN(old_len, text_len)) only_edited = false;
+    }
+
+    /*Handle the whole text as edited if the lines can't be reused*/
+    if(!only_edited) {
+        if(layout->lines == NULL) {
+            layout->lines = lv_malloc(sizeof(lv_text_line_t));
+            LV_ASSERT_MALLOC(layout->lines);
+            if(layout->lines == NULL) return false;
+            layout->line_buf_cnt = 1;
+        }
+        lv_memzero(layout->lines, sizeof(lv_text_line_t));
+        layout->line_cnt = 0;
+        layout->edit_prefix = 0;
+        layout->edit_suffix = 0;
+    }
+
+    layout->valid = 0;
+    layout->edited = 0;
+    layout->font = font;
+    layout->letter_space = letter_space;
+    layout->max_width = max_width;
+    layout->flag = flag;
+
+    if(!update_edited_lines(layout, text, text_len)) return false;
+
+    layout->max_line_width = 0;
+    uint32_t i;
+    for(i = 0; i < layout->line_cnt; i++) {
+        layout->max_line_width = LV_MAX(layout->max_line_width, layout->lines[i].width);
+    }
+
+    layout->ends_with_new_line = text_len != 0 && (text[text_len - 1] == '\n' || text[text_len - 1] == '\r');
+    layout->text = text;
+    layout->valid = 1;
+
+    return true;
+}
+
+void lv_text_layout_get_size(const lv_text_layout_t * layout, int32_t line_space, lv_point_t * size_res)
+{
+    int32_t letter_height = lv_font_get_line_height(layout->font);
+    uint32_t line_cnt = layout->line_cnt;
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if(layout->ends_with_new_line) line_cnt++;
+
+    size_res->x = layout->max_line_width;
+    if(line_cnt == 0) size_res->y = letter_height;
+    else size_res->y = (int32_t)line_cnt * (letter_height + line_space) - line_space;
+}
+
+uint32_t lv_text_layout_get_line_of_byte(const lv_text_layout_t * layout, uint32_t byte_id)
+{
+    if(layout->line_cnt == 0) return 0;
+
+    /*Binary search for the last line starting before `byte_id`*/
+    uint32_t min = 0;
+    uint32_t max = layout->line_cnt - 1;
+    while(min < max) {
+        uint32_t mid = (min + max + 1) / 2;
+        if(layout->lines[mid].start <= byte_id) min = mid;
+        else max = mid - 1;
+    }
+
+    return min;
+}
+
+uint32_t lv_text_layout_get_byte_id(const lv_text_layout_t * layout, const char * text, uint32_t char_id)
+{
+    if(!layout->valid || layout->edited || layout->text != text || layout->line_cnt == 0) {
+        return lv_text_encoded_get_byte_id(text, char_id);
+    }
+
+    /*Binary search for the last line starting before `char_id`*/
+    uint32_t min = 0;
+    uint32_t max = layout->line_cnt - 1;
+    while(min < max) {
+        uint32_t mid = (min + max + 1) / 2;
+        if(layout->lines[mid].char_start <= char_id) min = mid;
+        else max = mid - 1;
+    }
+
+    const lv_text_line_t * line = &layout->lines[min];
+    return line->start + lv_text_encoded_get_byte_id(&text[line->start], char_id - line->char_start);
+}
+
+uint32_t lv_text_layout_get_char_id(const lv_text_layout_t * layout, const char * text, uint32_t byte_id)
+{
+    if(!layout->valid || layout->edited || layout->text != text) {
+        return lv_text_encoded_get_char_id(text, byte_id);
+    }
+
+    const lv_text_line_t * line = &layout->lines[lv_text_layout_get_line_of_byte(layout, byte_id)];
+    return line->char_start + lv_text_encoded_get_char_id(&text[line->start], byte_id - line->start);
+}
+
 bool lv_text_is_cmd(lv_text_cmd_state_t * state, uint32_t c)
 {
     bool ret = false;
@@ -542,6 +696,116 @@ void lv_text_encoded_letter_next_2(const char * txt, uint32_t * letter, uint32_t
     *letter_next = *letter != '\0' ? lv_text_encoded_next(&txt[*ofs], NULL) : 0;
 }
 
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Break the edited paragraph of a text into lines again and keep the other lines.
+ * `edit_prefix` and `edit_suffix` of `layout` tell which part of the text is unchanged.
+ * @param layout    pointer to a text layout with the lines of the text before the edit
+ * @param text      the edited text
+ * @param text_len  length of `text` in bytes
+ * @return          true: the lines are updated; false: out of memory
+ */
+static bool update_edited_lines(lv_text_layout_t * layout, const char * text, uint32_t text_len)
+{
+    lv_text_line_t * lines = layout->lines;
+    uint32_t old_len = lines[layout->line_cnt].start;
+    uint32_t edit_end = text_len - layout->edit_suffix;  /*End of the changed part in the new text*/
+    uint32_t delta = text_len - old_len;                 /*Wraps around if the text is shorter*/
+
+    /*The words of the edited line can be moved to the previous line, so start from the paragraph*/
+    uint32_t first = lv_text_layout_get_line_of_byte(layout, layout->edit_prefix);
+    while(first > 0 && text[lines[first].start - 1] != '\n' && text[lines[first].start - 1] != '\r') {
+        first--;
+    }
+
+    lv_text_line_t * new_lines = NULL;
+    uint32_t new_cnt = 0;
+    uint32_t new_buf_cnt = 0;
+    uint32_t line_start = lines[first].start;
+    uint32_t char_start = lines[first].char_start;
+    uint32_t tail = layout->line_cnt;
+    while(1) {
+        /*Keep one more line to store the end of the text*/
+        if(new_cnt + 1 >= new_buf_cnt) {
+            new_buf_cnt = new_buf_cnt ? new_buf_cnt * 2 : 8;
+            lv_text_line_t * tmp = lv_realloc(new_lines, new_buf_cnt * sizeof(lv_text_line_t));
+            LV_ASSERT_MALLOC(tmp);
+            if(tmp == NULL) {
+                lv_free(new_lines);
+                return false;
+            }
+            new_lines = tmp;
+        }
+
+        if(line_start >= edit_end) {
+            if(line_start >= text_len) break;
+
+            /*From the start of an old line in the unchanged end of the text the lines are the same as before*/
+            uint32_t old_start = line_start - delta;
+            uint32_t i = lv_text_layout_get_line_of_byte(layout, old_start);
+            if(lines[i].start == old_start) {
+                tail = i;
+                break;
+            }
+        }
+
+        uint32_t line_len = lv_text_get_next_line(&text[line_start], LV_TEXT_LEN_MAX, layout->font,
+                                                  layout->letter_space, layout->max_width, NULL, layout->flag);
+        if(line_len == 0) break;
+
+        lv_text_line_t * line = &new_lines[new_cnt];
+        line->start = line_start;
+        line->char_start = char_start;
+        line->width = lv_text_get_width_with_flags(&text[line_start], line_len, layout->font, layout->letter_space,
+                                                   layout->flag);
+        new_cnt++;
+        line_start += line_len;
+        char_start += lv_text_encoded_get_char_id(&text[line->start], line_len);
+    }
+
+    /*The whole text is broken again, so simply use the new lines*/
+    if(first == 0 && tail == layout->line_cnt) {
+        new_lines[new_cnt].start = line_start;
+        new_lines[new_cnt].char_start = char_start;
+        new_lines[new_cnt].width = 0;
+        lv_free(layout->lines);
+        layout->lines = new_lines;
+        layout->line_cnt = new_cnt;
+        layout->line_buf_cnt = new_buf_cnt;
+        return true;
+    }
+
+    /*Insert the new lines between the kept lines*/
+    uint32_t tail_cnt = layout->line_cnt - tail;
+    uint32_t cnt = first + new_cnt + tail_cnt;
+    if(cnt + 1 > layout->line_buf_cnt) {
+        lines = lv_realloc(layout->lines, (cnt + 1) * sizeof(lv_text_line_t));
+        LV_ASSERT_MALLOC(lines);
+        if(lines == NULL) {
+            lv_free(new_lines);
+            return false;
+        }
+        layout->lines = lines;
+        layout->line_buf_cnt = cnt + 1;
+    }
+
+    uint32_t char_delta = char_start - lines[tail].char_start;
+    lv_memmove(&lines[first + new_cnt], &lines[tail], (tail_cnt + 1) * sizeof(lv_text_line_t));
+    uint32_t i;
+    for(i = first + new_cnt; i <= cnt; i++) {
+        lines[i].start += delta;
+        lines[i].char_start += char_delta;
+    }
+    if(new_cnt) lv_memcpy(&lines[first], new_lines, new_cnt * sizeof(lv_text_line_t));
+    layout->line_cnt = cnt;
+
+    lv_free(new_lines);
+    return true;
+}
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 /*******************************
  *   UTF-8 ENCODER/DECODER
@@ -250,6 +250,19 @@ void lv_text_ap_proc(const char * txt, char * txt_out)
     *(txt_out_temp) = '\0';
     lv_free(ch_enc);
 }
+
+bool lv_text_ap_has_chars(const char * txt)
+{
+    /*U+0600..U+06FF starts with 0xD8..0xDB, the presentation forms (U+FB40..U+FEFF) with 0xEF 0xAD..0xBB*/
+    while(*txt) {
+        uint8_t c = (uint8_t)txt[0];
+        if(c >= 0xD8 && c <= 0xDB) return true;
+        if(c == 0xEF && (uint8_t)txt[1] >= 0xAD && (uint8_t)txt[1] <= 0xBB) return true;
+        txt++;
+    }
+
+    return false;
+}
 /**********************
 *   STATIC FUNCTIONS
 **********************/
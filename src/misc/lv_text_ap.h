@@ -36,6 +36,13 @@ extern "C" {
 uint32_t lv_text_ap_calc_bytes_count(const char * txt);
 void lv_text_ap_proc(const char * txt, char * txt_out);
 
+/**
+ * Check if a text has letters which can be changed by `lv_text_ap_proc()`
+ * @param txt   pointer to a text
+ * @return      true: the text has Arabic or Persian letters (or their presentation forms)
+ */
+bool lv_text_ap_has_chars(const char * txt);
+
 /**********************
  *      MACROS
  **********************/
@@ -24,6 +24,38 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** A line of a text broken by `lv_text_layout_update()`*/
+typedef struct {
+    uint32_t start;             /**< Byte index of the first character of the line*/
+    uint32_t char_start;        /**< Character index of the first character of the line*/
+    int32_t width;              /**< Width of the line in pixels*/
+} lv_text_line_t;
+
+/**
+ * The lines of a text. They are calculated once and can be reused
+ * until the text or the parameters of the calculation change.
+ */
+struct _lv_text_layout_t {
+    lv_text_line_t * lines;     /**< `line_cnt + 1` lines. The last one stores only the length of the text*/
+    uint32_t line_cnt;          /**< Number of lines*/
+    uint32_t line_buf_cnt;      /**< Number of allocated lines*/
+    int32_t max_line_width;     /**< Width of the longest line*/
+
+    /*The parameters of the last calculation*/
+    const char * text;
+    const lv_font_t * font;
+    int32_t letter_space;
+    int32_t max_width;
+    lv_text_flag_t flag;
+
+    uint32_t edit_prefix;       /**< Length of the unchanged beginning of the edited text*/
+    uint32_t edit_suffix;       /**< Length of the unchanged end of the edited text*/
+
+    uint8_t valid : 1;          /**< 1: the lines are calculated and the text hasn't changed since*/
+    uint8_t edited : 1;         /**< 1: only a part of the text has changed, see `edit_prefix` and `edit_suffix`*/
+    uint8_t ends_with_new_line : 1; /**< 1: the text ends with '\n' or '\r'*/
+};
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -45,6 +77,96 @@ extern "C" {
 uint32_t lv_text_get_next_line(const char * txt, uint32_t len, const lv_font_t * font, int32_t letter_space,
                                int32_t max_width, int32_t * used_width, lv_text_flag_t flag);
 
+/**
+ * Initialize a text layout
+ * @param layout        pointer to a text layout
+ */
+void lv_text_layout_init(lv_text_layout_t * layout);
+
+/**
+ * Free the lines of a text layout
+ * @param layout        pointer to a text layout
+ */
+void lv_text_layout_deinit(lv_text_layout_t * layout);
+
+/**
+ * Mark the lines as outdated. Should be called when the text is changed.
+ * @param layout        pointer to a text layout
+ */
+void lv_text_layout_invalidate(lv_text_layout_t * layout);
+
+/**
+ * Tell that only a part of the text has changed since the lines were calculated.
+ * The next `lv_text_layout_update()` breaks only the edited paragraph into lines again.
+ * Can be called multiple times between two updates.
+ * @param layout        pointer to a text layout
+ * @param prefix_len    number of bytes not changed at the beginning of the text
+ * @param suffix_len    number of bytes not changed at the end of the text
+ */
+void lv_text_layout_set_edited(lv_text_layout_t * layout, uint32_t prefix_len, uint32_t suffix_len);
+
+/**
+ * Check if the lines of a text layout were calculated with the given parameters
+ * @param layout        pointer to a text layout
+ * @param text          a '\0' terminated string
+ * @param font          pointer to a font
+ * @param letter_space  letter space
+ * @param max_width     max width of the text. Not used with `LV_TEXT_FLAG_EXPAND`
+ * @param flag          settings for the text from `lv_text_flag_t`
+ * @return              true: the lines can be used as they are
+ */
+bool lv_text_layout_is_up_to_date(const lv_text_layout_t * layout, const char * text, const lv_font_t * font,
+                                  int32_t letter_space, int32_t max_width, lv_text_flag_t flag);
+
+/**
+ * Break a text into lines and measure the lines.
+ * Nothing happens if the lines were already calculated with the same parameters,
+ * and only the edited paragraph is processed if `lv_text_layout_set_edited()` was called.
+ * @param layout        pointer to a text layout
+ * @param text          a '\0' terminated string
+ * @param font          pointer to a font
+ * @param letter_space  letter space
+ * @param max_width     max width of the text (break the lines to fit this size)
+ * @param flag          settings for the text from `lv_text_flag_t`
+ * @return              true: the lines are calculated; false: out of memory
+ */
+bool lv_text_layout_update(lv_text_layout_t * layout, const char * text, const lv_font_t * font,
+                           int32_t letter_space, int32_t max_width, lv_text_flag_t flag);
+
+/**
+ * Get the size of the text from its calculated lines. Gives the same result as `lv_text_get_size()`.
+ * @param layout        pointer to an up-to-date text layout
+ * @param line_space    line space
+ * @param size_res      store the result here
+ */
+void lv_text_layout_get_size(const lv_text_layout_t * layout, int32_t line_space, lv_point_t * size_res);
+
+/**
+ * Get the line where a character is
+ * @param layout        pointer to an up-to-date text layout
+ * @param byte_id       byte index of the character
+ * @return              index of the line. The last line if `byte_id` is after the end of the text.
+ */
+uint32_t lv_text_layout_get_line_of_byte(const lv_text_layout_t * layout, uint32_t byte_id);
+
+/**
+ * Convert a character index to byte index using the lines to scan only a part of the text
+ * @param layout        pointer to a text layout
+ * @param text          the text. If the layout is not up-to-date for it the whole text is scanned.
+ * @param char_id       character index
+ * @return              byte index of the `char_id`th character
+ */
+uint32_t lv_text_layout_get_byte_id(const lv_text_layout_t * layout, const char * text, uint32_t char_id);
+
+/**
+ * Convert a byte index to character index using the lines to scan only a part of the text
+ * @param layout        pointer to a text layout
+ * @param text          the text. If the layout is not up-to-date for it the whole text is scanned.
+ * @param byte_id       byte index
+ * @return              character index of the character at `byte_id`
+ */
+uint32_t lv_text_layout_get_char_id(const lv_text_layout_t * layout, const char * text, uint32_t byte_id);
+
 /**
  * Insert a string into another
  * @param txt_buf the original text (must be big enough for the result text and NULL terminated)
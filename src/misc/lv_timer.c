@@ -33,7 +33,13 @@
  **********************/
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static uint32_t time_remaining_at(const lv_timer_t * timer, uint32_t now);
 static void lv_timer_handler_resume(void);
+static void heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_update(lv_timer_t * timer);
+static void heap_sift_up(uint32_t index, uint32_t now);
+static void heap_sift_down(uint32_t index, uint32_t now);
 
 /**********************
  *  STATIC VARIABLES
@@ -90,43 +96,51 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    lv_timer_t * timer_active;
-    lv_ll_t * timer_head = timer_ll_p;
-    do {
-        state_p->timer_deleted             = false;
-        state_p->timer_created             = false;
-
-        timer_active = lv_ll_get_head(timer_head);
-        while(timer_active) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = lv_ll_get_next(timer_head, timer_active);
-
-            if(lv_timer_exec(timer_active)) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(state_p->timer_created || state_p->timer_deleted) {
-                    LV_TRACE_TIMER("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
+    /*Take the ready timers out of the heap and run them from the newest one.
+     *They are put back only at the end, so a timer runs only once in a call even if its period is 0.
+     *The timers created or made ready by the timer callbacks are taken out and run in the next round.
+     *Deleted timers are only marked as deleted while they are pending, so nothing needs to be restarted.*/
+    uint32_t i;
+    state_p->pending_cnt = 0;
+    while(state_p->heap_cnt && lv_timer_time_remaining(state_p->heap[0]) == 0) {
+        uint32_t round_start = state_p->pending_cnt;
+        while(state_p->heap_cnt && lv_timer_time_remaining(state_p->heap[0]) == 0) {
+            lv_timer_t * timer = state_p->heap[0];
+            heap_remove(timer);
+            timer->pending = 1;
+
+            /*Keep the timers of this round in the order of creation (newest first)*/
+            i = state_p->pending_cnt;
+            while(i > round_start && state_p->pending[i - 1]->id < timer->id) {
+                state_p->pending[i] = state_p->pending[i - 1];
+                i--;
             }
-
-            timer_active = next; /*Load the next timer*/
+            state_p->pending[i] = timer;
+            state_p->pending_cnt++;
         }
-    } while(timer_active);
 
-    uint32_t time_until_next = LV_NO_TIMER_READY;
-    next = lv_ll_get_head(timer_head);
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_until_next)
-                time_until_next = delay;
+        /*`state_p->pending` might be reallocated if a timer is created in a timer callback*/
+        for(i = round_start; i < state_p->pending_cnt; i++) {
+            lv_timer_t * timer = state_p->pending[i];
+            if(!timer->deleted) lv_timer_exec(timer);
         }
+    }
 
-        next = lv_ll_get_next(timer_head, next); /*Find the next timer*/
+    for(i = 0; i < state_p->pending_cnt; i++) {
+        lv_timer_t * timer = state_p->pending[i];
+        timer->pending = 0;
+        if(timer->deleted) {
+            state_p->timer_cnt--;
+            lv_free(timer);
+        }
+        else if(!timer->paused) {
+            heap_insert(timer);
+        }
     }
+    state_p->pending_cnt = 0;
+
+    uint32_t time_until_next = LV_NO_TIMER_READY;
+    if(state_p->heap_cnt) time_until_next = lv_timer_time_remaining(state_p->heap[0]);
 
     state_p->busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(state_p->idle_period_start);
@@ -166,6 +180,22 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    /*Make sure that all the timers fit into the heap or the pending timers*/
+    if(state.timer_cnt >= state.buf_size) {
+        uint32_t new_size = state.buf_size ? state.buf_size * 2 : 8;
+        lv_timer_t ** new_heap = lv_realloc(state.heap, new_size * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_heap);
+        if(new_heap == NULL) return NULL;
+        state.heap = new_heap;
+
+        lv_timer_t ** new_pending = lv_realloc(state.pending, new_size * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_pending);
+        if(new_pending == NULL) return NULL;
+        state.pending = new_pending;
+
+        state.buf_size = new_size;
+    }
+
     new_timer = lv_ll_ins_head(timer_ll_p);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -177,8 +207,12 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
+    new_timer->pending = 0;
+    new_timer->deleted = 0;
+    new_timer->id = ++state.last_id;
 
-    state.timer_created = true;
+    state.timer_cnt++;
+    heap_insert(new_timer);
 
     lv_timer_handler_resume();
 
@@ -194,8 +228,15 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 void lv_timer_delete(lv_timer_t * timer)
 {
     lv_ll_remove(timer_ll_p, timer);
-    state.timer_deleted = true;
+    if(timer->heap_index != LV_TIMER_HEAP_INDEX_NONE) heap_remove(timer);
+
+    /*`lv_timer_handler()` still refers to the pending timers so it will free them*/
+    if(timer->pending) {
+        timer->deleted = 1;
+        return;
+    }
 
+    state.timer_cnt--;
     lv_free(timer);
 }
 
@@ -203,12 +244,15 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+    if(timer->heap_index != LV_TIMER_HEAP_INDEX_NONE) heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = false;
+    /*The pending timers are put back to the heap by `lv_timer_handler()`*/
+    if(timer->heap_index == LV_TIMER_HEAP_INDEX_NONE && !timer->pending) heap_insert(timer);
     lv_timer_handler_resume();
 }
 
@@ -216,12 +260,14 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+    if(timer->heap_index != LV_TIMER_HEAP_INDEX_NONE) heap_update(timer);
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+    if(timer->heap_index != LV_TIMER_HEAP_INDEX_NONE) heap_update(timer);
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
@@ -246,6 +292,7 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+    if(timer->heap_index != LV_TIMER_HEAP_INDEX_NONE) heap_update(timer);
     lv_timer_handler_resume();
 }
 
@@ -260,6 +307,15 @@ void lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     lv_ll_clear(timer_ll_p);
+
+    lv_free(state.heap);
+    lv_free(state.pending);
+    state.heap = NULL;
+    state.pending = NULL;
+    state.heap_cnt = 0;
+    state.pending_cnt = 0;
+    state.timer_cnt = 0;
+    state.buf_size = 0;
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -328,7 +384,7 @@ static bool lv_timer_exec(lv_timer_t * timer)
             LV_PROFILER_TIMER_END_TAG("timer_cb");
         }
 
-        if(!state.timer_deleted) {
+        if(!timer->deleted) {
             LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
         }
         else {
@@ -339,7 +395,7 @@ static bool lv_timer_exec(lv_timer_t * timer)
         exec = true;
     }
 
-    if(state.timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    if(!timer->deleted) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             if(timer->auto_delete) {
                 LV_TRACE_TIMER("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
@@ -361,9 +417,22 @@ static bool lv_timer_exec(lv_timer_t * timer)
  * @return the time remaining, or 0 if it needs to be run again
  */
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
+{
+    return time_remaining_at(timer, lv_tick_get());
+}
+
+/**
+ * Find out how much time remains at a given tick before a timer must be run.
+ * The time remaining is a non-decreasing function of the time of the next run, so the
+ * heap stays ordered even if it's compared at different ticks and the ticks overflow.
+ * @param timer pointer to lv_timer
+ * @param now   the current tick (not earlier than `timer->last_run`)
+ * @return the time remaining, or 0 if it needs to be run again
+ */
+static uint32_t time_remaining_at(const lv_timer_t * timer, uint32_t now)
 {
     /*Check if at least 'period' time elapsed*/
-    uint32_t elp = lv_tick_elaps(timer->last_run);
+    uint32_t elp = now - timer->last_run;
     if(elp >= timer->period)
         return 0;
     return timer->period - elp;
@@ -386,3 +455,96 @@ void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data
     state.resume_cb = cb;
     state.resume_data = data;
 }
+
+/**
+ * Add a timer to the heap. `lv_timer_create` ensures that there is space for it.
+ * @param timer pointer to a timer which is not in the heap
+ */
+static void heap_insert(lv_timer_t * timer)
+{
+    LV_ASSERT(state.heap_cnt < state.buf_size);
+
+    uint32_t index = state.heap_cnt;
+    state.heap[index] = timer;
+    timer->heap_index = index;
+    state.heap_cnt++;
+    heap_sift_up(index, lv_tick_get());
+}
+
+/**
+ * Remove a timer from the heap
+ * @param timer pointer to a timer in the heap
+ */
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t index = timer->heap_index;
+    timer->heap_index = LV_TIMER_HEAP_INDEX_NONE;
+    state.heap_cnt--;
+    if(index == state.heap_cnt) return;
+
+    /*Move the last timer to the place of the removed one and restore the heap*/
+    lv_timer_t * last = state.heap[state.heap_cnt];
+    state.heap[index] = last;
+    last->heap_index = index;
+    heap_update(last);
+}
+
+/**
+ * Move a timer to its place in the heap after the time of its next run has changed
+ * @param timer pointer to a timer in the heap
+ */
+static void heap_update(lv_timer_t * timer)
+{
+    uint32_t now = lv_tick_get();
+    uint32_t index = timer->heap_index;
+    heap_sift_up(index, now);
+    /*If it wasn't moved up it might need to be moved down*/
+    if(timer->heap_index == index) heap_sift_down(index, now);
+}
+
+static void heap_sift_up(uint32_t index, uint32_t now)
+{
+    lv_timer_t ** heap = state.heap;
+    lv_timer_t * timer = heap[index];
+    uint32_t remaining = time_remaining_at(timer, now);
+    while(index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if(time_remaining_at(heap[parent], now) <= remaining) break;
+
+        heap[index] = heap[parent];
+        heap[index]->heap_index = index;
+        index = parent;
+    }
+
+    heap[index] = timer;
+    timer->heap_index = index;
+}
+
+static void heap_sift_down(uint32_t index, uint32_t now)
+{
+    lv_timer_t ** heap = state.heap;
+    lv_timer_t * timer = heap[index];
+    uint32_t remaining = time_remaining_at(timer, now);
+    while(1) {
+        uint32_t child = index * 2 + 1;
+        if(child >= state.heap_cnt) break;
+
+        uint32_t child_remaining = time_remaining_at(heap[child], now);
+        if(child + 1 < state.heap_cnt) {
+            uint32_t right_remaining = time_remaining_at(heap[child + 1], now);
+            if(right_remaining < child_remaining) {
+                child++;
+                child_remaining = right_remaining;
+            }
+        }
+
+        if(remaining <= child_remaining) break;
+
+        heap[index] = heap[child];
+        heap[index]->heap_index = index;
+        index = child;
+    }
+
+    heap[index] = timer;
+    timer->heap_index = index;
+}
@@ -20,6 +20,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** `heap_index` of the timers which are not in the timer heap (paused or being run)*/
+#define LV_TIMER_HEAP_INDEX_NONE    UINT32_MAX
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,17 +36,31 @@ struct _lv_timer_t {
     lv_timer_cb_t timer_cb;    /**< Timer function */
     void * user_data;          /**< Custom user data */
     int32_t repeat_count;      /**< 1: One time;  -1 : infinity;  n>0: residual times */
+    uint32_t id;               /**< Creation order. Ready timers are run from the newest one*/
+    uint32_t heap_index;       /**< Index in the timer heap or `LV_TIMER_HEAP_INDEX_NONE`*/
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
+    uint32_t pending : 1;      /**< 1: taken out of the heap by `lv_timer_handler()` to run it*/
+    uint32_t deleted : 1;      /**< 1: deleted while pending, `lv_timer_handler()` will free it*/
 };
 
 typedef struct {
     lv_ll_t timer_ll;          /**< Linked list to store the lv_timers */
 
+    /** Binary min-heap of the not paused timers ordered by the time of their next run*/
+    lv_timer_t ** heap;
+    uint32_t heap_cnt;
+
+    /** The timers taken out of the heap by `lv_timer_handler()`*/
+    lv_timer_t ** pending;
+    uint32_t pending_cnt;
+
+    uint32_t timer_cnt;        /**< Number of timers, including the deleted but not yet freed ones*/
+    uint32_t buf_size;         /**< `heap` and `pending` have space for this many timers*/
+    uint32_t last_id;
+
     bool lv_timer_run;
     uint8_t idle_last;
-    bool timer_deleted;
-    bool timer_created;
     uint32_t timer_time_until_next;
 
     bool already_running;
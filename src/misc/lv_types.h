@@ -177,6 +177,8 @@ typedef struct _lv_draw_mask_t lv_draw_mask_t;
 
 typedef struct _lv_draw_label_hint_t lv_draw_label_hint_t;
 
+typedef struct _lv_text_layout_t lv_text_layout_t;
+
 typedef struct _lv_draw_glyph_dsc_t lv_draw_glyph_dsc_t;
 
 typedef struct _lv_draw_image_sup_t lv_draw_image_sup_t;
@@ -185,6 +187,10 @@ typedef struct _lv_draw_mask_rect_dsc_t lv_draw_mask_rect_dsc_t;
 
 typedef struct _lv_obj_style_t lv_obj_style_t;
 
+typedef struct _lv_obj_style_resolved_t lv_obj_style_resolved_t;
+
+typedef struct _lv_obj_style_resolved_cache_t lv_obj_style_resolved_cache_t;
+
 typedef struct _lv_obj_style_transition_dsc_t lv_obj_style_transition_dsc_t;
 
 typedef struct _lv_hit_test_info_t lv_hit_test_info_t;
@@ -56,6 +56,9 @@ static void set_ofs_y_anim(void * obj, int32_t v);
 static size_t get_text_length(const char * text);
 static void copy_text_to_label(lv_label_t * label, const char * text);
 static lv_text_flag_t get_label_flags(lv_label_t * label);
+static const lv_text_layout_t * get_text_layout(lv_obj_t * obj);
+static void set_text_edited(lv_label_t * label, uint32_t prefix_len, uint32_t suffix_len);
+static uint32_t get_line_at_y(const lv_text_layout_t * layout, int32_t y, int32_t letter_height, int32_t line_space);
 static void calculate_x_coordinate(int32_t * x, const lv_text_align_t align, const char * txt,
                                    uint32_t length, const lv_font_t * font, int32_t letter_space, lv_area_t * txt_coords, lv_text_flag_t flags);
 
@@ -169,6 +172,7 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         label->static_txt = 0;
     }
 
+    lv_text_layout_invalidate(&label->text_layout);
     lv_label_refr_text(obj);
 }
 
@@ -180,6 +184,8 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
     lv_obj_invalidate(obj);
     lv_label_t * label = (lv_label_t *)obj;
 
+    lv_text_layout_invalidate(&label->text_layout);
+
     /*If text is NULL then refresh*/
     if(fmt == NULL) {
         lv_label_refr_text(obj);
@@ -215,6 +221,7 @@ void lv_label_set_text_static(lv_obj_t * obj, const char * text)
         label->text       = (char *)text;
     }
 
+    lv_text_layout_invalidate(&label->text_layout);
     lv_label_refr_text(obj);
 }
 
@@ -236,6 +243,7 @@ void lv_label_set_long_mode(lv_obj_t * obj, lv_label_long_mode_t long_mode)
         label->expand = 0;
 
     label->long_mode = long_mode;
+    lv_text_layout_invalidate(&label->text_layout);
     lv_label_refr_text(obj);
 }
 
@@ -328,7 +336,9 @@ void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t
 
     lv_text_flag_t flag = get_label_flags(label);
 
-    const uint32_t byte_id = lv_text_encoded_get_byte_id(txt, char_id);
+    const lv_text_layout_t * layout = get_text_layout((lv_obj_t *)obj);
+    const uint32_t byte_id = layout ? lv_text_layout_get_byte_id(layout, txt, char_id) :
+                             lv_text_encoded_get_byte_id(txt, char_id);
     /*Search the line of the index letter*/
     const int32_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
     const int32_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
@@ -344,16 +354,25 @@ void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t
     int32_t y = 0;
     uint32_t line_start = 0;
     uint32_t new_line_start = 0;
-    while(txt[new_line_start] != '\0') {
-        bool last_line = y + letter_height + line_space + letter_height > max_h;
-        if(last_line && label->long_mode == LV_LABEL_LONG_MODE_DOTS) flag |= LV_TEXT_FLAG_BREAK_ALL;
+    if(layout) {
+        uint32_t line_idx = lv_text_layout_get_line_of_byte(layout, byte_id);
+        line_start = layout->lines[line_idx].start;
+        new_line_start = layout->lines[line_idx + 1].start;
+        y = (int32_t)line_idx * (letter_height + line_space);
+    }
+    else {
+        while(txt[new_line_start] != '\0') {
+            bool last_line = y + letter_height + line_space + letter_height > max_h;
+            if(last_line && label->long_mode == LV_LABEL_LONG_MODE_DOTS) flag |= LV_TEXT_FLAG_BREAK_ALL;
 
-        new_line_start += lv_text_get_next_line(&txt[line_start], LV_TEXT_LEN_MAX, font, letter_space, max_w, NULL, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
+            new_line_start += lv_text_get_next_line(&txt[line_start], LV_TEXT_LEN_MAX, font, letter_space, max_w, NULL,
+                                                    flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
 
-        y += letter_height + line_space;
-        line_start = new_line_start;
+            y += letter_height + line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -434,26 +453,45 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in, bool
     lv_text_flag_t flag = get_label_flags(label);
 
     /*Search the line of the index letter*/;
-    while(txt[line_start] != '\0') {
-        /*If dots will be shown, break the last visible line anywhere,
-         *not only at word boundaries.*/
-        bool last_line = y + letter_height + line_space + letter_height > max_h;
-        if(last_line && label->long_mode == LV_LABEL_LONG_MODE_DOTS) flag |= LV_TEXT_FLAG_BREAK_ALL;
-
-        new_line_start += lv_text_get_next_line(&txt[line_start], LV_TEXT_LEN_MAX, font, letter_space, max_w, NULL, flag);
-
-        if(pos.y <= y + letter_height) {
-            /*The line is found (stored in 'line_start')*/
+    const lv_text_layout_t * layout = get_text_layout((lv_obj_t *)obj);
+    if(layout) {
+        uint32_t line_idx = get_line_at_y(layout, pos.y, letter_height, line_space);
+        line_start = layout->lines[line_idx].start;
+        if(line_idx < layout->line_cnt) {
+            new_line_start = layout->lines[line_idx + 1].start;
             /*Include the NULL terminator in the last line*/
             uint32_t tmp = new_line_start;
             uint32_t letter;
             letter = lv_text_encoded_prev(txt, &tmp);
             if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
-            break;
         }
-        y += letter_height + line_space;
+        else {
+            new_line_start = line_start;
+        }
+    }
+    else {
+        while(txt[line_start] != '\0') {
+            /*If dots will be shown, break the last visible line anywhere,
+             *not only at word boundaries.*/
+            bool last_line = y + letter_height + line_space + letter_height > max_h;
+            if(last_line && label->long_mode == LV_LABEL_LONG_MODE_DOTS) flag |= LV_TEXT_FLAG_BREAK_ALL;
+
+            new_line_start += lv_text_get_next_line(&txt[line_start], LV_TEXT_LEN_MAX, font, letter_space, max_w, NULL,
+                                                    flag);
+
+            if(pos.y <= y + letter_height) {
+                /*The line is found (stored in 'line_start')*/
+                /*Include the NULL terminator in the last line*/
+                uint32_t tmp = new_line_start;
+                uint32_t letter;
+                letter = lv_text_encoded_prev(txt, &tmp);
+                if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
+                break;
+            }
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
     char * bidi_txt;
@@ -532,7 +570,8 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in, bool
         logical_pos = lv_text_encoded_get_char_id(bidi_txt, i);
     }
 
-    return  logical_pos + lv_text_encoded_get_char_id(txt, line_start);
+    if(layout) return logical_pos + lv_text_layout_get_char_id(layout, txt, line_start);
+    else return logical_pos + lv_text_encoded_get_char_id(txt, line_start);
 }
 
 bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
@@ -557,31 +596,40 @@ bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
 
     /*Search the line of the index letter*/
     int32_t y = 0;
-    while(txt[line_start] != '\0') {
-        bool last_line = y + letter_height + line_space + letter_height > max_h;
-        if(last_line && label->long_mode == LV_LABEL_LONG_MODE_DOTS) flag |= LV_TEXT_FLAG_BREAK_ALL;
+    uint32_t line_idx = 0;
+    const lv_text_layout_t * layout = get_text_layout((lv_obj_t *)obj);
+    if(layout) {
+        line_idx = get_line_at_y(layout, pos->y, letter_height, line_space);
+        line_start = layout->lines[line_idx].start;
+        new_line_start = line_idx < layout->line_cnt ? layout->lines[line_idx + 1].start : line_start;
+    }
+    else {
+        while(txt[line_start] != '\0') {
+            bool last_line = y + letter_height + line_space + letter_height > max_h;
+            if(last_line && label->long_mode == LV_LABEL_LONG_MODE_DOTS) flag |= LV_TEXT_FLAG_BREAK_ALL;
 
-        new_line_start += lv_text_get_next_line(&txt[line_start], LV_TEXT_LEN_MAX, font, letter_space, max_w, NULL, flag);
+            new_line_start += lv_text_get_next_line(&txt[line_start], LV_TEXT_LEN_MAX, font, letter_space, max_w, NULL,
+                                                    flag);
 
-        if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
-        y += letter_height + line_space;
+            if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
     /*Calculate the x coordinate*/
     const lv_text_align_t align = lv_obj_calculate_style_text_align(obj, LV_PART_MAIN, label->text);
 
     int32_t x = 0;
-    if(align == LV_TEXT_ALIGN_CENTER) {
-        const int32_t line_w = lv_text_get_width_with_flags(&txt[line_start], new_line_start - line_start, font, letter_space,
-                                                            flag);
-        x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
-    }
-    else if(align == LV_TEXT_ALIGN_RIGHT) {
-        const int32_t line_w = lv_text_get_width_with_flags(&txt[line_start], new_line_start - line_start, font, letter_space,
-                                                            flag);
-        x += lv_area_get_width(&txt_coords) - line_w;
+    if(align == LV_TEXT_ALIGN_CENTER || align == LV_TEXT_ALIGN_RIGHT) {
+        int32_t line_w;
+        if(layout) line_w = layout->lines[line_idx].width;
+        else line_w = lv_text_get_width_with_flags(&txt[line_start], new_line_start - line_start, font, letter_space,
+                                                       flag);
+
+        if(align == LV_TEXT_ALIGN_CENTER) x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
+        else x += lv_area_get_width(&txt_coords) - line_w;
     }
 
     lv_text_cmd_state_t cmd_state = LV_TEXT_CMD_STATE_WAIT;
@@ -673,16 +721,39 @@ void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt)
     size_t old_len = lv_strlen(label->text);
     size_t ins_len = lv_strlen(txt);
     size_t new_len = ins_len + old_len;
+
+#if LV_USE_ARABIC_PERSIAN_CHARS
+    /*The processing can change the letters around the inserted text too*/
+    if(lv_text_ap_has_chars(txt) || lv_text_ap_has_chars(label->text)) {
+        label->text        = lv_realloc(label->text, new_len + 1);
+        LV_ASSERT_MALLOC(label->text);
+        if(label->text == NULL) return;
+
+        if(pos == LV_LABEL_POS_LAST) {
+            pos = lv_text_get_encoded_length(label->text);
+        }
+
+        lv_text_ins(label->text, pos, txt);
+        lv_label_set_text(obj, NULL);
+        return;
+    }
+#endif
+
+    /*Use the lines to find the byte position before the text is moved*/
+    uint32_t byte_pos;
+    if(pos == LV_LABEL_POS_LAST) byte_pos = old_len;
+    else byte_pos = LV_MIN(lv_text_layout_get_byte_id(&label->text_layout, label->text, pos), old_len);
+
     label->text        = lv_realloc(label->text, new_len + 1);
     LV_ASSERT_MALLOC(label->text);
     if(label->text == NULL) return;
 
-    if(pos == LV_LABEL_POS_LAST) {
-        pos = lv_text_get_encoded_length(label->text);
-    }
+    lv_memmove(&label->text[byte_pos + ins_len], &label->text[byte_pos], old_len - byte_pos + 1);
+    lv_memcpy(&label->text[byte_pos], txt, ins_len);
 
-    lv_text_ins(label->text, pos, txt);
-    lv_label_set_text(obj, NULL);
+    /*Only the lines of the edited paragraph need to be updated*/
+    set_text_edited(label, byte_pos, old_len - byte_pos);
+    lv_label_refr_text(obj);
 }
 
 void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
@@ -696,8 +767,11 @@ void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
     lv_obj_invalidate(obj);
 
     char * label_txt = lv_label_get_text(obj);
+    uint32_t byte_pos = lv_text_layout_get_byte_id(&label->text_layout, label_txt, pos);
+
     /*Delete the characters*/
     lv_text_cut(label_txt, pos, cnt);
+    set_text_edited(label, byte_pos, lv_strlen(label_txt) - byte_pos);
 
     /*Refresh the label*/
     lv_label_refr_text(obj);
@@ -720,6 +794,7 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->dot_begin  = LV_LABEL_DOT_BEGIN_INV;
     label->long_mode  = LV_LABEL_LONG_MODE_WRAP;
     lv_point_set(&label->offset, 0, 0);
+    lv_text_layout_init(&label->text_layout);
 
 #if LV_LABEL_LONG_TXT_HINT
     label->hint.line_start = -1;
@@ -745,6 +820,7 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_t * label = (lv_label_t *)obj;
 
     if(!label->static_txt) lv_free(label->text);
+    lv_text_layout_deinit(&label->text_layout);
     label->text = NULL;
 }
 
@@ -759,7 +835,14 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
     const lv_event_code_t code = lv_event_get_code(e);
     lv_obj_t * obj = lv_event_get_current_target(e);
 
-    if((code == LV_EVENT_STYLE_CHANGED) || (code == LV_EVENT_SIZE_CHANGED)) {
+    if(code == LV_EVENT_STYLE_CHANGED) {
+        /*The metrics of the font might have changed even if the font pointer is the same
+         *(e.g. a resized TinyTTF font) so break the lines again*/
+        lv_label_t * label = (lv_label_t *)obj;
+        lv_text_layout_invalidate(&label->text_layout);
+        lv_label_refr_text(obj);
+    }
+    else if(code == LV_EVENT_SIZE_CHANGED) {
         lv_label_refr_text(obj);
     }
     else if(code == LV_EVENT_REFR_EXT_DRAW_SIZE) {
@@ -824,6 +907,7 @@ static void draw_main(lv_event_t * e)
     label_draw_dsc.ofs_x = label->offset.x;
     label_draw_dsc.ofs_y = label->offset.y;
     label_draw_dsc.text_size = label->text_size;
+    label_draw_dsc.text_layout = get_text_layout(obj);
 #if LV_LABEL_LONG_TXT_HINT
     if(label->long_mode != LV_LABEL_LONG_MODE_SCROLL_CIRCULAR &&
        lv_area_get_height(&txt_coords) >= LV_LABEL_HINT_HEIGHT_LIMIT) {
@@ -964,7 +1048,9 @@ static void lv_label_refr_text(lv_obj_t * obj)
     lv_text_flag_t flag = get_label_flags(label);
 
     lv_label_revert_dots(obj);
-    lv_text_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    const lv_text_layout_t * layout = get_text_layout(obj);
+    if(layout) lv_text_layout_get_size(layout, line_space, &size);
+    else lv_text_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
     label->text_size = size;
 
     lv_obj_refresh_self_size(obj);
@@ -1290,6 +1376,61 @@ static lv_text_flag_t get_label_flags(lv_label_t * label)
     return flag;
 }
 
+/**
+ * Get the lines of the label's text. They are calculated only if the text or
+ * the parameters of the line breaking have changed since the last call.
+ * @param obj   pointer to a label
+ * @return      the lines or NULL if they can't be used (e.g. the text is modified by the dots)
+ */
+static const lv_text_layout_t * get_text_layout(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+    /*The dots change the text and the last line is broken differently*/
+    if(label->long_mode == LV_LABEL_LONG_MODE_DOTS) return NULL;
+
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    const int32_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    const int32_t max_w = lv_obj_get_content_width(obj);
+    if(!lv_text_layout_update(&label->text_layout, label->text, font, letter_space, max_w, get_label_flags(label))) {
+        return NULL;
+    }
+
+    return &label->text_layout;
+}
+
+/**
+ * Tell that only a part of the text has changed, so only the lines around it will be broken again
+ * @param label         pointer to a label
+ * @param prefix_len    number of bytes not changed at the beginning of the text
+ * @param suffix_len    number of bytes not changed at the end of the text
+ */
+static void set_text_edited(lv_label_t * label, uint32_t prefix_len, uint32_t suffix_len)
+{
+    /*The dots were written into the text so it's not known what was there before*/
+    if(label->long_mode == LV_LABEL_LONG_MODE_DOTS) lv_text_layout_invalidate(&label->text_layout);
+    else lv_text_layout_set_edited(&label->text_layout, prefix_len, suffix_len);
+}
+
+/**
+ * Get the line at a y coordinate without breaking the text again
+ * @param layout        the lines of the text
+ * @param y             y coordinate relative to the top of the text
+ * @param letter_height height of the lines
+ * @param line_space    space between the lines
+ * @return              index of the line or `layout->line_cnt` if `y` is below the text
+ */
+static uint32_t get_line_at_y(const lv_text_layout_t * layout, int32_t y, int32_t letter_height, int32_t line_space)
+{
+    /*A line is hit if `y` is above its bottom*/
+    int32_t dist = y - letter_height;
+    int32_t line_h = letter_height + line_space;
+    if(dist <= 0 || line_h <= 0) return 0;
+
+    uint32_t line_idx = (dist + line_h - 1) / line_h;
+    return LV_MIN(line_idx, layout->line_cnt);
+}
+
 /* Function created because of this pattern be used in multiple functions */
 static void calculate_x_coordinate(int32_t * x, const lv_text_align_t align, const char * txt, uint32_t length,
                                    const lv_font_t * font, int32_t letter_space, lv_area_t * txt_coords, lv_text_flag_t flags)
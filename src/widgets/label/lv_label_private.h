@@ -16,6 +16,7 @@ extern "C" {
 
 #include "../../draw/lv_draw_label_private.h"
 #include "../../core/lv_obj_private.h"
+#include "../../misc/lv_text_private.h"
 #include "lv_label.h"
 
 #if LV_USE_LABEL != 0
@@ -38,6 +39,8 @@ struct _lv_label_t {
     lv_draw_label_hint_t hint;
 #endif
 
+    lv_text_layout_t text_layout;       /**< The lines of the text shared by the measurements and the drawing */
+
 #if LV_LABEL_TEXT_SELECTION
     uint32_t sel_start;
     uint32_t sel_end;
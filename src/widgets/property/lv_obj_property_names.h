@@ -15,7 +15,7 @@
     extern const lv_property_name_t lv_image_property_names[11];
     extern const lv_property_name_t lv_keyboard_property_names[4];
     extern const lv_property_name_t lv_label_property_names[4];
-    extern const lv_property_name_t lv_obj_property_names[73];
+    extern const lv_property_name_t lv_obj_property_names[74];
     extern const lv_property_name_t lv_roller_property_names[3];
     extern const lv_property_name_t lv_slider_property_names[8];
     extern const lv_property_name_t lv_style_property_names[120];
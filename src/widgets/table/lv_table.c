@@ -47,6 +47,7 @@ static size_t get_cell_txt_len(const char * txt);
 static void copy_cell_txt(lv_table_cell_t * dst, const char * txt);
 static void get_cell_area(lv_obj_t * obj, uint32_t row, uint32_t col, lv_area_t * area);
 static void scroll_to_selected_cell(lv_obj_t * obj);
+static void free_cells(lv_table_t * table);
 
 static inline bool is_cell_empty(void * cell)
 {
@@ -95,6 +96,11 @@ void lv_table_set_cell_value(lv_obj_t * obj, uint32_t row, uint32_t col, const c
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(table->cell_value_cb) {
+        LV_LOG_WARN("the cells can't be set in virtual mode");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_column_count(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_count(obj, row + 1);
@@ -129,6 +135,11 @@ void lv_table_set_cell_value_fmt(lv_obj_t * obj, uint32_t row, uint32_t col, con
     LV_ASSERT_NULL(fmt);
 
     lv_table_t * table = (lv_table_t *)obj;
+
+    if(table->cell_value_cb) {
+        LV_LOG_WARN("the cells can't be set in virtual mode");
+        return;
+    }
     if(col >= table->col_cnt) {
         lv_table_set_column_count(obj, col + 1);
     }
@@ -211,6 +222,12 @@ void lv_table_set_row_count(lv_obj_t * obj, uint32_t row_cnt)
     uint32_t old_row_cnt = table->row_cnt;
     table->row_cnt         = row_cnt;
 
+    /*Only the number of rows is stored in virtual mode*/
+    if(table->cell_value_cb) {
+        refr_size_form_row(obj, 0);
+        return;
+    }
+
     table->row_h = lv_realloc(table->row_h, table->row_cnt * sizeof(table->row_h[0]));
     LV_ASSERT_MALLOC(table->row_h);
     if(table->row_h == NULL) return;
@@ -254,40 +271,44 @@ void lv_table_set_column_count(lv_obj_t * obj, uint32_t col_cnt)
     uint32_t old_col_cnt = table->col_cnt;
     table->col_cnt         = col_cnt;
 
-    lv_table_cell_t ** new_cell_data = lv_malloc(table->row_cnt * table->col_cnt * sizeof(lv_table_cell_t *));
-    LV_ASSERT_MALLOC(new_cell_data);
-    if(new_cell_data == NULL) return;
-    uint32_t new_cell_cnt = table->col_cnt * table->row_cnt;
-
-    lv_memzero(new_cell_data, new_cell_cnt * sizeof(table->cell_data[0]));
-
-    /*The new column(s) messes up the mapping of `cell_data`*/
-    uint32_t old_col_start;
-    uint32_t new_col_start;
-    uint32_t min_col_cnt = LV_MIN(old_col_cnt, col_cnt);
-    uint32_t row;
-    for(row = 0; row < table->row_cnt; row++) {
-        old_col_start = row * old_col_cnt;
-        new_col_start = row * col_cnt;
-
-        lv_memcpy(&new_cell_data[new_col_start], &table->cell_data[old_col_start],
-                  sizeof(new_cell_data[0]) * min_col_cnt);
-
-        /*Free the old cells (only if the table becomes smaller)*/
-        int32_t i;
-        for(i = 0; i < (int32_t)old_col_cnt - (int32_t)col_cnt; i++) {
-            uint32_t idx = old_col_start + min_col_cnt + i;
-            if(table->cell_data[idx] && table->cell_data[idx]->user_data) {
-                lv_free(table->cell_data[idx]->user_data);
-                table->cell_data[idx]->user_data = NULL;
+    /*No cells are stored in virtual mode*/
+    if(table->cell_value_cb == NULL) {
+        lv_table_cell_t ** new_cell_data = lv_malloc(table->row_cnt * table->col_cnt * sizeof(lv_table_cell_t *));
+        LV_ASSERT_MALLOC(new_cell_data);
+        if(new_cell_data == NULL) return;
+        uint32_t new_cell_cnt = table->col_cnt * table->row_cnt;
+
+        lv_memzero(new_cell_data, new_cell_cnt * sizeof(table->cell_data[0]));
+
+        /*The new column(s) messes up the mapping of `cell_data`*/
+        uint32_t old_col_start;
+        uint32_t new_col_start;
+        uint32_t min_col_cnt = LV_MIN(old_col_cnt, col_cnt);
+        uint32_t row;
+        for(row = 0; row < table->row_cnt; row++) {
+            old_col_start = row * old_col_cnt;
+            new_col_start = row * col_cnt;
+
+            lv_memcpy(&new_cell_data[new_col_start], &table->cell_data[old_col_start],
+                      sizeof(new_cell_data[0]) * min_col_cnt);
+
+            /*Free the old cells (only if the table becomes smaller)*/
+            int32_t i;
+            for(i = 0; i < (int32_t)old_col_cnt - (int32_t)col_cnt; i++) {
+                uint32_t idx = old_col_start + min_col_cnt + i;
+                if(table->cell_data[idx] && table->cell_data[idx]->user_data) {
+                    lv_free(table->cell_data[idx]->user_data);
+                    table->cell_data[idx]->user_data = NULL;
+                }
+                lv_free(table->cell_data[idx]);
+                table->cell_data[idx] = NULL;
             }
-            lv_free(table->cell_data[idx]);
-            table->cell_data[idx] = NULL;
         }
-    }
 
-    lv_free(table->cell_data);
-    table->cell_data = new_cell_data;
+        lv_free(table->cell_data);
+        table->cell_data = new_cell_data;
+
+    }
 
     /*Initialize the new column widths if any*/
     table->col_w = lv_realloc(table->col_w, col_cnt * sizeof(table->col_w[0]));
@@ -321,6 +342,11 @@ void lv_table_set_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_table
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(table->cell_value_cb) {
+        LV_LOG_WARN("the cells can't be set in virtual mode");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_column_count(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_count(obj, row + 1);
@@ -347,6 +373,11 @@ void lv_table_clear_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_tab
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(table->cell_value_cb) {
+        LV_LOG_WARN("the cells can't be set in virtual mode");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_column_count(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_count(obj, row + 1);
@@ -372,6 +403,11 @@ void lv_table_set_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col, voi
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(table->cell_value_cb) {
+        LV_LOG_WARN("the cells can't be set in virtual mode");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_column_count(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_count(obj, row + 1);
@@ -395,7 +431,34 @@ void lv_table_set_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col, voi
     table->cell_data[cell]->user_data = user_data;
 }
 
-void lv_table_set_selected_cell(lv_obj_t * obj, uint16_t row, uint16_t col)
+void lv_table_set_cell_value_cb(lv_obj_t * obj, lv_table_cell_value_cb_t cb)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_table_t * table = (lv_table_t *)obj;
+
+    if(table->cell_value_cb == cb) return;
+
+    if(table->cell_value_cb == NULL) {
+        free_cells(table);
+    }
+    else if(cb == NULL) {
+        /*Create empty cells again*/
+        table->cell_data = lv_calloc(table->row_cnt * table->col_cnt, sizeof(lv_table_cell_t *));
+        LV_ASSERT_MALLOC(table->cell_data);
+        table->row_h = lv_malloc(table->row_cnt * sizeof(table->row_h[0]));
+        LV_ASSERT_MALLOC(table->row_h);
+        if(table->cell_data == NULL || table->row_h == NULL) {
+            free_cells(table);
+            return;
+        }
+    }
+
+    table->cell_value_cb = cb;
+    refr_size_form_row(obj, 0);
+}
+
+void lv_table_set_selected_cell(lv_obj_t * obj, uint32_t row, uint32_t col)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
@@ -428,6 +491,11 @@ const char * lv_table_get_cell_value(lv_obj_t * obj, uint32_t row, uint32_t col)
         LV_LOG_WARN("invalid row or column");
         return "";
     }
+    if(table->cell_value_cb) {
+        const char * txt = table->cell_value_cb(obj, row, col);
+        return txt ? txt : "";
+    }
+
     uint32_t cell = row * table->col_cnt + col;
 
     if(is_cell_empty(table->cell_data[cell])) return "";
@@ -474,6 +542,8 @@ bool lv_table_has_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_table
         LV_LOG_WARN("invalid row or column");
         return false;
     }
+    if(table->cell_value_cb) return false;
+
     uint32_t cell = row * table->col_cnt + col;
 
     if(is_cell_empty(table->cell_data[cell])) return false;
@@ -496,6 +566,8 @@ void * lv_table_get_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col)
         LV_LOG_WARN("invalid row or column");
         return NULL;
     }
+    if(table->cell_value_cb) return NULL;
+
     uint32_t cell = row * table->col_cnt + col;
 
     if(is_cell_empty(table->cell_data[cell])) return NULL;
@@ -532,21 +604,7 @@ static void lv_table_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 {
     LV_UNUSED(class_p);
     lv_table_t * table = (lv_table_t *)obj;
-    /*Free the cell texts*/
-    uint32_t i;
-    for(i = 0; i < table->col_cnt * table->row_cnt; i++) {
-        if(table->cell_data[i]) {
-            if(table->cell_data[i]->user_data) {
-                lv_free(table->cell_data[i]->user_data);
-                table->cell_data[i]->user_data = NULL;
-            }
-            lv_free(table->cell_data[i]);
-            table->cell_data[i] = NULL;
-        }
-    }
-
-    if(table->cell_data) lv_free(table->cell_data);
-    if(table->row_h) lv_free(table->row_h);
+    free_cells(table);
     if(table->col_w) lv_free(table->col_w);
 }
 
@@ -574,7 +632,12 @@ static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
         for(i = 0; i < table->col_cnt; i++) w += table->col_w[i];
 
         int32_t h = 0;
-        for(i = 0; i < table->row_cnt; i++) h += table->row_h[i];
+        if(table->cell_value_cb) {
+            h = table->row_cnt * table->virtual_row_h;
+        }
+        else {
+            for(i = 0; i < table->row_cnt; i++) h += table->row_h[i];
+        }
 
         p->x = w - 1;
         p->y = h - 1;
@@ -709,7 +772,7 @@ static void draw_main(lv_event_t * e)
     obj->skip_trans = 0;
 
     uint32_t col;
-    uint32_t row;
+    uint32_t row = 0;
     uint32_t cell = 0;
 
     cell_area.y2 = obj->coords.y1 + bg_top - 1 - lv_obj_get_scroll_y(obj) + border_width;
@@ -718,9 +781,16 @@ static void draw_main(lv_event_t * e)
     int32_t scroll_x = lv_obj_get_scroll_x(obj) ;
     bool rtl = lv_obj_get_style_base_dir(obj, LV_PART_MAIN) == LV_BASE_DIR_RTL;
 
+    /*In virtual mode all rows have the same height so jump to the first visible row*/
+    if(table->cell_value_cb && table->virtual_row_h > 0 && clip_area.y1 > cell_area.y2 + 1) {
+        row = (clip_area.y1 - cell_area.y2 - 1) / table->virtual_row_h;
+        if(row > table->row_cnt) row = table->row_cnt;
+        cell_area.y2 += row * table->virtual_row_h;
+    }
+
     /*Handle custom drawer*/
-    for(row = 0; row < table->row_cnt; row++) {
-        int32_t h_row = table->row_h[row];
+    for(; row < table->row_cnt; row++) {
+        int32_t h_row = table->cell_value_cb ? table->virtual_row_h : table->row_h[row];
 
         cell_area.y1 = cell_area.y2 + 1;
         cell_area.y2 = cell_area.y1 + h_row - 1;
@@ -732,7 +802,8 @@ static void draw_main(lv_event_t * e)
 
         for(col = 0; col < table->col_cnt; col++) {
             lv_table_cell_ctrl_t ctrl = 0;
-            if(table->cell_data[cell]) ctrl = table->cell_data[cell]->ctrl;
+            if(table->cell_value_cb) ctrl = LV_TABLE_CELL_CTRL_TEXT_CROP;
+            else if(table->cell_data[cell]) ctrl = table->cell_data[cell]->ctrl;
 
             if(rtl) {
                 cell_area.x2 = cell_area.x1 - 1;
@@ -744,7 +815,7 @@ static void draw_main(lv_event_t * e)
             }
 
             uint32_t col_merge = 0;
-            for(col_merge = 0; col_merge + col < table->col_cnt - 1; col_merge++) {
+            for(col_merge = 0; table->cell_data && col_merge + col < table->col_cnt - 1; col_merge++) {
                 lv_table_cell_t * next_cell_data = table->cell_data[cell + col_merge];
 
                 if(is_cell_empty(next_cell_data)) break;
@@ -818,7 +889,17 @@ static void draw_main(lv_event_t * e)
 
             lv_draw_rect(layer, &rect_dsc_act, &cell_area_border);
 
-            if(table->cell_data[cell]) {
+            /*In virtual mode the text is fetched only for the visible cells and copied for the draw task*/
+            const char * cell_txt = NULL;
+            if(table->cell_value_cb) {
+                cell_txt = table->cell_value_cb(obj, row, col);
+                label_dsc_act.text_local = 1;
+            }
+            else if(table->cell_data[cell]) {
+                cell_txt = table->cell_data[cell]->txt;
+            }
+
+            if(cell_txt) {
                 const int32_t cell_left = lv_obj_get_style_pad_left(obj, LV_PART_ITEMS);
                 const int32_t cell_right = lv_obj_get_style_pad_right(obj, LV_PART_ITEMS);
                 const int32_t cell_top = lv_obj_get_style_pad_top(obj, LV_PART_ITEMS);
@@ -838,7 +919,7 @@ static void draw_main(lv_event_t * e)
                     label_dsc_act.flag |= LV_TEXT_FLAG_EXPAND;
                 }
 
-                lv_text_get_size(&txt_size, table->cell_data[cell]->txt, label_dsc_def.font,
+                lv_text_get_size(&txt_size, cell_txt, label_dsc_def.font,
                                  label_dsc_act.letter_space, label_dsc_act.line_space,
                                  lv_area_get_width(&txt_area), txt_flags);
 
@@ -853,7 +934,7 @@ static void draw_main(lv_event_t * e)
                 label_mask_ok = lv_area_intersect(&label_clip_area, &clip_area, &cell_area);
                 if(label_mask_ok) {
                     layer->_clip_area = label_clip_area;
-                    label_dsc_act.text = table->cell_data[cell]->txt;
+                    label_dsc_act.text = cell_txt;
                     lv_draw_label(layer, &label_dsc_act, &txt_area);
                     layer->_clip_area = clip_area;
                 }
@@ -883,6 +964,15 @@ static void refr_size_form_row(lv_obj_t * obj, uint32_t start_row)
     const int32_t maxh = lv_obj_get_style_max_height(obj, LV_PART_ITEMS);
 
     lv_table_t * table = (lv_table_t *)obj;
+
+    /*All rows are cropped to one line in virtual mode*/
+    if(table->cell_value_cb) {
+        table->virtual_row_h = LV_CLAMP(minh, lv_font_get_line_height(font) + cell_pad_top + cell_pad_bottom, maxh);
+        lv_obj_refresh_self_size(obj);
+        lv_obj_invalidate(obj);
+        return;
+    }
+
     uint32_t i;
     for(i = start_row; i < table->row_cnt; i++) {
         int32_t calculated_height = get_row_height(obj, i, font, letter_space, line_space,
@@ -1041,11 +1131,17 @@ static lv_result_t get_pressed_cell(lv_obj_t * obj, uint32_t * row, uint32_t * c
         *row = 0;
         tmp = 0;
 
-        for(*row = 0; *row < table->row_cnt; (*row)++) {
-            tmp += table->row_h[*row];
-            if(y < tmp) {
-                is_click_on_valid_row = true;
-                break;
+        if(table->cell_value_cb) {
+            if(table->virtual_row_h > 0 && y >= 0) *row = y / table->virtual_row_h;
+            is_click_on_valid_row = *row < table->row_cnt;
+        }
+        else {
+            for(*row = 0; *row < table->row_cnt; (*row)++) {
+                tmp += table->row_h[*row];
+                if(y < tmp) {
+                    is_click_on_valid_row = true;
+                    break;
+                }
             }
         }
     }
@@ -1097,7 +1193,7 @@ static void get_cell_area(lv_obj_t * obj, uint32_t row, uint32_t col, lv_area_t
      * exit the traversal when the current cell control is not LV_TABLE_CELL_CTRL_MERGE_RIGHT */
     uint32_t col_merge = 0;
     int32_t offset = 0;
-    for(col_merge = 0; col_merge + col < table->col_cnt - 1; col_merge++) {
+    for(col_merge = 0; table->cell_data && col_merge + col < table->col_cnt - 1; col_merge++) {
         lv_table_cell_t * next_cell_data = table->cell_data[row * table->col_cnt + col_merge];
 
         if(is_cell_empty(next_cell_data)) break;
@@ -1124,14 +1220,22 @@ static void get_cell_area(lv_obj_t * obj, uint32_t row, uint32_t col, lv_area_t
     }
 
     uint32_t r;
+    int32_t row_h;
     area->y1 = 0;
-    for(r = 0; r < row; r++) {
-        area->y1 += table->row_h[r];
+    if(table->cell_value_cb) {
+        area->y1 = row * table->virtual_row_h;
+        row_h = table->virtual_row_h;
+    }
+    else {
+        for(r = 0; r < row; r++) {
+            area->y1 += table->row_h[r];
+        }
+        row_h = table->row_h[row];
     }
 
     area->y1 += lv_obj_get_style_pad_top(obj, 0);
     area->y1 -= lv_obj_get_scroll_y(obj);
-    area->y2 = area->y1 + table->row_h[row] - 1;
+    area->y2 = area->y1 + row_h - 1;
 
 }
 
@@ -1156,4 +1260,30 @@ static void scroll_to_selected_cell(lv_obj_t * obj)
     }
 
 }
+
+/* Free the cells with their user data and the row heights */
+static void free_cells(lv_table_t * table)
+{
+    if(table->cell_data) {
+        uint32_t i;
+        for(i = 0; i < table->col_cnt * table->row_cnt; i++) {
+            if(table->cell_data[i]) {
+                if(table->cell_data[i]->user_data) {
+                    lv_free(table->cell_data[i]->user_data);
+                    table->cell_data[i]->user_data = NULL;
+                }
+                lv_free(table->cell_data[i]);
+                table->cell_data[i] = NULL;
+            }
+        }
+
+        lv_free(table->cell_data);
+        table->cell_data = NULL;
+    }
+
+    if(table->row_h) {
+        lv_free(table->row_h);
+        table->row_h = NULL;
+    }
+}
 #endif
@@ -43,6 +43,15 @@ typedef enum {
     LV_TABLE_CELL_CTRL_CUSTOM_4    = 1 << 7,
 } lv_table_cell_ctrl_t;
 
+/**
+ * Get the text of a cell in virtual mode.
+ * @param obj       pointer to a Table object
+ * @param row       id of the row [0 .. row_cnt -1]
+ * @param col       id of the column [0 .. col_cnt -1]
+ * @return          text of the cell. It needs to be valid only until the next call.
+ */
+typedef const char * (*lv_table_cell_value_cb_t)(lv_obj_t * obj, uint32_t row, uint32_t col);
+
 LV_ATTRIBUTE_EXTERN_DATA extern const lv_obj_class_t lv_table_class;
 
 /**********************
@@ -133,13 +142,25 @@ void lv_table_clear_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_tab
  */
 void lv_table_set_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col, void * user_data);
 
+/**
+ * Get the cell values from a callback instead of storing them in the table (virtual mode).
+ * The callback is called only for the visible cells and the memory usage doesn't depend on the number of rows.
+ * All rows have the same height (line height of the font and the paddings of `LV_PART_ITEMS`)
+ * and the texts are drawn in a single line.
+ * @param obj       pointer to a Table object
+ * @param cb        the callback returning the text of a cell or NULL to store the cells again
+ * @note            The stored cells, their control bits and user data are deleted when the callback is set.
+ *                  While the callback is set the cell values, control bits and user data can't be set.
+ */
+void lv_table_set_cell_value_cb(lv_obj_t * obj, lv_table_cell_value_cb_t cb);
+
 /**
  * Set the selected cell
  * @param obj       pointer to a table object
  * @param row       id of the cell row to select
  * @param col       id of the cell column to select
  */
-void lv_table_set_selected_cell(lv_obj_t * obj, uint16_t row, uint16_t col);
+void lv_table_set_selected_cell(lv_obj_t * obj, uint32_t row, uint32_t col);
 
 /*=====================
  * Getter functions
@@ -44,6 +44,8 @@ struct _lv_table_t {
     int32_t * col_w;
     uint32_t col_act;
     uint32_t row_act;
+    lv_table_cell_value_cb_t cell_value_cb; /**< Get the cell values in virtual mode*/
+    int32_t virtual_row_h;                  /**< Height of all rows in virtual mode*/
 };
 
 
@@ -18,6 +18,7 @@
 #include "../../misc/lv_assert.h"
 #include "../../misc/lv_anim_private.h"
 #include "../../misc/lv_text_private.h"
+#include "../../misc/lv_text_ap.h"
 #include "../../misc/lv_math.h"
 #include "../../stdlib/lv_string.h"
 
@@ -56,6 +57,7 @@ static void pwd_char_hider(lv_obj_t * obj);
 static bool char_is_accepted(lv_obj_t * obj, uint32_t c);
 static void start_cursor_blink(lv_obj_t * obj);
 static void refr_cursor_area(lv_obj_t * obj);
+static uint32_t get_text_char_cnt(lv_obj_t * obj);
 static void update_cursor_position_on_click(lv_event_t * e);
 static lv_result_t insert_handler(lv_obj_t * obj, const char * txt);
 static void draw_placeholder(lv_event_t * e);
@@ -330,13 +332,14 @@ void lv_textarea_delete_char(lv_obj_t * obj)
     lv_result_t res = insert_handler(obj, del_buf);
     if(res != LV_RESULT_OK) return;
 
-    char * label_txt = lv_label_get_text(ta->label);
+    /*Delete a character. Only its paragraph will be broken into lines again.*/
+    lv_label_cut_text(ta->label, ta->cursor.pos - 1, 1);
 
-    /*Delete a character*/
-    lv_text_cut(label_txt, ta->cursor.pos - 1, 1);
-
-    /*Refresh the label*/
-    lv_label_set_text(ta->label, label_txt);
+#if LV_USE_ARABIC_PERSIAN_CHARS
+    /*Process the letters around the deleted one again*/
+    const char * label_txt = lv_label_get_text(ta->label);
+    if(lv_text_ap_has_chars(label_txt)) lv_label_set_text(ta->label, label_txt);
+#endif
     lv_textarea_clear_selection(obj);
 
     /*If the textarea became empty, invalidate it to hide the placeholder*/
@@ -455,7 +458,7 @@ void lv_textarea_set_cursor_pos(lv_obj_t * obj, int32_t pos)
     lv_textarea_t * ta = (lv_textarea_t *)obj;
     if((uint32_t)ta->cursor.pos == (uint32_t)pos) return;
 
-    uint32_t len = lv_text_get_encoded_length(lv_label_get_text(ta->label));
+    uint32_t len = get_text_char_cnt(obj);
 
     if(pos < 0) pos = len + pos;
 
@@ -1169,6 +1172,19 @@ static void start_cursor_blink(lv_obj_t * obj)
     }
 }
 
+/**
+ * Get the number of characters in the text. The lines cached by the label are used
+ * to not decode the whole text.
+ * @param obj   pointer to a text area
+ * @return      number of characters
+ */
+static uint32_t get_text_char_cnt(lv_obj_t * obj)
+{
+    lv_textarea_t * ta = (lv_textarea_t *)obj;
+    lv_label_t * label = (lv_label_t *)ta->label;
+    return lv_text_layout_get_char_id(&label->text_layout, label->text, lv_strlen(label->text));
+}
+
 static void refr_cursor_area(lv_obj_t * obj)
 {
     lv_textarea_t * ta = (lv_textarea_t *)obj;
@@ -1179,7 +1195,7 @@ static void refr_cursor_area(lv_obj_t * obj)
     uint32_t cur_pos = lv_textarea_get_cursor_pos(obj);
     const char * txt = lv_label_get_text(ta->label);
 
-    uint32_t byte_pos = lv_text_encoded_get_byte_id(txt, cur_pos);
+    uint32_t byte_pos = lv_text_layout_get_byte_id(&((lv_label_t *)ta->label)->text_layout, txt, cur_pos);
     uint32_t letter = lv_text_encoded_next(&txt[byte_pos], NULL);
 
     /* Letter height and width */
@@ -22,7 +22,12 @@ extern "C" {
 #define LV_USE_STDLIB_SPRINTF       LV_STDLIB_CLIB
 #define LV_USE_OS                   LV_OS_PTHREAD
 #define LV_OBJ_STYLE_CACHE          0
+#define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE    (64 * 1024)
 #define LV_BIN_DECODER_RAM_LOAD     1   /* Run test with bin image loaded to RAM */
+#define LV_USE_IMAGE_DECODER_ASYNC  1
+#ifdef __SSE2__
+#define LV_USE_DRAW_SW_ASM          LV_DRAW_SW_ASM_SSE2
+#endif
 #endif
 
 #ifdef LVGL_CI_USING_DEF_HEAP
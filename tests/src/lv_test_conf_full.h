@@ -2,7 +2,9 @@
 #define LV_TEST_CONF_FULL_H
 
 #define LV_MEM_SIZE                     (32 * 1024 * 1024)
-#define LV_DRAW_SW_SHADOW_CACHE_SIZE    8
+#define LV_DRAW_SW_SHADOW_CACHE_SIZE    64  /*test_draw_box_shadow.c needs up to 35 px large corners*/
+#define LV_DRAW_SW_GRAD_CACHE_SIZE      (8 * 1024)  /*Disabled by default, enable it for test_draw_grad_cache.c*/
+#define LV_OBJ_STYLE_RESOLVED_CACHE_SIZE    16  /*Disabled by default, enable it for test_style.c*/
 #define LV_DRAW_THREAD_STACK_SIZE    (64 * 1024) /*Increase stack size to 64KB in order to run ThorVG*/
 #define LV_USE_LOG              1
 #define LV_LOG_LEVEL            LV_LOG_LEVEL_TRACE
@@ -14,6 +16,9 @@
 #define LV_USE_ASSERT_STYLE             1
 #define LV_USE_FLOAT      1
 #define LV_USE_MATRIX     1
+#define LV_USE_OCCLUSION_CULLING 1
+#define LV_USE_SCROLL_SHIFT 1
+#define LV_DRAW_LAYER_CACHE_MAX_MEMORY (4 * 1024 * 1024)
 
 #define LV_FONT_MONTSERRAT_8    1
 #define LV_FONT_MONTSERRAT_10   1
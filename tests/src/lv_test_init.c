@@ -24,6 +24,11 @@ void lv_test_init(void)
     lv_test_display_create(HOR_RES, VER_RES);
     lv_test_indev_create_all();
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+    /*The reference images expect the images to be drawn in the first frame*/
+    lv_image_decoder_set_async(false);
+#endif
+
 #if LV_USE_GESTURE_RECOGNITION
     lv_test_indev_gesture_create();
 #endif
@@ -6,6 +6,10 @@
 
 #include "unity/unity.h"
 
+#if LV_USE_OS == LV_OS_PTHREAD
+#include <unistd.h>
+#endif
+
 static uint32_t MEM_SIZE = 0;
 
 // Cache size in bytes
@@ -151,4 +155,155 @@ void test_cache_1(void)
     TEST_ASSERT_EQUAL(40, lv_cache_get_free_size(cache, NULL));
 }
 
+static bool create_fail_cb(test_data * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+    return false;
+}
+
+void test_cache_acquire_or_create_fail(void)
+{
+    lv_cache_set_create_cb(cache, (lv_cache_create_cb_t)create_fail_cb, NULL);
+
+    test_data search_key = {
+        .slot.size = 16,
+        .key1 = 1,
+        .key2 = 2
+    };
+
+    TEST_ASSERT_NULL(lv_cache_acquire_or_create(cache, &search_key, NULL));
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(cache, NULL));
+    TEST_ASSERT_NULL(lv_cache_acquire(cache, &search_key, NULL));
+}
+
+static bool create_cb(test_data * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    node->data = lv_malloc(node->slot.size);
+    return true;
+}
+
+void test_cache_hit_miss_count(void)
+{
+    lv_cache_set_create_cb(cache, (lv_cache_create_cb_t)create_cb, NULL);
+
+    test_data search_key = {
+        .slot.size = 16,
+        .key1 = 1,
+        .key2 = 2
+    };
+
+    /*Miss on the empty cache*/
+    TEST_ASSERT_NULL(lv_cache_acquire(cache, &search_key, NULL));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_hit_count(cache));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_cache_get_miss_count(cache));
+
+    /*Miss and create*/
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(cache, &search_key, NULL);
+    TEST_ASSERT_NOT_NULL(entry);
+    lv_cache_release(cache, entry, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_hit_count(cache));
+    TEST_ASSERT_EQUAL_UINT32(2, lv_cache_get_miss_count(cache));
+
+    /*Hit with both functions*/
+    entry = lv_cache_acquire_or_create(cache, &search_key, NULL);
+    lv_cache_release(cache, entry, NULL);
+    entry = lv_cache_acquire(cache, &search_key, NULL);
+    lv_cache_release(cache, entry, NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_cache_get_hit_count(cache));
+    TEST_ASSERT_EQUAL_UINT32(2, lv_cache_get_miss_count(cache));
+
+    /*Miss on an other key in a non-empty cache*/
+    search_key.key2 = 3;
+    TEST_ASSERT_NULL(lv_cache_acquire(cache, &search_key, NULL));
+    TEST_ASSERT_EQUAL_UINT32(2, lv_cache_get_hit_count(cache));
+    TEST_ASSERT_EQUAL_UINT32(3, lv_cache_get_miss_count(cache));
+}
+
+#if LV_USE_OS == LV_OS_PTHREAD
+
+static lv_thread_sync_t create_started;
+static lv_thread_sync_t create_continue;
+
+static bool create_slow_cb(test_data * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    /*Only key1 == 1 is slow, the others are created immediately*/
+    if(node->key1 == 1) {
+        lv_thread_sync_signal(&create_started);
+        lv_thread_sync_wait(&create_continue);
+    }
+
+    node->data = lv_malloc(node->slot.size);
+    return true;
+}
+
+/*Unity can't assert in other threads, so only count the failures and check them in the test*/
+static volatile uint32_t acquire_fail_cnt;
+
+static void acquire_thread_cb(void * user_data)
+{
+    test_data * search_key = user_data;
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(cache, search_key, NULL);
+    if(entry == NULL) {
+        acquire_fail_cnt++;
+        return;
+    }
+    lv_cache_release(cache, entry, NULL);
+}
+
+void test_cache_create_without_blocking_others(void)
+{
+    lv_cache_set_create_cb(cache, (lv_cache_create_cb_t)create_slow_cb, NULL);
+    cache->ops.create_unlocked = true;
+    acquire_fail_cnt = 0;
+    lv_thread_sync_init(&create_started);
+    lv_thread_sync_init(&create_continue);
+
+    test_data slow_key = {
+        .slot.size = 16,
+        .key1 = 1,
+        .key2 = 1
+    };
+
+    test_data fast_key = {
+        .slot.size = 16,
+        .key1 = 2,
+        .key2 = 2
+    };
+
+    lv_thread_t creator;
+    lv_thread_init(&creator, "creator", LV_THREAD_PRIO_MID, acquire_thread_cb, 64 * 1024, &slow_key);
+    lv_thread_sync_wait(&create_started);
+
+    /*The other keys can be used while the slow entry is being created*/
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(cache, &fast_key, NULL);
+    TEST_ASSERT_NOT_NULL(entry);
+    lv_cache_release(cache, entry, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_wait_count(cache));
+
+    /*The same key waits for the entry being created*/
+    lv_thread_t waiter;
+    lv_thread_init(&waiter, "waiter", LV_THREAD_PRIO_MID, acquire_thread_cb, 64 * 1024, &slow_key);
+    while(lv_cache_get_wait_count(cache) == 0) {
+        usleep(1000);
+    }
+
+    lv_thread_sync_signal(&create_continue);
+    lv_thread_delete(&creator);
+    lv_thread_delete(&waiter);
+
+    /*Only one entry was created for the slow key*/
+    TEST_ASSERT_EQUAL_UINT32(0, acquire_fail_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_cache_get_wait_count(cache));
+    TEST_ASSERT_EQUAL(32, lv_cache_get_size(cache, NULL));
+
+    lv_thread_sync_delete(&create_started);
+    lv_thread_sync_delete(&create_continue);
+}
+
+#endif /*LV_USE_OS == LV_OS_PTHREAD*/
+
 #endif
@@ -0,0 +1,100 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_SHADOW_CACHE_SIZE >= 40
+
+#define shadow_cache_p (LV_GLOBAL_DEFAULT()->sw_shadow_cache)
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_cache_drop_all(shadow_cache_p, NULL);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_cache_set_max_size(shadow_cache_p, LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE, NULL);
+    lv_obj_clean(lv_screen_active());
+}
+
+static void create_shadow(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, int32_t shadow_w,
+                          int32_t spread)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_radius(obj, radius, 0);
+    lv_obj_set_style_shadow_width(obj, shadow_w, 0);
+    lv_obj_set_style_shadow_spread(obj, spread, 0);
+    lv_obj_set_style_shadow_opa(obj, LV_OPA_COVER, 0);
+}
+
+static void create_shadows(void)
+{
+    /*Large panels with the same shadow share the same corner*/
+    create_shadow(40, 40, 150, 100, 10, 20, 0);
+    create_shadow(240, 40, 200, 120, 10, 20, 0);
+    create_shadow(500, 40, 150, 100, 10, 20, 5);
+
+    /*Small ones where the far edges change the corner*/
+    create_shadow(40, 300, 10, 10, 5, 30, 0);
+    create_shadow(140, 300, 10, 20, 5, 30, 0);
+    create_shadow(240, 300, 4, 4, 0, 20, 0);
+}
+
+void test_draw_box_shadow_cache(void)
+{
+    create_shadows();
+    lv_refr_now(NULL);
+
+    /*(20 + 10)^2 for the large ones, (30 + 5)^2 for the first two small ones and 20^2 for the last*/
+    TEST_ASSERT_EQUAL(30 * 30 + 2 * 35 * 35 + 20 * 20, lv_cache_get_size(shadow_cache_p, NULL));
+
+    /*Drawing again doesn't add new corners*/
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(30 * 30 + 2 * 35 * 35 + 20 * 20, lv_cache_get_size(shadow_cache_p, NULL));
+}
+
+void test_draw_box_shadow_cache_same_as_uncached(void)
+{
+    create_shadows();
+
+    lv_draw_buf_t * cached_buf = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(cached_buf);
+    TEST_ASSERT_NOT_EQUAL(0, lv_cache_get_size(shadow_cache_p, NULL));
+
+    lv_cache_drop_all(shadow_cache_p, NULL);
+    lv_cache_set_max_size(shadow_cache_p, 0, NULL);
+    lv_draw_buf_t * uncached_buf = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(uncached_buf);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(shadow_cache_p, NULL));
+
+    TEST_ASSERT_EQUAL_MEMORY(uncached_buf->data, cached_buf->data, uncached_buf->data_size);
+
+    lv_draw_buf_destroy(cached_buf);
+    lv_draw_buf_destroy(uncached_buf);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_box_shadow_cache(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,186 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX && LV_DRAW_SW_CIRCLE_CACHE_SIZE >= 4 && LV_USE_OS
+
+#include <unistd.h>
+
+#define circle_cache_p (LV_GLOBAL_DEFAULT()->sw_circle_cache)
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_cache_drop_all(circle_cache_p, NULL);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static const lv_area_t mask_area = {0, 0, 199, 199};
+
+/*Get the circle of a radius (from the cache if possible) and release it*/
+static void use_radius(int32_t radius)
+{
+    lv_draw_sw_mask_radius_param_t param;
+    lv_draw_sw_mask_radius_init(&param, &mask_area, radius, false);
+    lv_draw_sw_mask_free_param(&param);
+}
+
+static bool radius_is_cached(int32_t radius)
+{
+    uint32_t miss_cnt = lv_cache_get_miss_count(circle_cache_p);
+    use_radius(radius);
+    return miss_cnt == lv_cache_get_miss_count(circle_cache_p);
+}
+
+void test_draw_circle_cache_lru_eviction(void)
+{
+    /*Fill the cache*/
+    int32_t i;
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        use_radius(10 + i);
+    }
+
+    /*Make the first radius the most recently used, so the second one is the oldest*/
+    TEST_ASSERT_TRUE(radius_is_cached(10));
+
+    use_radius(100);
+    TEST_ASSERT_EQUAL(LV_DRAW_SW_CIRCLE_CACHE_SIZE, lv_cache_get_size(circle_cache_p, NULL));
+
+    /*Check the newest entries first as adding the evicted one evicts another*/
+    TEST_ASSERT_TRUE(radius_is_cached(100));
+    TEST_ASSERT_TRUE(radius_is_cached(10));
+    for(i = 2; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        TEST_ASSERT_TRUE(radius_is_cached(10 + i));
+    }
+    TEST_ASSERT_FALSE(radius_is_cached(11));
+}
+
+typedef struct {
+    lv_draw_sw_mask_radius_param_t param;
+    lv_thread_t thread;
+} draw_unit_t;
+
+static lv_mutex_t draw_unit_lock;
+static volatile uint32_t acquired_cnt;
+static volatile bool release_circles;
+
+/*Unity can't assert in other threads, so the test checks the results of the "draw units"*/
+static void draw_unit_thread_cb(void * user_data)
+{
+    draw_unit_t * unit = user_data;
+    lv_draw_sw_mask_radius_init(&unit->param, &mask_area, 25, false);
+
+    lv_mutex_lock(&draw_unit_lock);
+    acquired_cnt++;
+    lv_mutex_unlock(&draw_unit_lock);
+
+    /*Keep using the circle until the other draw unit has it too*/
+    while(!release_circles) usleep(1000);
+
+    lv_draw_sw_mask_free_param(&unit->param);
+}
+
+void test_draw_circle_cache_same_radius_in_two_draw_units(void)
+{
+    uint32_t hit_cnt = lv_cache_get_hit_count(circle_cache_p);
+    uint32_t miss_cnt = lv_cache_get_miss_count(circle_cache_p);
+
+    lv_mutex_init(&draw_unit_lock);
+    acquired_cnt = 0;
+    release_circles = false;
+
+    draw_unit_t units[2];
+    lv_thread_init(&units[0].thread, "unit0", LV_THREAD_PRIO_MID, draw_unit_thread_cb, 64 * 1024, &units[0]);
+    lv_thread_init(&units[1].thread, "unit1", LV_THREAD_PRIO_MID, draw_unit_thread_cb, 64 * 1024, &units[1]);
+
+    uint32_t i;
+    for(i = 0; i < 5000 && acquired_cnt < 2; i++) usleep(1000);
+    uint32_t acquired_cnt_final = acquired_cnt;
+
+    /*Both draw units use the same cached circle at once*/
+    lv_draw_sw_mask_radius_circle_dsc_t * circle0 = units[0].param.circle;
+    lv_draw_sw_mask_radius_circle_dsc_t * circle1 = units[1].param.circle;
+    int32_t ref_cnt = -1;
+    if(circle0 && circle0->cache_entry) ref_cnt = lv_cache_entry_get_ref(circle0->cache_entry);
+
+    release_circles = true;
+    lv_thread_delete(&units[0].thread);
+    lv_thread_delete(&units[1].thread);
+    lv_mutex_delete(&draw_unit_lock);
+
+    TEST_ASSERT_EQUAL_UINT32(2, acquired_cnt_final);
+    TEST_ASSERT_EQUAL_PTR(circle0, circle1);
+    TEST_ASSERT_EQUAL_INT32(2, ref_cnt);
+    TEST_ASSERT_EQUAL_INT32(25, circle0->radius);
+
+    /*Calculated only once*/
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 1, lv_cache_get_miss_count(circle_cache_p));
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt + 1, lv_cache_get_hit_count(circle_cache_p));
+
+    /*Still cached after both draw units released it*/
+    TEST_ASSERT_EQUAL_INT32(0, lv_cache_entry_get_ref(circle0->cache_entry));
+    TEST_ASSERT_TRUE(radius_is_cached(25));
+}
+
+static void create_rounded(int32_t x, int32_t y, int32_t radius)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, 100, 60);
+    lv_obj_set_style_radius(obj, radius, 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+}
+
+void test_draw_circle_cache_hit_miss_count(void)
+{
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        create_rounded(10 + (i % 6) * 120, 10 + (i / 6) * 80, 8);
+    }
+
+    create_rounded(10, 200, 3);
+    create_rounded(130, 200, 20);
+    create_rounded(250, 200, LV_RADIUS_CIRCLE);
+
+    uint32_t hit_cnt = lv_cache_get_hit_count(circle_cache_p);
+    uint32_t miss_cnt = lv_cache_get_miss_count(circle_cache_p);
+    lv_refr_now(NULL);
+
+    /*Only the 4 different radii are calculated, the other buttons find them in the cache*/
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 4, lv_cache_get_miss_count(circle_cache_p));
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(hit_cnt + 11, lv_cache_get_hit_count(circle_cache_p));
+
+    /*The next refreshes are served only from the cache*/
+    hit_cnt = lv_cache_get_hit_count(circle_cache_p);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 4, lv_cache_get_miss_count(circle_cache_p));
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(hit_cnt + 15, lv_cache_get_hit_count(circle_cache_p));
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_circle_cache_lru_eviction(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,159 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_GRAD_CACHE_SIZE
+
+#define grad_cache_p (LV_GLOBAL_DEFAULT()->sw_grad_cache)
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_cache_drop_all(grad_cache_p, NULL);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_obj_t * create_grad(int32_t x, int32_t y, int32_t w, int32_t h, lv_color_t main_color,
+                              lv_color_t grad_color)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, main_color, 0);
+    lv_obj_set_style_bg_grad_color(obj, grad_color, 0);
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_HOR, 0);
+    return obj;
+}
+
+void test_draw_grad_cache_different_stops(void)
+{
+    lv_color_t red = lv_palette_main(LV_PALETTE_RED);
+    lv_color_t blue = lv_palette_main(LV_PALETTE_BLUE);
+
+    /*All the gradients have the same width, so only the stops tell them apart*/
+    create_grad(10, 10, 200, 60, red, blue);
+    create_grad(10, 80, 200, 60, blue, red);
+    lv_obj_t * obj = create_grad(10, 150, 200, 60, red, blue);
+    lv_obj_set_style_bg_main_stop(obj, 128, 0);
+    obj = create_grad(10, 220, 200, 60, red, blue);
+    lv_obj_set_style_bg_grad_opa(obj, LV_OPA_50, 0);
+
+    /*The same as the first one*/
+    create_grad(250, 10, 200, 60, red, blue);
+
+    uint32_t miss_cnt = lv_cache_get_miss_count(grad_cache_p);
+    uint32_t hit_cnt = lv_cache_get_hit_count(grad_cache_p);
+    lv_refr_now(NULL);
+    uint32_t new_miss_cnt = lv_cache_get_miss_count(grad_cache_p) - miss_cnt;
+    uint32_t new_hit_cnt = lv_cache_get_hit_count(grad_cache_p) - hit_cnt;
+
+    /*Each gradient is drawn with its own stops*/
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/grad_cache_different_stops.png");
+
+    TEST_ASSERT_EQUAL_UINT32(4, new_miss_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, new_hit_cnt);
+}
+
+void test_draw_grad_cache_eviction(void)
+{
+    lv_obj_t * objs[32];
+
+    /*Measure the size of a cached gradient*/
+    objs[0] = create_grad(10, 10, 200, 12, lv_color_hsv_to_rgb(0, 100, 100), lv_color_black());
+    lv_refr_now(NULL);
+    uint32_t entry_size = lv_cache_get_size(grad_cache_p, NULL);
+    TEST_ASSERT_NOT_EQUAL(0, entry_size);
+
+    /*Draw more different gradients than what fit into the cache*/
+    uint32_t cnt = LV_DRAW_SW_GRAD_CACHE_SIZE / entry_size + 2;
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(32, cnt);
+    uint32_t i;
+    for(i = 1; i < cnt; i++) {
+        objs[i] = create_grad(10, 10 + i * 14, 200, 12, lv_color_hsv_to_rgb(i * 10, 100, 100), lv_color_black());
+    }
+    lv_refr_now(NULL);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_DRAW_SW_GRAD_CACHE_SIZE, lv_cache_get_size(grad_cache_p, NULL));
+
+    /*The last gradient is still cached*/
+    uint32_t miss_cnt = lv_cache_get_miss_count(grad_cache_p);
+    lv_obj_invalidate(objs[cnt - 1]);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt, lv_cache_get_miss_count(grad_cache_p));
+
+    /*The least recently used (first) gradient was evicted*/
+    lv_obj_invalidate(objs[0]);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 1, lv_cache_get_miss_count(grad_cache_p));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_DRAW_SW_GRAD_CACHE_SIZE, lv_cache_get_size(grad_cache_p, NULL));
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/grad_cache_eviction.png");
+}
+
+void test_draw_grad_cache_radial_conical_geometry(void)
+{
+#if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
+    lv_color_t colors[2] = {lv_palette_main(LV_PALETTE_RED), lv_palette_main(LV_PALETTE_BLUE)};
+    lv_opa_t opas[2] = {LV_OPA_COVER, LV_OPA_50};
+
+    static lv_grad_dsc_t radial1;
+    lv_grad_init_stops(&radial1, colors, opas, NULL, 2);
+    lv_grad_radial_init(&radial1, LV_GRAD_CENTER, LV_GRAD_CENTER, LV_GRAD_RIGHT, LV_GRAD_BOTTOM, LV_GRAD_EXTEND_PAD);
+
+    static lv_grad_dsc_t radial2;
+    lv_grad_init_stops(&radial2, colors, opas, NULL, 2);
+    lv_grad_radial_init(&radial2, 20, 30, 60, 60, LV_GRAD_EXTEND_REFLECT);
+
+    static lv_grad_dsc_t conical;
+    lv_grad_init_stops(&conical, colors, opas, NULL, 2);
+    lv_grad_conical_init(&conical, LV_GRAD_CENTER, LV_GRAD_CENTER, 0, 180, LV_GRAD_EXTEND_REPEAT);
+
+    lv_grad_dsc_t * grads[3] = {&radial1, &radial2, &conical};
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_screen_active());
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_pos(obj, 10 + i * 220, 10);
+        lv_obj_set_size(obj, 200, 200);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_grad(obj, grads[i], 0);
+    }
+
+    uint32_t miss_cnt = lv_cache_get_miss_count(grad_cache_p);
+    lv_refr_now(NULL);
+    uint32_t new_miss_cnt = lv_cache_get_miss_count(grad_cache_p) - miss_cnt;
+
+    /*Only the color map is cached, the center, radius and angles are still applied per gradient*/
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/grad_cache_radial_conical.png");
+
+    TEST_ASSERT_EQUAL_UINT32(1, new_miss_cnt);
+#else
+    TEST_PASS();
+#endif
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_grad_cache_different_stops(void)
+{
+}
+
+#endif
+
+#endif
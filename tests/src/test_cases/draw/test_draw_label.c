@@ -145,4 +145,40 @@ void test_label_selection_and_recolor(void)
     TEST_ASSERT_EQUAL_SCREENSHOT("draw/label_selection_and_recolor.png");
 }
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+void test_draw_label_glyph_cache(void)
+{
+    lv_font_fmt_txt_glyph_cache_drop(NULL);
+
+    lv_font_fmt_txt_glyph_cache_stats_t stats0;
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats0);
+
+    all_labels_create("normal", NULL);
+
+    lv_font_fmt_txt_glyph_cache_stats_t stats1;
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats1);
+    TEST_ASSERT_GREATER_THAN(stats0.miss_cnt, stats1.miss_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats1.size);
+    TEST_ASSERT_LESS_OR_EQUAL(stats1.max_size, stats1.size);
+
+    /*Redrawing the same glyphs is served from the cache*/
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/label_normal.png");
+    lv_font_fmt_txt_glyph_cache_stats_t stats2;
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats2);
+    TEST_ASSERT_EQUAL(stats1.miss_cnt, stats2.miss_cnt);
+    TEST_ASSERT_GREATER_THAN(stats1.hit_cnt, stats2.hit_cnt);
+
+    /*The same result without caching*/
+    lv_font_fmt_txt_glyph_cache_resize(0);
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats1);
+    TEST_ASSERT_EQUAL(0, stats1.size);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/label_normal.png");
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats2);
+    TEST_ASSERT_EQUAL(stats1.hit_cnt, stats2.hit_cnt);
+    TEST_ASSERT_EQUAL(stats1.miss_cnt, stats2.miss_cnt);
+
+    lv_font_fmt_txt_glyph_cache_resize(LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE);
+}
+#endif
+
 #endif
@@ -0,0 +1,364 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2
+
+#include "../../../src/draw/sw/blend/sse2/lv_blend_sse2.h"
+
+#define MAX_W       37
+#define MAX_H       3
+#define MAX_STRIDE  ((MAX_W + 3) * 4)
+
+typedef enum {
+    VARIANT_OPA,
+    VARIANT_MASK,
+    VARIANT_MASK_OPA,
+    VARIANT_PLAIN,
+} variant_t;
+
+static uint8_t dest_buf[MAX_H * MAX_STRIDE];
+static uint8_t ref_buf[MAX_H * MAX_STRIDE];
+static uint8_t src_buf[MAX_H * MAX_STRIDE];
+static lv_opa_t mask_buf[MAX_H * (MAX_W + 5)];
+static uint32_t seed;
+
+void setUp(void)
+{
+    seed = 0x12345678;
+}
+
+void tearDown(void)
+{
+}
+
+static uint8_t rand_u8(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return (uint8_t)seed;
+}
+
+/*Random values with many edge cases of the opacity handling*/
+static lv_opa_t rand_opa(void)
+{
+    static const lv_opa_t special[] = {0, 1, 128, 252, 253, 254, 255};
+    uint8_t r = rand_u8();
+    if(r < 96) return special[r % sizeof(special)];
+    return rand_u8();
+}
+
+static void fill_random(uint8_t * buf, uint32_t size, bool opa_like)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) buf[i] = opa_like ? rand_opa() : rand_u8();
+}
+
+static lv_opa_t get_mix(variant_t variant, lv_opa_t mask, lv_opa_t opa)
+{
+    if(variant == VARIANT_OPA) return opa;
+    if(variant == VARIANT_MASK) return mask;
+    if(variant == VARIANT_MASK_OPA) return LV_OPA_MIX2(mask, opa);
+    return LV_OPA_COVER;
+}
+
+static lv_opa_t get_mix_alpha(variant_t variant, lv_opa_t alpha, lv_opa_t mask, lv_opa_t opa)
+{
+    if(variant == VARIANT_OPA) return LV_OPA_MIX2(alpha, opa);
+    if(variant == VARIANT_MASK) return LV_OPA_MIX2(alpha, mask);
+    if(variant == VARIANT_MASK_OPA) return LV_OPA_MIX3(alpha, mask, opa);
+    return alpha;
+}
+
+static uint16_t ref_24_16_mix(const uint8_t * c1, uint16_t c2, uint8_t mix)
+{
+    if(mix == 0) return c2;
+    if(mix == 255) return ((c1[2] & 0xF8) << 8) + ((c1[1] & 0xFC) << 3) + ((c1[0] & 0xF8) >> 3);
+
+    lv_opa_t mix_inv = 255 - mix;
+    return ((((c1[2] >> 3) * mix + ((c2 >> 11) & 0x1F) * mix_inv) << 3) & 0xF800) +
+           ((((c1[1] >> 2) * mix + ((c2 >> 5) & 0x3F) * mix_inv) >> 3) & 0x07E0) +
+           (((c1[0] >> 3) * mix + (c2 & 0x1F) * mix_inv) >> 8);
+}
+
+static void ref_24_24_mix(const uint8_t * src, uint8_t * dest, uint8_t mix)
+{
+    if(mix == 0) return;
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        if(mix >= LV_OPA_MAX) dest[i] = src[i];
+        else dest[i] = (uint32_t)((uint32_t)src[i] * mix + dest[i] * (255 - mix)) >> 8;
+    }
+}
+
+static lv_opa_t get_opa(variant_t variant)
+{
+    if(variant == VARIANT_OPA || variant == VARIANT_MASK_OPA) {
+        lv_opa_t opa = rand_opa();
+        return opa >= LV_OPA_MAX ? LV_OPA_50 : opa;
+    }
+    return LV_OPA_COVER;
+}
+
+/**
+ * Prepare random buffers and descriptors. The strides have padding to test the row handling.
+ */
+static void init_dsc(lv_draw_sw_blend_image_dsc_t * dsc, variant_t variant, int32_t w, int32_t h,
+                     uint32_t dest_px_size)
+{
+    fill_random(dest_buf, sizeof(dest_buf), false);
+    fill_random(src_buf, sizeof(src_buf), false);
+    fill_random(mask_buf, sizeof(mask_buf), true);
+    /*Make the alpha channel of the ARGB8888 images use the edge cases too*/
+    uint32_t i;
+    for(i = 3; i < sizeof(src_buf); i += 4) src_buf[i] = rand_opa();
+    lv_memcpy(ref_buf, dest_buf, sizeof(dest_buf));
+
+    lv_memzero(dsc, sizeof(*dsc));
+    dsc->dest_buf = dest_buf;
+    dsc->dest_w = w;
+    dsc->dest_h = h;
+    dsc->dest_stride = (w + 3) * dest_px_size;
+    dsc->src_buf = src_buf;
+    dsc->src_stride = (w + 1) * 4;
+    dsc->mask_buf = (variant == VARIANT_MASK || variant == VARIANT_MASK_OPA) ? mask_buf : NULL;
+    dsc->mask_stride = w + 5;
+    dsc->opa = get_opa(variant);
+    dsc->blend_mode = LV_BLEND_MODE_NORMAL;
+}
+
+static void init_fill_dsc(lv_draw_sw_blend_fill_dsc_t * fill_dsc, const lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    lv_memzero(fill_dsc, sizeof(*fill_dsc));
+    fill_dsc->dest_buf = dsc->dest_buf;
+    fill_dsc->dest_w = dsc->dest_w;
+    fill_dsc->dest_h = dsc->dest_h;
+    fill_dsc->dest_stride = dsc->dest_stride;
+    fill_dsc->mask_buf = dsc->mask_buf;
+    fill_dsc->mask_stride = dsc->mask_stride;
+    fill_dsc->opa = dsc->opa;
+    fill_dsc->color = lv_color_make(rand_u8(), rand_u8(), rand_u8());
+}
+
+static void check_result(void)
+{
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, dest_buf, sizeof(dest_buf));
+}
+
+void test_sse2_color_blend_to_rgb565(void)
+{
+    variant_t variant;
+    int32_t w;
+    for(variant = VARIANT_OPA; variant <= VARIANT_PLAIN; variant++) {
+        for(w = 1; w <= MAX_W; w++) {
+            lv_draw_sw_blend_image_dsc_t dsc;
+            lv_draw_sw_blend_fill_dsc_t fill_dsc;
+            init_dsc(&dsc, variant, w, MAX_H, 2);
+            init_fill_dsc(&fill_dsc, &dsc);
+
+            uint16_t color16 = lv_color_to_u16(fill_dsc.color);
+            int32_t x, y;
+            for(y = 0; y < MAX_H; y++) {
+                uint16_t * ref = (uint16_t *)&ref_buf[y * dsc.dest_stride];
+                const lv_opa_t * mask = &mask_buf[y * dsc.mask_stride];
+                for(x = 0; x < w; x++) {
+                    ref[x] = lv_color_16_16_mix(color16, ref[x], get_mix(variant, mask[x], dsc.opa));
+                }
+            }
+
+            lv_result_t res;
+            if(variant == VARIANT_OPA) res = lv_color_blend_to_rgb565_with_opa_sse2(&fill_dsc);
+            else if(variant == VARIANT_MASK) res = lv_color_blend_to_rgb565_with_mask_sse2(&fill_dsc);
+            else if(variant == VARIANT_MASK_OPA) res = lv_color_blend_to_rgb565_mix_mask_opa_sse2(&fill_dsc);
+            else res = lv_color_blend_to_rgb565_sse2(&fill_dsc);
+
+            TEST_ASSERT_EQUAL(LV_RESULT_OK, res);
+            check_result();
+        }
+    }
+}
+
+void test_sse2_rgb565_blend_to_rgb565(void)
+{
+    variant_t variant;
+    int32_t w;
+    for(variant = VARIANT_OPA; variant <= VARIANT_MASK_OPA; variant++) {
+        for(w = 1; w <= MAX_W; w++) {
+            lv_draw_sw_blend_image_dsc_t dsc;
+            init_dsc(&dsc, variant, w, MAX_H, 2);
+
+            int32_t x, y;
+            for(y = 0; y < MAX_H; y++) {
+                uint16_t * ref = (uint16_t *)&ref_buf[y * dsc.dest_stride];
+                const uint16_t * src = (const uint16_t *)&src_buf[y * dsc.src_stride];
+                const lv_opa_t * mask = &mask_buf[y * dsc.mask_stride];
+                for(x = 0; x < w; x++) {
+                    ref[x] = lv_color_16_16_mix(src[x], ref[x], get_mix(variant, mask[x], dsc.opa));
+                }
+            }
+
+            lv_result_t res;
+            if(variant == VARIANT_OPA) res = lv_rgb565_blend_normal_to_rgb565_with_opa_sse2(&dsc);
+            else if(variant == VARIANT_MASK) res = lv_rgb565_blend_normal_to_rgb565_with_mask_sse2(&dsc);
+            else res = lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_sse2(&dsc);
+
+            TEST_ASSERT_EQUAL(LV_RESULT_OK, res);
+            check_result();
+        }
+    }
+}
+
+void test_sse2_argb8888_blend_to_rgb565(void)
+{
+    variant_t variant;
+    int32_t w;
+    for(variant = VARIANT_OPA; variant <= VARIANT_PLAIN; variant++) {
+        for(w = 1; w <= MAX_W; w++) {
+            lv_draw_sw_blend_image_dsc_t dsc;
+            init_dsc(&dsc, variant, w, MAX_H, 2);
+
+            int32_t x, y;
+            for(y = 0; y < MAX_H; y++) {
+                uint16_t * ref = (uint16_t *)&ref_buf[y * dsc.dest_stride];
+                const uint8_t * src = &src_buf[y * dsc.src_stride];
+                const lv_opa_t * mask = &mask_buf[y * dsc.mask_stride];
+                for(x = 0; x < w; x++) {
+                    lv_opa_t mix = get_mix_alpha(variant, src[x * 4 + 3], mask[x], dsc.opa);
+                    ref[x] = ref_24_16_mix(&src[x * 4], ref[x], mix);
+                }
+            }
+
+            lv_result_t res;
+            if(variant == VARIANT_OPA) res = lv_argb8888_blend_normal_to_rgb565_with_opa_sse2(&dsc);
+            else if(variant == VARIANT_MASK) res = lv_argb8888_blend_normal_to_rgb565_with_mask_sse2(&dsc);
+            else if(variant == VARIANT_MASK_OPA) res = lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_sse2(&dsc);
+            else res = lv_argb8888_blend_normal_to_rgb565_sse2(&dsc);
+
+            TEST_ASSERT_EQUAL(LV_RESULT_OK, res);
+            check_result();
+        }
+    }
+}
+
+void test_sse2_color_blend_to_xrgb8888(void)
+{
+    variant_t variant;
+    int32_t w;
+    for(variant = VARIANT_OPA; variant <= VARIANT_PLAIN; variant++) {
+        for(w = 1; w <= MAX_W; w++) {
+            lv_draw_sw_blend_image_dsc_t dsc;
+            lv_draw_sw_blend_fill_dsc_t fill_dsc;
+            init_dsc(&dsc, variant, w, MAX_H, 4);
+            init_fill_dsc(&fill_dsc, &dsc);
+
+            uint32_t color32 = lv_color_to_u32(fill_dsc.color);
+            int32_t x, y;
+            for(y = 0; y < MAX_H; y++) {
+                uint8_t * ref = &ref_buf[y * dsc.dest_stride];
+                const lv_opa_t * mask = &mask_buf[y * dsc.mask_stride];
+                for(x = 0; x < w; x++) {
+                    /*The simple fill writes the alpha byte too*/
+                    if(variant == VARIANT_PLAIN) lv_memcpy(&ref[x * 4], &color32, 4);
+                    else ref_24_24_mix((const uint8_t *)&color32, &ref[x * 4], get_mix(variant, mask[x], dsc.opa));
+                }
+            }
+
+            lv_result_t res;
+            if(variant == VARIANT_OPA) res = lv_color_blend_to_rgb888_with_opa_sse2(&fill_dsc, 4);
+            else if(variant == VARIANT_MASK) res = lv_color_blend_to_rgb888_with_mask_sse2(&fill_dsc, 4);
+            else if(variant == VARIANT_MASK_OPA) res = lv_color_blend_to_rgb888_mix_mask_opa_sse2(&fill_dsc, 4);
+            else res = lv_color_blend_to_rgb888_sse2(&fill_dsc, 4);
+
+            TEST_ASSERT_EQUAL(LV_RESULT_OK, res);
+            check_result();
+        }
+    }
+
+    /*RGB888 is left to the C implementation*/
+    lv_draw_sw_blend_fill_dsc_t fill_dsc;
+    lv_memzero(&fill_dsc, sizeof(fill_dsc));
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_color_blend_to_rgb888_with_opa_sse2(&fill_dsc, 3));
+}
+
+void test_sse2_xrgb8888_blend_to_xrgb8888(void)
+{
+    variant_t variant;
+    int32_t w;
+    for(variant = VARIANT_OPA; variant <= VARIANT_MASK_OPA; variant++) {
+        for(w = 1; w <= MAX_W; w++) {
+            lv_draw_sw_blend_image_dsc_t dsc;
+            init_dsc(&dsc, variant, w, MAX_H, 4);
+
+            int32_t x, y;
+            for(y = 0; y < MAX_H; y++) {
+                uint8_t * ref = &ref_buf[y * dsc.dest_stride];
+                const uint8_t * src = &src_buf[y * dsc.src_stride];
+                const lv_opa_t * mask = &mask_buf[y * dsc.mask_stride];
+                for(x = 0; x < w; x++) {
+                    ref_24_24_mix(&src[x * 4], &ref[x * 4], get_mix(variant, mask[x], dsc.opa));
+                }
+            }
+
+            lv_result_t res;
+            if(variant == VARIANT_OPA) res = lv_rgb888_blend_normal_to_rgb888_with_opa_sse2(&dsc, 4, 4);
+            else if(variant == VARIANT_MASK) res = lv_rgb888_blend_normal_to_rgb888_with_mask_sse2(&dsc, 4, 4);
+            else res = lv_rgb888_blend_normal_to_rgb888_mix_mask_opa_sse2(&dsc, 4, 4);
+
+            TEST_ASSERT_EQUAL(LV_RESULT_OK, res);
+            check_result();
+        }
+    }
+}
+
+void test_sse2_argb8888_blend_to_xrgb8888(void)
+{
+    variant_t variant;
+    int32_t w;
+    for(variant = VARIANT_OPA; variant <= VARIANT_PLAIN; variant++) {
+        for(w = 1; w <= MAX_W; w++) {
+            lv_draw_sw_blend_image_dsc_t dsc;
+            init_dsc(&dsc, variant, w, MAX_H, 4);
+
+            int32_t x, y;
+            for(y = 0; y < MAX_H; y++) {
+                uint8_t * ref = &ref_buf[y * dsc.dest_stride];
+                const uint8_t * src = &src_buf[y * dsc.src_stride];
+                const lv_opa_t * mask = &mask_buf[y * dsc.mask_stride];
+                for(x = 0; x < w; x++) {
+                    lv_opa_t mix = get_mix_alpha(variant, src[x * 4 + 3], mask[x], dsc.opa);
+                    ref_24_24_mix(&src[x * 4], &ref[x * 4], mix);
+                }
+            }
+
+            lv_result_t res;
+            if(variant == VARIANT_OPA) res = lv_argb8888_blend_normal_to_rgb888_with_opa_sse2(&dsc, 4);
+            else if(variant == VARIANT_MASK) res = lv_argb8888_blend_normal_to_rgb888_with_mask_sse2(&dsc, 4);
+            else if(variant == VARIANT_MASK_OPA) res = lv_argb8888_blend_normal_to_rgb888_mix_mask_opa_sse2(&dsc, 4);
+            else res = lv_argb8888_blend_normal_to_rgb888_sse2(&dsc, 4);
+
+            TEST_ASSERT_EQUAL(LV_RESULT_OK, res);
+            check_result();
+        }
+    }
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_sse2_color_blend_to_rgb565(void)
+{
+}
+
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2*/
+
+#endif
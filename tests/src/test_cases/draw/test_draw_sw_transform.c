@@ -0,0 +1,85 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+LV_IMAGE_DECLARE(test_image_cogwheel_xrgb8888);
+LV_IMAGE_DECLARE(test_image_cogwheel_rgb565);
+LV_IMAGE_DECLARE(test_image_cogwheel_rgb565a8);
+LV_IMAGE_DECLARE(test_image_cogwheel_a8);
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static void img_create(const void * src, int32_t x, int32_t y, int32_t rotation, int32_t scale, bool antialias)
+{
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, src);
+    lv_obj_set_pos(img, x, y);
+    lv_image_set_rotation(img, rotation);
+    lv_image_set_scale(img, scale);
+    lv_image_set_antialias(img, antialias);
+    /*The color of the A8 image*/
+    lv_obj_set_style_image_recolor(img, lv_palette_main(LV_PALETTE_RED), 0);
+}
+
+/**
+ * Rotate, scale and rotate+scale an image with anti-aliasing (first row)
+ * and without it (second row)
+ * @param src       the image to transform
+ * @param name      name of the reference image
+ */
+static void transform_and_compare(const void * src, const char * name)
+{
+    lv_obj_set_style_bg_color(lv_screen_active(), lv_palette_lighten(LV_PALETTE_GREY, 2), 0);
+
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        bool antialias = i == 0;
+        int32_t y = 60 + i * 220;
+        img_create(src, 60, y, 300, LV_SCALE_NONE, antialias);
+        img_create(src, 330, y, 0, 430, antialias);
+        img_create(src, 620, y, 1250, 330, antialias);
+    }
+
+    char path[64];
+    lv_snprintf(path, sizeof(path), "draw/sw_transform_%s.png", name);
+    TEST_ASSERT_EQUAL_SCREENSHOT(path);
+}
+
+void test_draw_sw_transform_argb8888(void)
+{
+    transform_and_compare(&test_image_cogwheel_argb8888, "argb8888");
+}
+
+void test_draw_sw_transform_xrgb8888(void)
+{
+    transform_and_compare(&test_image_cogwheel_xrgb8888, "xrgb8888");
+}
+
+void test_draw_sw_transform_rgb565(void)
+{
+    transform_and_compare(&test_image_cogwheel_rgb565, "rgb565");
+}
+
+void test_draw_sw_transform_rgb565a8(void)
+{
+    transform_and_compare(&test_image_cogwheel_rgb565a8, "rgb565a8");
+}
+
+void test_draw_sw_transform_a8(void)
+{
+    transform_and_compare(&test_image_cogwheel_a8, "a8");
+}
+
+#endif
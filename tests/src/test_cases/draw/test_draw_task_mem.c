@@ -0,0 +1,64 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void create_buttons(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_t * btn = lv_button_create(lv_screen_active());
+        lv_obj_set_pos(btn, (i % 10) * 75, (i / 10) * 45);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "%"LV_PRIu32, i);
+    }
+}
+
+void test_draw_task_mem_all_tasks_are_freed(void)
+{
+    create_buttons(100);
+    lv_refr_now(NULL);
+
+    lv_draw_task_mem_monitor_t mon;
+    lv_draw_task_mem_monitor(&mon);
+
+    TEST_ASSERT_EQUAL_UINT32(0, mon.task_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.used_size);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, mon.max_task_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, mon.max_used);
+}
+
+void test_draw_task_mem_chunks_are_reused(void)
+{
+    create_buttons(100);
+    lv_refr_now(NULL);
+
+    lv_draw_task_mem_monitor_t mon1;
+    lv_draw_task_mem_monitor(&mon1);
+
+    /*Only the current and the spare chunk are kept*/
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(2, mon1.chunk_cnt);
+
+    /*The chunks are released again after drawing the next frame*/
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    lv_draw_task_mem_monitor_t mon2;
+    lv_draw_task_mem_monitor(&mon2);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(2, mon2.chunk_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, mon2.task_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(mon1.max_task_cnt, mon2.max_task_cnt);
+}
+
+#endif
@@ -0,0 +1,149 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+#include <unistd.h>
+
+#define IMAGE_SRC "A:src/test_assets/test_img_lvgl_logo.png"
+
+static uint32_t image_cache_size;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    image_cache_size = lv_cache_get_max_size(LV_GLOBAL_DEFAULT()->img_cache, NULL);
+    lv_image_cache_drop(NULL);
+    lv_image_decoder_set_async(true);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_image_decoder_set_async(false);
+    lv_obj_clean(lv_screen_active());
+    lv_image_cache_drop(NULL);
+
+    /*Restore them even if the test failed*/
+    lv_image_cache_resize(image_cache_size, false);
+    lv_timer_resume(lv_display_get_refr_timer(lv_display_get_default()));
+}
+
+static void wait_decoding(const void * src)
+{
+    uint32_t i;
+    for(i = 0; i < 1000 && lv_image_decoder_is_pending(src); i++) {
+        usleep(1000);
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+}
+
+void test_image_decoder_async_placeholder(void)
+{
+    /*Refresh only manually to see the invalidated areas*/
+    lv_timer_t * refr_timer = lv_display_get_refr_timer(lv_display_get_default());
+    lv_timer_pause(refr_timer);
+
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, IMAGE_SRC);
+    lv_refr_now(NULL);
+
+    /*The first frame has only a placeholder and the image is queued*/
+    TEST_ASSERT_TRUE(lv_image_decoder_is_pending(IMAGE_SRC));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_display_get_default()->inv_p);
+
+    wait_decoding(IMAGE_SRC);
+    TEST_ASSERT_FALSE(lv_image_decoder_is_pending(IMAGE_SRC));
+    TEST_ASSERT_NOT_EQUAL(0, lv_cache_get_size(LV_GLOBAL_DEFAULT()->img_cache, NULL));
+
+    /*The timer has invalidated the image*/
+    TEST_ASSERT_NOT_EQUAL(0, lv_display_get_default()->inv_p);
+
+    /*Now the cached image is drawn without queueing it again*/
+    lv_refr_now(NULL);
+    TEST_ASSERT_FALSE(lv_image_decoder_is_pending(IMAGE_SRC));
+}
+
+void test_image_decoder_async_prefetch(void)
+{
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_prefetch(IMAGE_SRC));
+    wait_decoding(IMAGE_SRC);
+    TEST_ASSERT_NOT_EQUAL(0, lv_cache_get_size(LV_GLOBAL_DEFAULT()->img_cache, NULL));
+
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, IMAGE_SRC);
+    lv_refr_now(NULL);
+
+    /*Already decoded, so drawn in the first frame*/
+    TEST_ASSERT_FALSE(lv_image_decoder_is_pending(IMAGE_SRC));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_display_get_default()->inv_p);
+}
+
+void test_image_decoder_async_no_cache(void)
+{
+    /*The image doesn't fit into the cache*/
+    const char * src = "A:src/test_files/binimages/cogwheel.RGB565.bin";
+    lv_image_cache_resize(1024, true);
+
+    lv_timer_t * refr_timer = lv_display_get_refr_timer(lv_display_get_default());
+    lv_timer_pause(refr_timer);
+
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, src);
+    lv_refr_now(NULL);
+    wait_decoding(src);
+
+    /*Wait until the timer invalidates the image*/
+    uint32_t i;
+    for(i = 0; i < 1000 && lv_display_get_default()->inv_p == 0; i++) {
+        usleep(1000);
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_NOT_EQUAL(0, lv_display_get_default()->inv_p);
+
+    /*The image is drawn synchronously and it's not queued again.
+     *An invalidation would resume the refresh timer.*/
+    lv_refr_now(NULL);
+    lv_timer_pause(refr_timer);
+    for(i = 0; i < 50; i++) {
+        usleep(1000);
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_TRUE(lv_timer_get_paused(refr_timer));
+}
+
+void test_image_decoder_async_disabled(void)
+{
+    lv_image_decoder_set_async(false);
+
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, IMAGE_SRC);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_FALSE(lv_image_decoder_is_pending(IMAGE_SRC));
+    TEST_ASSERT_NOT_EQUAL(0, lv_cache_get_size(LV_GLOBAL_DEFAULT()->img_cache, NULL));
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_image_decoder_async_placeholder(void)
+{
+}
+
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
+
+#endif
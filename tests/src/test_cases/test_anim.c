@@ -263,4 +263,168 @@ void test_anim_vsync_mode(void)
     lv_anim_delete(&var, exec_cb);
 }
 
+static void exec_other_cb(void * var, int32_t v)
+{
+    int32_t * var_i32 = var;
+    *var_i32 = v * 2;
+}
+
+void test_anim_get_and_delete_many(void)
+{
+    static int32_t vars[100];
+    uint32_t i;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_duration(&a, 100);
+    for(i = 0; i < 100; i++) {
+        lv_anim_set_var(&a, &vars[i]);
+        lv_anim_set_exec_cb(&a, exec_cb);
+        lv_anim_start(&a);
+        lv_anim_set_exec_cb(&a, exec_other_cb);
+        lv_anim_start(&a);
+    }
+    TEST_ASSERT_EQUAL(200, lv_anim_count_running());
+
+    /*Starting the same var and exec_cb again replaces the animation*/
+    lv_anim_set_var(&a, &vars[0]);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_start(&a);
+    TEST_ASSERT_EQUAL(200, lv_anim_count_running());
+
+    for(i = 0; i < 100; i += 2) {
+        TEST_ASSERT_TRUE(lv_anim_delete(&vars[i], exec_cb));
+    }
+    TEST_ASSERT_EQUAL(150, lv_anim_count_running());
+
+    for(i = 0; i < 100; i++) {
+        lv_anim_t * found = lv_anim_get(&vars[i], exec_cb);
+        if(i % 2) {
+            TEST_ASSERT_NOT_NULL(found);
+            TEST_ASSERT_EQUAL_PTR(&vars[i], found->var);
+        }
+        else {
+            TEST_ASSERT_NULL(found);
+        }
+        TEST_ASSERT_NOT_NULL(lv_anim_get(&vars[i], exec_other_cb));
+        TEST_ASSERT_NOT_NULL(lv_anim_get(&vars[i], NULL));
+    }
+
+    /*Delete all animations of a variable*/
+    TEST_ASSERT_TRUE(lv_anim_delete(&vars[1], NULL));
+    TEST_ASSERT_NULL(lv_anim_get(&vars[1], NULL));
+    TEST_ASSERT_EQUAL(148, lv_anim_count_running());
+
+    /*Delete by exec_cb only*/
+    TEST_ASSERT_TRUE(lv_anim_delete(NULL, exec_other_cb));
+    TEST_ASSERT_EQUAL(49, lv_anim_count_running());
+
+    lv_test_wait(200);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_EQUAL(100, vars[3]);
+}
+
+static int32_t deleter_var;
+static int32_t victim_var;
+
+static void delete_other_exec_cb(void * var, int32_t v)
+{
+    LV_UNUSED(var);
+    if(v >= 50) lv_anim_delete(&victim_var, NULL);
+}
+
+void test_anim_delete_in_exec_cb(void)
+{
+    victim_var = 0;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_duration(&a, 100);
+
+    lv_anim_set_var(&a, &victim_var);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_start(&a);
+
+    /*Started later so it runs first*/
+    lv_anim_set_var(&a, &deleter_var);
+    lv_anim_set_exec_cb(&a, delete_other_exec_cb);
+    lv_anim_start(&a);
+
+    lv_test_wait(60);
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+    TEST_ASSERT_NULL(lv_anim_get(&victim_var, NULL));
+
+    int32_t victim_last = victim_var;
+    TEST_ASSERT_LESS_THAN(50, victim_last);
+    lv_test_wait(60);
+    TEST_ASSERT_EQUAL(victim_last, victim_var);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+}
+
+static uint32_t completed_cnt;
+static uint32_t deleted_cnt;
+
+static void count_completed_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    completed_cnt++;
+}
+
+static void delete_all_completed_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    completed_cnt++;
+    lv_anim_delete_all();
+}
+
+static void count_deleted_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    deleted_cnt++;
+}
+
+void test_anim_delete_all_in_completed_cb(void)
+{
+    int32_t vars[3];
+    completed_cnt = 0;
+    deleted_cnt = 0;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_deleted_cb(&a, count_deleted_cb);
+
+    /*Still running when the others are completed*/
+    lv_anim_set_var(&a, &vars[0]);
+    lv_anim_set_duration(&a, 1000);
+    lv_anim_start(&a);
+
+    lv_anim_set_var(&a, &vars[1]);
+    lv_anim_set_duration(&a, 50);
+    lv_anim_set_completed_cb(&a, delete_all_completed_cb);
+    lv_anim_start(&a);
+
+    /*Started later so it's completed first in the same timer run and it's already deleted on `lv_anim_delete_all()`*/
+    lv_anim_set_var(&a, &vars[2]);
+    lv_anim_set_completed_cb(&a, count_completed_cb);
+    lv_anim_start(&a);
+
+    lv_test_wait(100);
+    TEST_ASSERT_EQUAL_UINT32(2, completed_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, deleted_cnt);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+
+    /*The counter hasn't underflowed so new animations work normally*/
+    lv_anim_set_duration(&a, 50);
+    lv_anim_set_completed_cb(&a, NULL);
+    lv_anim_start(&a);
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+    lv_test_wait(100);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_EQUAL_UINT32(4, deleted_cnt);
+}
+
 #endif
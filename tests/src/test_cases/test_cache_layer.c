@@ -0,0 +1,208 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_DRAW_LAYER_CACHE_MAX_MEMORY
+
+#define layer_cache_p (LV_GLOBAL_DEFAULT()->layer_cache)
+
+static uint32_t draw_cnt;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    draw_cnt = 0;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+    lv_cache_set_max_size(layer_cache_p, LV_DRAW_LAYER_CACHE_MAX_MEMORY, NULL);
+}
+
+static void draw_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_cnt++;
+}
+
+static lv_obj_t * create_card_on(lv_obj_t * parent, int32_t x, int32_t y)
+{
+    lv_obj_t * card = lv_obj_create(parent);
+    lv_obj_set_pos(card, x, y);
+    lv_obj_set_size(card, 200, 150);
+    lv_obj_set_style_shadow_width(card, 20, 0);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_LAYER);
+
+    lv_obj_t * label = lv_label_create(card);
+    lv_label_set_text(label, "Cached card");
+    lv_obj_add_event_cb(label, draw_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    lv_obj_t * btn = lv_button_create(card);
+    lv_obj_align(btn, LV_ALIGN_BOTTOM_MID, 0, 0);
+
+    return card;
+}
+
+static lv_obj_t * create_card(int32_t x, int32_t y)
+{
+    return create_card_on(lv_screen_active(), x, y);
+}
+
+static void refr_and_compare_to_snapshot(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    /*Snapshots are drawn without the cached layers.
+     *Blending the layers can cause small rounding differences.*/
+    uint32_t draw_cnt_ori = draw_cnt;
+    lv_draw_buf_t * snapshot = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(snapshot);
+
+    lv_draw_buf_t * disp_buf = lv_display_get_buf_active(NULL);
+    uint32_t max_diff = 0;
+    uint32_t x, y, i;
+    for(y = 0; y < snapshot->header.h; y++) {
+        const uint8_t * snapshot_px = lv_draw_buf_goto_xy(snapshot, 0, y);
+        const uint8_t * disp_px = lv_draw_buf_goto_xy(disp_buf, 0, y);
+        for(x = 0; x < snapshot->header.w; x++) {
+            for(i = 0; i < 3; i++) {
+                uint32_t diff = LV_ABS(snapshot_px[x * 4 + i] - disp_px[x * 4 + i]);
+                max_diff = LV_MAX(max_diff, diff);
+            }
+        }
+    }
+
+    lv_draw_buf_destroy(snapshot);
+    draw_cnt = draw_cnt_ori;
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(3, max_diff);
+}
+
+void test_cache_layer_reuse(void)
+{
+    uint32_t miss_cnt = lv_cache_get_miss_count(layer_cache_p);
+    uint32_t hit_cnt = lv_cache_get_hit_count(layer_cache_p);
+    create_card(50, 50);
+
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 1, lv_cache_get_miss_count(layer_cache_p));
+
+    /*Redrawing the screen uses the cached layer*/
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 1, lv_cache_get_miss_count(layer_cache_p));
+    TEST_ASSERT_GREATER_THAN_UINT32(hit_cnt, lv_cache_get_hit_count(layer_cache_p));
+}
+
+void test_cache_layer_child_changed(void)
+{
+    lv_obj_t * card = create_card(50, 50);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+
+    /*A child's change marks the layer as outdated*/
+    lv_obj_t * btn = lv_obj_get_child(card, 1);
+    lv_obj_set_style_bg_color(btn, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+
+    /*Also if the card is not visible*/
+    lv_obj_add_flag(card, LV_OBJ_FLAG_HIDDEN);
+    lv_refr_now(NULL);
+    lv_obj_set_style_bg_color(btn, lv_palette_main(LV_PALETTE_GREEN), 0);
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_HIDDEN);
+    refr_and_compare_to_snapshot();
+    TEST_ASSERT_EQUAL_UINT32(3, draw_cnt);
+}
+
+void test_cache_layer_same_as_uncached(void)
+{
+    uint32_t miss_cnt = lv_cache_get_miss_count(layer_cache_p);
+    create_card(50, 50);
+
+    lv_obj_t * card = create_card(300, 50);
+    lv_obj_set_style_opa(card, LV_OPA_70, 0);
+
+    card = create_card(50, 250);
+    lv_obj_set_style_opa_layered(card, LV_OPA_50, 0);
+
+    /*On a recolored parent*/
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_pos(cont, 300, 250);
+    lv_obj_set_size(cont, 250, 200);
+    lv_obj_set_style_recolor(cont, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_recolor_opa(cont, LV_OPA_30, 0);
+    create_card_on(cont, 20, 20);
+
+    refr_and_compare_to_snapshot();
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 4, lv_cache_get_miss_count(layer_cache_p));
+
+    /*Drawn from the cached layers*/
+    TEST_ASSERT_EQUAL_SCREENSHOT("cache_layer_same_as_uncached.png");
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 4, lv_cache_get_miss_count(layer_cache_p));
+    TEST_ASSERT_EQUAL_UINT32(4, draw_cnt);
+}
+
+void test_cache_layer_resize(void)
+{
+    lv_obj_t * card = create_card(50, 50);
+    lv_refr_now(NULL);
+
+    lv_obj_set_size(card, 300, 100);
+    refr_and_compare_to_snapshot();
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+}
+
+void test_cache_layer_memory(void)
+{
+    lv_obj_t * card1 = create_card(50, 50);
+    lv_obj_t * card2 = create_card(300, 50);
+    lv_refr_now(NULL);
+    uint32_t size = lv_cache_get_size(layer_cache_p, NULL);
+    TEST_ASSERT_NOT_EQUAL(0, size);
+
+    /*Deleting or removing the flag frees the buffer*/
+    lv_obj_delete(card1);
+    lv_obj_remove_flag(card2, LV_OBJ_FLAG_CACHE_LAYER);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(layer_cache_p, NULL));
+
+    /*With a small limit only the recently used one is kept*/
+    lv_obj_add_flag(card2, LV_OBJ_FLAG_CACHE_LAYER);
+    card1 = create_card(50, 50);
+    lv_cache_set_max_size(layer_cache_p, size / 2, NULL);
+    lv_obj_invalidate(card1);
+    lv_refr_now(NULL);
+    lv_obj_invalidate(card2);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(size / 2, lv_cache_get_size(layer_cache_p, NULL));
+
+    /*If it doesn't fit at all they are drawn normally*/
+    lv_cache_set_max_size(layer_cache_p, size / 4, NULL);
+    refr_and_compare_to_snapshot();
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(layer_cache_p, NULL));
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_cache_layer_reuse(void)
+{
+}
+
+#endif
+
+#endif
@@ -1,5 +1,6 @@
 #if LV_BUILD_TEST
 #include "../lvgl.h"
+#include "../../lvgl_private.h"
 #include "unity/unity.h"
 
 /*Bypassing resolution check*/
@@ -205,4 +206,122 @@ void test_display_triple_buffer(void)
     lv_draw_buf_destroy(buf3);
 }
 
+void test_display_many_small_invalidations_do_not_refresh_the_whole_screen(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    lv_obj_t * scr = lv_display_get_screen_active(disp);
+    lv_refr_now(disp);
+
+    /*Invalidate a grid of small, distant areas. Much more than what fits into the buffer.*/
+    uint32_t small_area_size = 0;
+    int32_t x, y;
+    for(y = 10; y < 470; y += 40) {
+        for(x = 10; x < 790; x += 40) {
+            lv_area_t a;
+            lv_area_set(&a, x, y, x + 3, y + 3);
+            lv_obj_invalidate_area(scr, &a);
+            small_area_size += lv_area_get_size(&a);
+        }
+    }
+
+    TEST_ASSERT_LESS_OR_EQUAL(LV_INV_BUF_SIZE, disp->inv_p);
+
+    uint32_t inv_size = 0;
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        inv_size += lv_area_get_size(&disp->inv_areas[i]);
+    }
+
+    /*All the small areas are still marked...*/
+    TEST_ASSERT_GREATER_OR_EQUAL(small_area_size, inv_size);
+    /*...but the screen is not redrawn fully*/
+    TEST_ASSERT_LESS_THAN(lv_display_get_horizontal_resolution(disp) * lv_display_get_vertical_resolution(disp) / 2,
+                          inv_size);
+
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+}
+
+void test_display_covered_invalidations_are_merged(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    lv_obj_t * scr = lv_display_get_screen_active(disp);
+    lv_refr_now(disp);
+
+    lv_area_t a;
+    lv_area_set(&a, 10, 10, 19, 19);
+    lv_obj_invalidate_area(scr, &a);
+    lv_area_set(&a, 30, 30, 39, 39);
+    lv_obj_invalidate_area(scr, &a);
+    TEST_ASSERT_EQUAL(2, disp->inv_p);
+
+    /*An area covering both replaces them*/
+    lv_area_set(&a, 0, 0, 49, 49);
+    lv_obj_invalidate_area(scr, &a);
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_TRUE(lv_area_is_equal(&a, &disp->inv_areas[0]));
+
+    /*Overlapping areas are joined if their bounding box is smaller than the areas*/
+    lv_area_set(&a, 40, 0, 99, 49);
+    lv_obj_invalidate_area(scr, &a);
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    lv_area_set(&a, 0, 0, 99, 49);
+    TEST_ASSERT_TRUE(lv_area_is_equal(&a, &disp->inv_areas[0]));
+
+    lv_refr_now(disp);
+}
+
+static uint32_t tiled_flush_cnt;
+static lv_area_t tiled_flush_last_area;
+
+static void tiled_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * color_p)
+{
+    LV_UNUSED(color_p);
+
+    /*Only whole tiles are flushed*/
+    TEST_ASSERT_EQUAL(0, area->x1 % LV_DISPLAY_RENDER_TILE_SIZE);
+    TEST_ASSERT_EQUAL(0, area->y1 % LV_DISPLAY_RENDER_TILE_SIZE);
+    TEST_ASSERT_LESS_OR_EQUAL(LV_DISPLAY_RENDER_TILE_SIZE, lv_area_get_width(area));
+    TEST_ASSERT_LESS_OR_EQUAL(LV_DISPLAY_RENDER_TILE_SIZE, lv_area_get_height(area));
+
+    tiled_flush_cnt++;
+    tiled_flush_last_area = *area;
+    lv_display_flush_ready(disp);
+}
+
+void test_display_tiled_render_mode(void)
+{
+    static LV_ATTRIBUTE_MEM_ALIGN uint8_t
+    buf[LV_DISPLAY_RENDER_TILE_SIZE * LV_DISPLAY_RENDER_TILE_SIZE * 4 + LV_DRAW_BUF_ALIGN];
+
+    lv_display_t * disp = lv_display_create(150, 100);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);
+    lv_display_set_buffers(disp, lv_draw_buf_align(buf, LV_COLOR_FORMAT_XRGB8888), NULL,
+                           sizeof(buf) - LV_DRAW_BUF_ALIGN, LV_DISPLAY_RENDER_MODE_TILED);
+    lv_display_set_flush_cb(disp, tiled_flush_cb);
+    lv_obj_t * scr = lv_display_get_screen_active(disp);
+
+    /*The whole screen is 3x2 tiles, the last ones are clipped to the screen*/
+    tiled_flush_cnt = 0;
+    lv_obj_invalidate(scr);
+    lv_display_refr_timer(lv_display_get_refr_timer(disp));
+    TEST_ASSERT_EQUAL(6, tiled_flush_cnt);
+    lv_area_t expected_area = {128, 64, 149, 99};
+    TEST_ASSERT_TRUE(lv_area_is_equal(&expected_area, &tiled_flush_last_area));
+
+    /*Small areas refresh only the tiles they touch, and each tile only once*/
+    tiled_flush_cnt = 0;
+    lv_area_t a;
+    lv_area_set(&a, 60, 10, 70, 20);
+    lv_obj_invalidate_area(scr, &a);
+    lv_area_set(&a, 10, 10, 20, 20);
+    lv_obj_invalidate_area(scr, &a);
+    lv_display_refr_timer(lv_display_get_refr_timer(disp));
+    TEST_ASSERT_EQUAL(2, tiled_flush_cnt);
+    lv_area_set(&expected_area, 64, 0, 127, 63);
+    TEST_ASSERT_TRUE(lv_area_is_equal(&expected_area, &tiled_flush_last_area));
+
+    lv_display_delete(disp);
+}
+
 #endif
@@ -0,0 +1,114 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+/*Create 20 flex rows with 20 labels in each*/
+static lv_obj_t * create_rows(void)
+{
+    lv_obj_t * rows = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(rows, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_flex_flow(rows, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_obj_t * row = lv_obj_create(rows);
+        lv_obj_set_size(row, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+
+        uint32_t j;
+        for(j = 0; j < 20; j++) {
+            lv_obj_t * label = lv_label_create(row);
+            lv_label_set_text(label, "A");
+        }
+    }
+
+    lv_obj_update_layout(rows);
+    return rows;
+}
+
+void test_layout_dirty_skip_clean_branches(void)
+{
+    lv_obj_t * rows = create_rows();
+    lv_obj_t * row = lv_obj_get_child(rows, 5);
+    lv_obj_t * label = lv_obj_get_child(row, 3);
+    lv_obj_t * next_label = lv_obj_get_child(row, 4);
+
+    int32_t row_w = lv_obj_get_width(row);
+    int32_t next_label_x = lv_obj_get_x(next_label);
+
+    uint32_t visited_cnt = lv_obj_get_layout_visited_count();
+    uint32_t updated_cnt = lv_obj_get_layout_updated_count();
+
+    lv_label_set_text(label, "A longer text");
+    lv_obj_update_layout(label);
+
+    /*Only the changed label's branch and the affected rows are visited, not all the 400 labels*/
+    TEST_ASSERT_LESS_THAN_UINT32(100, lv_obj_get_layout_visited_count() - visited_cnt);
+    TEST_ASSERT_LESS_THAN_UINT32(100, lv_obj_get_layout_updated_count() - updated_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, lv_obj_get_layout_updated_count() - updated_cnt);
+
+    /*The layout is still updated correctly*/
+    TEST_ASSERT_GREATER_THAN(row_w, lv_obj_get_width(row));
+    TEST_ASSERT_GREATER_THAN(next_label_x, lv_obj_get_x(next_label));
+
+    /*Nothing to do if nothing has changed*/
+    visited_cnt = lv_obj_get_layout_visited_count();
+    lv_obj_update_layout(label);
+    TEST_ASSERT_EQUAL_UINT32(visited_cnt, lv_obj_get_layout_visited_count());
+}
+
+void test_layout_dirty_same_as_full_update(void)
+{
+    lv_obj_t * rows = create_rows();
+
+    lv_label_set_text(lv_obj_get_child(lv_obj_get_child(rows, 2), 0), "Longer text");
+    lv_label_set_text(lv_obj_get_child(lv_obj_get_child(rows, 7), 10), "Other text\nin 2 lines");
+    lv_obj_set_style_pad_column(lv_obj_get_child(rows, 15), 12, 0);
+    lv_obj_delete(lv_obj_get_child(lv_obj_get_child(rows, 19), 0));
+    lv_obj_update_layout(rows);
+
+    /*Save the coordinates, then update the whole tree*/
+    uint32_t row_cnt = lv_obj_get_child_count(rows);
+    lv_area_t * coords = lv_malloc(sizeof(lv_area_t) * row_cnt * 21);
+    TEST_ASSERT_NOT_NULL(coords);
+
+    uint32_t i;
+    uint32_t j;
+    uint32_t k = 0;
+    for(i = 0; i < row_cnt; i++) {
+        lv_obj_t * row = lv_obj_get_child(rows, i);
+        coords[k++] = row->coords;
+        for(j = 0; j < lv_obj_get_child_count(row); j++) {
+            coords[k++] = lv_obj_get_child(row, j)->coords;
+        }
+    }
+
+    lv_obj_report_style_change(NULL);
+    lv_obj_update_layout(rows);
+
+    k = 0;
+    for(i = 0; i < row_cnt; i++) {
+        lv_obj_t * row = lv_obj_get_child(rows, i);
+        TEST_ASSERT_EQUAL_MEMORY(&coords[k++], &row->coords, sizeof(lv_area_t));
+        for(j = 0; j < lv_obj_get_child_count(row); j++) {
+            TEST_ASSERT_EQUAL_MEMORY(&coords[k++], &lv_obj_get_child(row, j)->coords, sizeof(lv_area_t));
+        }
+    }
+
+    lv_free(coords);
+}
+
+#endif
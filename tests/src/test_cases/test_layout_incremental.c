@@ -0,0 +1,195 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+/*Update the layout of `cont`, then check that a full update gives the same result*/
+static void update_and_compare(lv_obj_t * cont)
+{
+    lv_obj_update_layout(cont);
+
+    uint32_t child_cnt = lv_obj_get_child_count(cont);
+    lv_area_t * coords = lv_malloc(sizeof(lv_area_t) * (child_cnt + 1));
+    TEST_ASSERT_NOT_NULL(coords);
+
+    uint32_t i;
+    for(i = 0; i < child_cnt; i++) {
+        coords[i] = lv_obj_get_child(cont, i)->coords;
+    }
+    coords[child_cnt] = cont->coords;
+
+    /*Forget the last update and measure everything again*/
+    lv_layout_free_cache(cont);
+    lv_obj_mark_layout_as_dirty(cont);
+    lv_obj_update_layout(cont);
+
+    for(i = 0; i < child_cnt; i++) {
+        TEST_ASSERT_EQUAL_MEMORY(&coords[i], &lv_obj_get_child(cont, i)->coords, sizeof(lv_area_t));
+    }
+    TEST_ASSERT_EQUAL_MEMORY(&coords[child_cnt], &cont->coords, sizeof(lv_area_t));
+
+    lv_free(coords);
+}
+
+static lv_obj_t * create_flex_item(lv_obj_t * cont, int32_t w, int32_t h)
+{
+    lv_obj_t * obj = lv_obj_create(cont);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, w, h);
+    return obj;
+}
+
+void test_layout_incremental_flex_append(void)
+{
+    lv_obj_t * list = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(list, 300, LV_PCT(100));
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t i;
+    for(i = 0; i < 1000; i++) {
+        create_flex_item(list, LV_PCT(100), 30);
+    }
+    lv_obj_update_layout(list);
+
+    /*Only the new item is placed*/
+    uint32_t measured_cnt = lv_layout_get_measured_count();
+    lv_obj_t * last = create_flex_item(list, LV_PCT(100), 30);
+    lv_obj_update_layout(list);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_layout_get_measured_count() - measured_cnt);
+
+    lv_obj_t * prev = lv_obj_get_sibling(last, -1);
+    TEST_ASSERT_EQUAL_INT32(prev->coords.y2 + 1 + lv_obj_get_style_pad_row(list, 0), last->coords.y1);
+
+    /*Scrolling moves the items but they don't need to be placed again*/
+    lv_obj_scroll_by(list, 0, -1000, LV_ANIM_OFF);
+    measured_cnt = lv_layout_get_measured_count();
+    create_flex_item(list, LV_PCT(100), 30);
+    lv_obj_update_layout(list);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_layout_get_measured_count() - measured_cnt);
+
+    /*Changing an item in the middle places only the items after it*/
+    measured_cnt = lv_layout_get_measured_count();
+    lv_obj_set_height(lv_obj_get_child(list, 900), 50);
+    lv_obj_update_layout(list);
+    TEST_ASSERT_EQUAL_UINT32(102, lv_layout_get_measured_count() - measured_cnt);
+
+    update_and_compare(list);
+}
+
+void test_layout_incremental_flex_same_as_full_update(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(cont, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        create_flex_item(cont, 10 + i, 20 + (i % 5) * 3);
+    }
+    lv_obj_set_style_margin_left(lv_obj_get_child(cont, 3), 7, 0);
+    lv_obj_set_style_translate_y(lv_obj_get_child(cont, 5), LV_PCT(50), 0);
+    lv_obj_add_flag(lv_obj_get_child(cont, 8), LV_OBJ_FLAG_HIDDEN);
+    update_and_compare(cont);
+
+    lv_obj_t * obj = create_flex_item(cont, 15, 15);
+    lv_obj_move_to_index(obj, 10);
+    update_and_compare(cont);
+
+    lv_obj_set_height(lv_obj_get_child(cont, 12), 60);
+    update_and_compare(cont);
+
+    lv_obj_set_height(lv_obj_get_child(cont, 12), 10);
+    update_and_compare(cont);
+
+    lv_obj_remove_flag(lv_obj_get_child(cont, 8), LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(lv_obj_get_child(cont, 15), LV_OBJ_FLAG_HIDDEN);
+    update_and_compare(cont);
+
+    lv_obj_set_style_margin_right(lv_obj_get_child(cont, 17), 12, 0);
+    update_and_compare(cont);
+
+    lv_obj_delete(lv_obj_get_child(cont, 18));
+    lv_obj_delete(lv_obj_get_child(cont, 2));
+    update_and_compare(cont);
+
+    lv_obj_set_style_pad_column(cont, 9, 0);
+    update_and_compare(cont);
+
+    /*The layouts which are not cached work as before*/
+    lv_obj_set_flex_grow(lv_obj_get_child(cont, 4), 1);
+    lv_obj_set_width(cont, 600);
+    update_and_compare(cont);
+    TEST_ASSERT_NULL(lv_layout_get_cache(cont, LV_LAYOUT_FLEX));
+
+    lv_obj_set_flex_grow(lv_obj_get_child(cont, 4), 0);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN_WRAP);
+    lv_obj_set_height(cont, 200);
+    update_and_compare(cont);
+
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+    update_and_compare(cont);
+}
+
+void test_layout_incremental_grid(void)
+{
+    static const int32_t col_dsc[] = {LV_GRID_CONTENT, 50, LV_GRID_FR(1), LV_GRID_TEMPLATE_LAST};
+    static const int32_t row_dsc[] = {40, LV_GRID_CONTENT, 40, LV_GRID_CONTENT, 40, LV_GRID_TEMPLATE_LAST};
+
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 400, LV_SIZE_CONTENT);
+    lv_obj_set_grid_dsc_array(cont, col_dsc, row_dsc);
+
+    uint32_t i;
+    for(i = 0; i < 15; i++) {
+        lv_obj_t * obj = lv_obj_create(cont);
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_size(obj, 20 + i, 20 + i);
+        lv_obj_set_grid_cell(obj, i % 2 ? LV_GRID_ALIGN_CENTER : LV_GRID_ALIGN_STRETCH, i % 3, 1,
+                             LV_GRID_ALIGN_END, i / 3, 1);
+    }
+    update_and_compare(cont);
+
+    /*Fixed tracks are not changed so only the changed item is placed*/
+    uint32_t measured_cnt = lv_layout_get_measured_count();
+    lv_obj_set_height(lv_obj_get_child(cont, 14), 30);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_layout_get_measured_count() - measured_cnt);
+    update_and_compare(cont);
+
+    /*Changing the size of a content sized row moves the rows below it*/
+    measured_cnt = lv_layout_get_measured_count();
+    lv_obj_set_height(lv_obj_get_child(cont, 4), 60);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_LESS_THAN_UINT32(15, lv_layout_get_measured_count() - measured_cnt);
+    update_and_compare(cont);
+
+    lv_obj_set_width(lv_obj_get_child(cont, 3), 70);
+    update_and_compare(cont);
+
+    lv_obj_add_flag(lv_obj_get_child(cont, 6), LV_OBJ_FLAG_HIDDEN);
+    update_and_compare(cont);
+
+    lv_obj_set_grid_cell(lv_obj_get_child(cont, 7), LV_GRID_ALIGN_START, 0, 2, LV_GRID_ALIGN_START, 3, 2);
+    update_and_compare(cont);
+
+    lv_obj_delete(lv_obj_get_child(cont, 0));
+    update_and_compare(cont);
+
+    lv_obj_set_style_base_dir(cont, LV_BASE_DIR_RTL, 0);
+    update_and_compare(cont);
+}
+
+#endif
@@ -0,0 +1,139 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_OCCLUSION_CULLING
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_obj_t * create_panel(lv_obj_t * parent, int32_t x, int32_t y, int32_t w, int32_t h, lv_palette_t palette)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(palette), 0);
+
+    lv_obj_t * label = lv_label_create(obj);
+    lv_label_set_text(label, "Some text on the panel");
+    return obj;
+}
+
+static void refr_and_compare_to_snapshot(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    /*Snapshots are drawn without culling so they should be the same as the display*/
+    lv_draw_buf_t * snapshot = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(snapshot);
+
+    lv_draw_buf_t * disp_buf = lv_display_get_buf_active(NULL);
+    TEST_ASSERT_EQUAL(disp_buf->header.cf, snapshot->header.cf);
+    uint32_t y;
+    for(y = 0; y < snapshot->header.h; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(lv_draw_buf_goto_xy(snapshot, 0, y), lv_draw_buf_goto_xy(disp_buf, 0, y),
+                                 snapshot->header.w * 4);
+    }
+
+    lv_draw_buf_destroy(snapshot);
+}
+
+void test_occlusion_culling_covered(void)
+{
+    create_panel(lv_screen_active(), 100, 100, 200, 150, LV_PALETTE_RED);
+    create_panel(lv_screen_active(), 50, 50, 300, 250, LV_PALETTE_BLUE);
+
+    refr_and_compare_to_snapshot();
+
+    /*The red panel is skipped entirely*/
+    TEST_ASSERT_EQUAL_UINT32(200 * 150, lv_display_get_culled_px_count(NULL));
+}
+
+void test_occlusion_culling_partially_covered(void)
+{
+    /*The rounded panel covers the bottom of the red panel with the band between its corners*/
+    create_panel(lv_screen_active(), 100, 100, 200, 150, LV_PALETTE_RED);
+    lv_obj_t * panel = create_panel(lv_screen_active(), 50, 150, 300, 200, LV_PALETTE_BLUE);
+    lv_obj_set_style_radius(panel, 20, 0);
+
+    refr_and_compare_to_snapshot();
+
+    /*Only the bottom of the red panel is skipped*/
+    TEST_ASSERT_EQUAL_UINT32(200 * (250 - 170), lv_display_get_culled_px_count(NULL));
+}
+
+void test_occlusion_culling_not_covered(void)
+{
+    /*Semi-transparent widgets, widgets on a layer can't cover and
+     *small widgets can't make the area of the widgets below them smaller*/
+    create_panel(lv_screen_active(), 100, 100, 200, 150, LV_PALETTE_RED);
+    lv_obj_t * panel = create_panel(lv_screen_active(), 50, 50, 300, 250, LV_PALETTE_BLUE);
+    lv_obj_set_style_bg_opa(panel, LV_OPA_50, 0);
+
+    create_panel(lv_screen_active(), 400, 100, 200, 150, LV_PALETTE_GREEN);
+    create_panel(lv_screen_active(), 450, 150, 50, 50, LV_PALETTE_YELLOW);
+
+    panel = create_panel(lv_screen_active(), 100, 300, 200, 100, LV_PALETTE_RED);
+    panel = create_panel(lv_screen_active(), 100, 300, 200, 100, LV_PALETTE_BLUE);
+    lv_obj_set_style_opa_layered(panel, LV_OPA_80, 0);
+
+    refr_and_compare_to_snapshot();
+
+    TEST_ASSERT_EQUAL_UINT32(0, lv_display_get_culled_px_count(NULL));
+}
+
+void test_occlusion_culling_children(void)
+{
+    /*The children of a covered panel are skipped too, but the panel doesn't cover its own children*/
+    lv_obj_t * parent = create_panel(lv_screen_active(), 100, 100, 300, 200, LV_PALETTE_RED);
+    lv_obj_t * child = create_panel(parent, 0, 30, 100, 50, LV_PALETTE_GREEN);
+    lv_obj_set_style_radius(child, 0, 0);
+    create_panel(lv_screen_active(), 50, 50, 400, 300, LV_PALETTE_BLUE);
+
+    refr_and_compare_to_snapshot();
+
+    TEST_ASSERT_EQUAL_UINT32(300 * 200, lv_display_get_culled_px_count(NULL));
+
+    /*The children are drawn after their parent so they cover only their siblings*/
+    lv_obj_clean(lv_screen_active());
+    parent = create_panel(lv_screen_active(), 100, 100, 300, 200, LV_PALETTE_RED);
+    lv_obj_set_style_pad_all(parent, 0, 0);
+    lv_obj_set_style_radius(parent, 0, 0);
+    lv_obj_set_style_border_width(parent, 0, 0);
+    lv_obj_t * label = lv_obj_get_child(parent, 0);
+    create_panel(parent, 0, 0, 300, 200, LV_PALETTE_GREEN);
+
+    refr_and_compare_to_snapshot();
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, lv_display_get_culled_px_count(NULL));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(lv_area_get_size(&label->coords), lv_display_get_culled_px_count(NULL));
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_occlusion_culling_covered(void)
+{
+}
+
+#endif
+
+#endif
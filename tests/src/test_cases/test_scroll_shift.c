@@ -0,0 +1,232 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_SCROLL_SHIFT
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_obj_t * create_list(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_pos(cont, 40, 30);
+    lv_obj_set_size(cont, 400, 380);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t i;
+    for(i = 0; i < 30; i++) {
+        lv_obj_t * btn = lv_button_create(cont);
+        lv_obj_set_size(btn, 500, 50);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Item %d", (int)i);
+    }
+
+    lv_refr_now(NULL);
+    return cont;
+}
+
+static bool scroll_shift_is_pending(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    return disp->scroll_shift.x != 0 || disp->scroll_shift.y != 0;
+}
+
+static uint32_t get_inv_size(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    uint32_t size = 0;
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        size += lv_area_get_size(&disp->inv_areas[i]);
+    }
+    return size;
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    lv_display_flush_ready(disp);
+}
+
+/*Get the buffer which was sent to the display last*/
+static lv_draw_buf_t * get_on_screen_buf(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    if(disp->buf_2 == NULL) return disp->buf_1;
+    else return disp->buf_act == disp->buf_1 ? disp->buf_2 : disp->buf_1;
+}
+
+/*Refresh and compare the result with redrawing the whole screen*/
+static void refr_and_compare(void)
+{
+    lv_refr_now(NULL);
+
+    lv_draw_buf_t * buf = get_on_screen_buf();
+    uint32_t size = buf->header.stride * buf->header.h;
+    uint8_t * shifted = lv_malloc(size);
+    TEST_ASSERT_NOT_NULL(shifted);
+    lv_memcpy(shifted, buf->data, size);
+
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    buf = get_on_screen_buf();
+    TEST_ASSERT_EQUAL_MEMORY(buf->data, shifted, size);
+
+    lv_free(shifted);
+}
+
+void test_scroll_shift_redraws_less(void)
+{
+    lv_obj_t * cont = create_list();
+
+    /*Scroll as the input devices do while dragging. (`lv_obj_scroll_by` changes the
+     *`LV_STATE_SCROLLED` state which redraws the whole widget)*/
+    lv_obj_scroll_by_raw(cont, 0, -20);
+    TEST_ASSERT_TRUE(scroll_shift_is_pending());
+
+    /*Only the revealed part, the border, and the scrollbar are redrawn*/
+    TEST_ASSERT_LESS_THAN(lv_area_get_size(&cont->coords) / 2, get_inv_size());
+
+    lv_refr_now(NULL);
+    TEST_ASSERT_FALSE(scroll_shift_is_pending());
+}
+
+void test_scroll_shift_same_as_redraw(void)
+{
+    lv_obj_t * cont = create_list();
+
+    lv_obj_scroll_by_raw(cont, 0, -37);
+    TEST_ASSERT_TRUE(scroll_shift_is_pending());
+    refr_and_compare();
+
+    lv_obj_scroll_by_raw(cont, 0, 23);
+    TEST_ASSERT_TRUE(scroll_shift_is_pending());
+    refr_and_compare();
+
+    lv_obj_scroll_by_raw(cont, -45, -11);
+    TEST_ASSERT_TRUE(scroll_shift_is_pending());
+    refr_and_compare();
+
+    lv_obj_scroll_by_raw(cont, 30, 0);
+    TEST_ASSERT_TRUE(scroll_shift_is_pending());
+    refr_and_compare();
+}
+
+void test_scroll_shift_double_buffered(void)
+{
+    lv_display_t * disp_ori = lv_display_get_default();
+    lv_display_t * disp = lv_display_create(480, 480);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);
+    lv_draw_buf_t * buf1 = lv_draw_buf_create(480, 480, LV_COLOR_FORMAT_XRGB8888, LV_STRIDE_AUTO);
+    lv_draw_buf_t * buf2 = lv_draw_buf_create(480, 480, LV_COLOR_FORMAT_XRGB8888, LV_STRIDE_AUTO);
+    lv_display_set_draw_buffers(disp, buf1, buf2);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_set_default(disp);
+
+    lv_obj_t * cont = create_list();
+    lv_refr_now(NULL);
+
+    /*Both buffers need to be updated*/
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_obj_scroll_by_raw(cont, 0, -17);
+        TEST_ASSERT_TRUE(scroll_shift_is_pending());
+        refr_and_compare();
+    }
+
+    lv_display_delete(disp);
+    lv_draw_buf_destroy(buf1);
+    lv_draw_buf_destroy(buf2);
+    lv_display_set_default(disp_ori);
+}
+
+void test_scroll_shift_multiple_times_in_a_refresh(void)
+{
+    lv_obj_t * cont = create_list();
+
+    /*Change a child too to see that it's redrawn on its new position*/
+    lv_obj_t * label = lv_obj_get_child(lv_obj_get_child(cont, 3), 0);
+    lv_label_set_text(label, "Changed");
+
+    lv_obj_scroll_by_raw(cont, 0, -15);
+    lv_obj_scroll_by_raw(cont, 0, -40);
+    lv_obj_scroll_by_raw(cont, -20, 18);
+    TEST_ASSERT_TRUE(scroll_shift_is_pending());
+    refr_and_compare();
+
+    /*Scrolling back and forth*/
+    lv_obj_scroll_by_raw(cont, 0, -300);
+    lv_obj_scroll_by_raw(cont, 0, 290);
+    refr_and_compare();
+}
+
+void test_scroll_shift_not_used_if_covered(void)
+{
+    lv_obj_t * cont = create_list();
+
+    /*A widget drawn above the list*/
+    lv_obj_t * sibling = lv_obj_create(lv_screen_active());
+    lv_obj_set_pos(sibling, 300, 200);
+    lv_obj_set_size(sibling, 100, 100);
+    lv_refr_now(NULL);
+
+    lv_obj_scroll_by_raw(cont, 0, -20);
+    TEST_ASSERT_FALSE(scroll_shift_is_pending());
+    refr_and_compare();
+
+    /*Not on the list anymore*/
+    lv_obj_set_x(sibling, 500);
+    lv_refr_now(NULL);
+    lv_obj_scroll_by_raw(cont, 0, -20);
+    TEST_ASSERT_TRUE(scroll_shift_is_pending());
+    refr_and_compare();
+
+    /*Semi transparent background*/
+    lv_obj_set_style_bg_opa(cont, LV_OPA_50, 0);
+    lv_refr_now(NULL);
+    lv_obj_scroll_by_raw(cont, 0, -20);
+    TEST_ASSERT_FALSE(scroll_shift_is_pending());
+    refr_and_compare();
+}
+
+void test_scroll_shift_not_used_in_full_mode(void)
+{
+    lv_obj_t * cont = create_list();
+
+    lv_display_set_render_mode(NULL, LV_DISPLAY_RENDER_MODE_FULL);
+    lv_obj_scroll_by_raw(cont, 0, -20);
+    TEST_ASSERT_FALSE(scroll_shift_is_pending());
+    lv_display_set_render_mode(NULL, LV_DISPLAY_RENDER_MODE_DIRECT);
+    refr_and_compare();
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_scroll_shift_redraws_less(void)
+{
+}
+
+#endif
+
+#endif
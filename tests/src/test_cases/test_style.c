@@ -141,4 +141,154 @@ void test_style_has_prop(void)
     lv_style_reset(&style);
 }
 
+void test_style_props_are_sorted(void)
+{
+    static const lv_style_prop_t props[] = {
+        LV_STYLE_TEXT_COLOR, LV_STYLE_WIDTH, LV_STYLE_BG_OPA, LV_STYLE_RADIUS,
+        LV_STYLE_PAD_TOP, LV_STYLE_BORDER_WIDTH, LV_STYLE_HEIGHT, LV_STYLE_OPA,
+        LV_STYLE_X, LV_STYLE_LINE_WIDTH, LV_STYLE_SHADOW_WIDTH, LV_STYLE_PAD_LEFT,
+    };
+    const uint32_t prop_cnt = sizeof(props) / sizeof(props[0]);
+
+    lv_style_t style;
+    lv_style_init(&style);
+
+    uint32_t i;
+    for(i = 0; i < prop_cnt; i++) {
+        lv_style_value_t v = { .num = (int32_t)i + 1 };
+        lv_style_set_prop(&style, props[i], v);
+    }
+
+    /*Overwrite a value*/
+    lv_style_value_t v_new = { .num = 100 };
+    lv_style_set_prop(&style, LV_STYLE_RADIUS, v_new);
+    TEST_ASSERT_EQUAL(prop_cnt, style.prop_cnt);
+
+    lv_style_prop_t * sorted_props = (lv_style_prop_t *)style.values_and_props +
+                                     style.prop_cnt * sizeof(lv_style_value_t);
+    for(i = 1; i < prop_cnt; i++) {
+        TEST_ASSERT_LESS_THAN(sorted_props[i], sorted_props[i - 1]);
+    }
+
+    for(i = 0; i < prop_cnt; i++) {
+        lv_style_value_t v;
+        TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, props[i], &v));
+        TEST_ASSERT_EQUAL_INT32(props[i] == LV_STYLE_RADIUS ? 100 : (int32_t)i + 1, v.num);
+    }
+
+    lv_style_value_t v;
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, LV_STYLE_Y, &v));
+
+    /*Removing keeps the order*/
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, LV_STYLE_BG_OPA));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, LV_STYLE_BG_OPA, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_OPA, &v));
+    TEST_ASSERT_EQUAL_INT32(8, v.num);
+
+    lv_style_reset(&style);
+}
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+
+void test_style_resolved_value_is_updated(void)
+{
+    /*Use a separate screen to not touch the widgets of the other tests*/
+    lv_obj_t * scr = lv_obj_create(NULL);
+
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_text_color(&style, lv_color_hex(0xff0000));
+    lv_style_set_bg_opa(&style, LV_OPA_50);
+
+    lv_obj_t * parent1 = lv_obj_create(scr);
+    lv_obj_t * parent2 = lv_obj_create(scr);
+    lv_obj_t * obj = lv_obj_create(parent1);
+    lv_obj_remove_style_all(obj); /*Don't use the text color of the theme*/
+
+    lv_obj_add_style(parent1, &style, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    /*Changing a style property*/
+    lv_style_set_text_color(&style, lv_color_hex(0x00ff00));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    /*Changing the state of the parent*/
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0x0000ff), LV_STATE_CHECKED);
+    lv_obj_add_state(parent1, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    /*Changing the parent*/
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x123456), LV_PART_MAIN);
+    lv_obj_set_parent(obj, parent2);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x123456), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    /*Adding and removing a style*/
+    lv_obj_add_style(obj, &style, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    lv_style_remove_prop(&style, LV_STYLE_BG_OPA);
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_NOT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    lv_obj_remove_style(obj, &style, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x123456), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    lv_obj_delete(scr);
+    lv_style_reset(&style);
+}
+
+void test_style_resolved_value_is_cached(void)
+{
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_obj_t * obj = lv_obj_create(scr);
+    lv_obj_remove_style_all(obj);
+
+    lv_obj_set_style_bg_opa(obj, LV_OPA_50, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    TEST_ASSERT_NOT_NULL(obj->style_resolved_cache);
+
+    /*The resolved value is stored in an up-to-date entry*/
+    lv_obj_style_resolved_cache_t * cache = obj->style_resolved_cache;
+    uint32_t i;
+    for(i = 0; i < LV_OBJ_STYLE_RESOLVED_CACHE_SIZE; i++) {
+        if(cache->entries[i].prop == LV_STYLE_BG_OPA && cache->entries[i].selector == LV_PART_MAIN) break;
+    }
+    TEST_ASSERT_LESS_THAN_UINT32(LV_OBJ_STYLE_RESOLVED_CACHE_SIZE, i);
+    TEST_ASSERT_EQUAL_INT32(LV_OPA_50, cache->entries[i].value.num);
+    TEST_ASSERT_EQUAL_UINT32(cache->generation, cache->entries[i].generation);
+
+    lv_obj_delete(scr);
+}
+
+void test_style_resolved_cache_is_invalidated_per_widget(void)
+{
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_obj_t * parent = lv_obj_create(scr);
+    lv_obj_t * child = lv_obj_create(parent);
+    lv_obj_t * other = lv_obj_create(scr);
+
+    lv_obj_get_style_text_color(child, LV_PART_MAIN);
+    lv_obj_get_style_text_color(other, LV_PART_MAIN);
+    uint32_t child_gen = child->style_resolved_cache->generation;
+    uint32_t other_gen = other->style_resolved_cache->generation;
+
+    /*A non-inheritable local property affects only the widget itself*/
+    lv_obj_set_style_bg_opa(parent, LV_OPA_50, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(parent, LV_PART_MAIN));
+    lv_obj_get_style_text_color(child, LV_PART_MAIN);
+    lv_obj_get_style_text_color(other, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_UINT32(child_gen, child->style_resolved_cache->generation);
+    TEST_ASSERT_EQUAL_UINT32(other_gen, other->style_resolved_cache->generation);
+
+    /*An inheritable local property affects the children too*/
+    lv_obj_set_style_text_color(parent, lv_color_hex(0x00ff00), LV_PART_MAIN);
+    lv_obj_remove_style_all(child);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+    lv_obj_get_style_text_color(other, LV_PART_MAIN);
+    TEST_ASSERT_NOT_EQUAL(child_gen, child->style_resolved_cache->generation);
+    TEST_ASSERT_EQUAL_UINT32(other_gen, other->style_resolved_cache->generation);
+
+    lv_obj_delete(scr);
+}
+
+#endif /*LV_OBJ_STYLE_RESOLVED_CACHE_SIZE*/
+
 #endif
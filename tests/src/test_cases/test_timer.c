@@ -0,0 +1,195 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define PAUSED_TIMER_MAX 32
+
+static lv_timer_t * paused_timers[PAUSED_TIMER_MAX];
+static uint32_t paused_timer_cnt;
+
+static uint32_t run_order[8];
+static uint32_t run_cnt;
+
+void setUp(void)
+{
+    /*Pause the timers of LVGL (refresh, indev, etc) to test only the timers of the test*/
+    paused_timer_cnt = 0;
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer) {
+        if(!lv_timer_get_paused(timer)) {
+            TEST_ASSERT_LESS_THAN(PAUSED_TIMER_MAX, paused_timer_cnt);
+            lv_timer_pause(timer);
+            paused_timers[paused_timer_cnt++] = timer;
+        }
+        timer = lv_timer_get_next(timer);
+    }
+
+    run_cnt = 0;
+}
+
+void tearDown(void)
+{
+    uint32_t i;
+    for(i = 0; i < paused_timer_cnt; i++) {
+        lv_timer_resume(paused_timers[i]);
+    }
+}
+
+static uint32_t get_timer_count(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer) {
+        cnt++;
+        timer = lv_timer_get_next(timer);
+    }
+    return cnt;
+}
+
+static void count_cb(lv_timer_t * timer)
+{
+    uint32_t * cnt = lv_timer_get_user_data(timer);
+    (*cnt)++;
+}
+
+static void order_cb(lv_timer_t * timer)
+{
+    run_order[run_cnt++] = (uint32_t)(lv_uintptr_t)lv_timer_get_user_data(timer);
+}
+
+static void delete_other_cb(lv_timer_t * timer)
+{
+    lv_timer_t ** other = lv_timer_get_user_data(timer);
+    lv_timer_delete(*other);
+    *other = NULL;
+}
+
+static void create_cb(lv_timer_t * timer)
+{
+    uint32_t * cnt = lv_timer_get_user_data(timer);
+    lv_timer_t * new_timer = lv_timer_create(count_cb, 0, cnt);
+    lv_timer_set_repeat_count(new_timer, 1);
+}
+
+void test_timer_time_until_next(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * t1 = lv_timer_create(count_cb, 100, &cnt);
+    lv_timer_t * t2 = lv_timer_create(count_cb, 30, &cnt);
+
+    TEST_ASSERT_EQUAL_UINT32(30, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(30, lv_timer_get_time_until_next());
+
+    lv_tick_inc(10);
+    TEST_ASSERT_EQUAL_UINT32(20, lv_timer_handler());
+
+    /*Paused timers are ignored*/
+    lv_timer_pause(t2);
+    TEST_ASSERT_EQUAL_UINT32(90, lv_timer_handler());
+
+    lv_timer_set_period(t1, 50);
+    TEST_ASSERT_EQUAL_UINT32(40, lv_timer_handler());
+
+    lv_timer_resume(t2);
+    lv_timer_ready(t2);
+    TEST_ASSERT_EQUAL_UINT32(30, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(1, cnt);
+
+    lv_timer_delete(t1);
+    lv_timer_delete(t2);
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_handler());
+}
+
+void test_timer_ready_timers_run_newest_first(void)
+{
+    lv_timer_t * t1 = lv_timer_create(order_cb, 10, (void *)1);
+    lv_timer_t * t2 = lv_timer_create(order_cb, 20, (void *)2);
+    lv_timer_t * t3 = lv_timer_create(order_cb, 5, (void *)3);
+
+    lv_tick_inc(20);
+    lv_timer_handler();
+
+    TEST_ASSERT_EQUAL_UINT32(3, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, run_order[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, run_order[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, run_order[2]);
+
+    lv_timer_delete(t1);
+    lv_timer_delete(t2);
+    lv_timer_delete(t3);
+}
+
+void test_timer_delete_in_callback(void)
+{
+    uint32_t timer_cnt = get_timer_count();
+    uint32_t cnt = 0;
+    lv_timer_t * victim = lv_timer_create(count_cb, 10, &cnt);
+    /*Created later so it runs first*/
+    lv_timer_t * killer = lv_timer_create(delete_other_cb, 10, &victim);
+
+    lv_tick_inc(10);
+    lv_timer_handler();
+
+    TEST_ASSERT_NULL(victim);
+    TEST_ASSERT_EQUAL_UINT32(0, cnt);
+
+    /*A timer can delete itself too*/
+    lv_timer_set_user_data(killer, &killer);
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_NULL(killer);
+    TEST_ASSERT_EQUAL_UINT32(timer_cnt, get_timer_count());
+}
+
+void test_timer_create_in_callback(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * creator = lv_timer_create(create_cb, 10, &cnt);
+
+    /*The new timer is ready immediately and runs in the same call*/
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, cnt);
+
+    lv_timer_delete(creator);
+}
+
+void test_timer_zero_period_runs_once_per_call(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * timer = lv_timer_create(count_cb, 0, &cnt);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_timer_get_time_until_next());
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, cnt);
+
+    lv_timer_delete(timer);
+}
+
+void test_timer_repeat_count(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * timer = lv_timer_create(count_cb, 10, &cnt);
+    lv_timer_set_repeat_count(timer, 2);
+    lv_timer_set_auto_delete(timer, false);
+
+    lv_tick_inc(10);
+    lv_timer_handler();
+    lv_tick_inc(10);
+    lv_timer_handler();
+    lv_tick_inc(10);
+    lv_timer_handler();
+
+    TEST_ASSERT_EQUAL_UINT32(2, cnt);
+    TEST_ASSERT_TRUE(lv_timer_get_paused(timer));
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_get_time_until_next());
+
+    lv_timer_delete(timer);
+}
+
+#endif
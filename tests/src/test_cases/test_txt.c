@@ -204,4 +204,139 @@ void test_lv_text_encoded_letter_next_2_should_handle_two_utf8_characters(void)
     TEST_ASSERT_EQUAL_UINT32(2, ofs);           /* Offset after 'é' */
 }
 
+void test_txt_layout_should_match_get_size(void)
+{
+    static const char * texts[] = {
+        "",
+        "A",
+        "Hello world",
+        "Lorem ipsum dolor sit amet,\nconsectetur adipiscing elit.\n",
+        "\n\nEmpty lines\r\n\nabove",
+        "Averyveryverylongwordwithoutanyspaces and #ff0000 recolored# words",
+        "\xc3\x81rv\xc3\xadzt\xc5\xb1r\xc5\x91 t\xc3\xbck\xc3\xb6rf\xc3\xbar\xc3\xb3g\xc3\xa9p",
+    };
+    static const int32_t widths[] = {20, 90, LV_COORD_MAX};
+    static const lv_text_flag_t flags[] = {LV_TEXT_FLAG_NONE, LV_TEXT_FLAG_RECOLOR, LV_TEXT_FLAG_EXPAND};
+    const lv_font_t * font = LV_FONT_DEFAULT;
+
+    lv_text_layout_t layout;
+    lv_text_layout_init(&layout);
+
+    uint32_t t, w, f;
+    for(t = 0; t < sizeof(texts) / sizeof(texts[0]); t++) {
+        for(w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+            for(f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+                const char * txt = texts[t];
+                TEST_ASSERT_TRUE(lv_text_layout_update(&layout, txt, font, 2, widths[w], flags[f]));
+                TEST_ASSERT_TRUE(lv_text_layout_is_up_to_date(&layout, txt, font, 2, widths[w], flags[f]));
+
+                lv_point_t size_ref;
+                lv_point_t size;
+                lv_text_get_size(&size_ref, txt, font, 2, 3, widths[w], flags[f]);
+                lv_text_layout_get_size(&layout, 3, &size);
+                TEST_ASSERT_EQUAL_INT32(size_ref.x, size.x);
+                TEST_ASSERT_EQUAL_INT32(size_ref.y, size.y);
+
+                /*The lines are where `lv_text_get_next_line` breaks the text*/
+                int32_t max_w = flags[f] & LV_TEXT_FLAG_EXPAND ? LV_COORD_MAX : widths[w];
+                uint32_t i;
+                for(i = 0; i < layout.line_cnt; i++) {
+                    uint32_t start = layout.lines[i].start;
+                    uint32_t len = lv_text_get_next_line(&txt[start], LV_TEXT_LEN_MAX, font, 2, max_w, NULL, flags[f]);
+                    TEST_ASSERT_EQUAL_UINT32(start + len, layout.lines[i + 1].start);
+                    TEST_ASSERT_EQUAL_UINT32(i, lv_text_layout_get_line_of_byte(&layout, start));
+                    TEST_ASSERT_EQUAL_UINT32(i, lv_text_layout_get_line_of_byte(&layout, start + len - 1));
+                }
+                TEST_ASSERT_EQUAL_UINT32(strlen(txt), layout.lines[layout.line_cnt].start);
+            }
+        }
+    }
+
+    /*Not calculated again if nothing has changed*/
+    TEST_ASSERT_TRUE(lv_text_layout_update(&layout, texts[2], font, 2, 90, LV_TEXT_FLAG_NONE));
+    lv_text_layout_t layout_copy = layout;
+    TEST_ASSERT_TRUE(lv_text_layout_update(&layout, texts[2], font, 2, 90, LV_TEXT_FLAG_NONE));
+    TEST_ASSERT_EQUAL_MEMORY(&layout_copy, &layout, sizeof(lv_text_layout_t));
+
+    lv_text_layout_invalidate(&layout);
+    TEST_ASSERT_FALSE(lv_text_layout_is_up_to_date(&layout, texts[2], font, 2, 90, LV_TEXT_FLAG_NONE));
+    TEST_ASSERT_FALSE(lv_text_layout_update(&layout, NULL, font, 2, 90, LV_TEXT_FLAG_NONE));
+
+    lv_text_layout_deinit(&layout);
+}
+
+static uint32_t layout_test_rand(uint32_t * seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return (*seed >> 16) & 0x7FFF;
+}
+
+void test_txt_layout_edit_should_match_full_update(void)
+{
+    static const char * snippets[] = {"a", " ", "\n", "longlonglongword ", "\xc3\x81", "two words"};
+    static char buf[4096];
+    const lv_font_t * font = LV_FONT_DEFAULT;
+
+    /*Paragraphs of different lengths*/
+    buf[0] = '\0';
+    uint32_t i;
+    for(i = 0; i < 60; i++) {
+        char word[16];
+        lv_snprintf(word, sizeof(word), i % 7 == 6 ? "word%d\n" : "word%d ", (int)i);
+        lv_strcat(buf, word);
+    }
+
+    lv_text_layout_t layout;
+    lv_text_layout_t ref;
+    lv_text_layout_init(&layout);
+    lv_text_layout_init(&ref);
+    TEST_ASSERT_TRUE(lv_text_layout_update(&layout, buf, font, 1, 80, LV_TEXT_FLAG_NONE));
+
+    uint32_t seed = 1;
+    for(i = 0; i < 300; i++) {
+        /*Sometimes edit twice before updating*/
+        uint32_t edit_cnt = i % 5 == 0 ? 2 : 1;
+        while(edit_cnt--) {
+            uint32_t len = lv_strlen(buf);
+            uint32_t pos = layout_test_rand(&seed) % (len + 1);
+            while(pos > 0 && (buf[pos] & 0xC0) == 0x80) pos--;
+
+            if(layout_test_rand(&seed) % 3 || len < 20) {
+                const char * ins = snippets[layout_test_rand(&seed) % (sizeof(snippets) / sizeof(snippets[0]))];
+                uint32_t ins_len = lv_strlen(ins);
+                if(len + ins_len >= sizeof(buf)) continue;
+                lv_memmove(&buf[pos + ins_len], &buf[pos], len - pos + 1);
+                lv_memcpy(&buf[pos], ins, ins_len);
+                lv_text_layout_set_edited(&layout, pos, len - pos);
+            }
+            else {
+                uint32_t end = LV_MIN(pos + 1 + layout_test_rand(&seed) % 8, len);
+                while(end < len && (buf[end] & 0xC0) == 0x80) end++;
+                lv_memmove(&buf[pos], &buf[end], len - end + 1);
+                lv_text_layout_set_edited(&layout, pos, len - end);
+            }
+        }
+
+        TEST_ASSERT_TRUE(lv_text_layout_update(&layout, buf, font, 1, 80, LV_TEXT_FLAG_NONE));
+        lv_text_layout_invalidate(&ref);
+        TEST_ASSERT_TRUE(lv_text_layout_update(&ref, buf, font, 1, 80, LV_TEXT_FLAG_NONE));
+
+        TEST_ASSERT_EQUAL_UINT32(ref.line_cnt, layout.line_cnt);
+        TEST_ASSERT_EQUAL_MEMORY(ref.lines, layout.lines, (ref.line_cnt + 1) * sizeof(lv_text_line_t));
+        TEST_ASSERT_EQUAL_INT32(ref.max_line_width, layout.max_line_width);
+        TEST_ASSERT_EQUAL(ref.ends_with_new_line, layout.ends_with_new_line);
+    }
+
+    /*The character and byte indices can be converted using the lines*/
+    uint32_t char_cnt = lv_text_get_encoded_length(buf);
+    for(i = 0; i <= char_cnt; i++) {
+        uint32_t byte_id = lv_text_encoded_get_byte_id(buf, i);
+        TEST_ASSERT_EQUAL_UINT32(byte_id, lv_text_layout_get_byte_id(&layout, buf, i));
+        TEST_ASSERT_EQUAL_UINT32(i, lv_text_layout_get_char_id(&layout, buf, byte_id));
+    }
+
+    lv_text_layout_deinit(&layout);
+    lv_text_layout_deinit(&ref);
+}
+
 #endif
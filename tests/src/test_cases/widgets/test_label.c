@@ -35,6 +35,13 @@ void tearDown(void)
     lv_obj_clean(lv_screen_active());
 }
 
+/*Get the cached lines of a label or NULL if they are not used*/
+static const lv_text_line_t * get_text_layout_lines(lv_obj_t * obj)
+{
+    lv_label_t * l = (lv_label_t *)obj;
+    return l->text_layout.valid ? l->text_layout.lines : NULL;
+}
+
 void test_label_creation(void)
 {
     TEST_ASSERT_EQUAL_STRING(lv_label_get_text(label), LV_LABEL_DEFAULT_TEXT);
@@ -691,4 +698,207 @@ void test_label_long_mode_clip(void)
     TEST_ASSERT_EQUAL_SCREENSHOT(buf);
 }
 
+/*Labels in DOTS mode don't use the cached lines, so compare with them*/
+static void compare_with_dots_label(lv_text_align_t align)
+{
+    static const char * text = "Lorem ipsum dolor sit amet,\nconsectetur adipiscing elit.\n\n"
+                               "Averyveryverylongwordwithoutspaces "
+                               "\xc3\x81rv\xc3\xadzt\xc5\xb1r\xc5\x91 t\xc3\xbck\xc3\xb6r\n";
+
+    lv_obj_t * cached = lv_label_create(active_screen);
+    lv_obj_set_width(cached, 120);
+    lv_obj_set_style_text_align(cached, align, 0);
+    lv_obj_set_style_text_line_space(cached, 3, 0);
+    lv_obj_set_style_text_letter_space(cached, 1, 0);
+    lv_label_set_text(cached, text);
+
+    lv_obj_t * ref = lv_label_create(active_screen);
+    lv_obj_set_size(ref, 120, 1000);
+    lv_obj_set_style_text_align(ref, align, 0);
+    lv_obj_set_style_text_line_space(ref, 3, 0);
+    lv_obj_set_style_text_letter_space(ref, 1, 0);
+    lv_label_set_long_mode(ref, LV_LABEL_LONG_MODE_DOTS);
+    lv_label_set_text(ref, text);
+
+    lv_obj_update_layout(active_screen);
+    TEST_ASSERT_NULL(get_text_layout_lines(ref));
+    TEST_ASSERT_NOT_NULL(get_text_layout_lines(cached));
+
+    uint32_t char_cnt = lv_text_get_encoded_length(text);
+    uint32_t i;
+    for(i = 0; i <= char_cnt; i++) {
+        lv_point_t pos_ref;
+        lv_point_t pos;
+        lv_label_get_letter_pos(ref, i, &pos_ref);
+        lv_label_get_letter_pos(cached, i, &pos);
+        TEST_ASSERT_EQUAL_INT32(pos_ref.x, pos.x);
+        TEST_ASSERT_EQUAL_INT32(pos_ref.y, pos.y);
+    }
+
+    lv_point_t p;
+    for(p.y = -5; p.y < lv_obj_get_height(cached) + 20; p.y += 3) {
+        for(p.x = -5; p.x < 130; p.x += 4) {
+            lv_point_t p_ref = p;
+            lv_point_t p_cached = p;
+            uint32_t letter_ref = lv_label_get_letter_on(ref, &p_ref, false);
+            TEST_ASSERT_EQUAL_UINT32(letter_ref, lv_label_get_letter_on(cached, &p_cached, false));
+            TEST_ASSERT_EQUAL(lv_label_is_char_under_pos(ref, &p_ref), lv_label_is_char_under_pos(cached, &p_cached));
+        }
+    }
+}
+
+void test_label_text_layout_same_as_without_it(void)
+{
+    compare_with_dots_label(LV_TEXT_ALIGN_LEFT);
+    compare_with_dots_label(LV_TEXT_ALIGN_CENTER);
+    compare_with_dots_label(LV_TEXT_ALIGN_RIGHT);
+}
+
+static void draw_to_canvas(lv_obj_t * canvas, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_label(&layer, dsc, coords);
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+void test_label_text_layout_draw(void)
+{
+    lv_draw_buf_t * buf = lv_draw_buf_create(200, 150, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(buf);
+    uint32_t buf_size = buf->header.stride * buf->header.h;
+    uint8_t * ref = lv_malloc(buf_size);
+    TEST_ASSERT_NOT_NULL(ref);
+
+    lv_obj_t * canvas = lv_canvas_create(active_screen);
+    lv_canvas_set_draw_buf(canvas, buf);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.text = long_text_multiline;
+    dsc.line_space = 2;
+
+    /*Start above the canvas to skip some lines*/
+    lv_area_t coords = {10, -60, 179, 300};
+
+    lv_text_layout_t layout;
+    lv_text_layout_init(&layout);
+    TEST_ASSERT_TRUE(lv_text_layout_update(&layout, dsc.text, dsc.font, dsc.letter_space, lv_area_get_width(&coords),
+                                           dsc.flag));
+
+    static const lv_text_align_t aligns[] = {LV_TEXT_ALIGN_LEFT, LV_TEXT_ALIGN_CENTER, LV_TEXT_ALIGN_RIGHT};
+    uint32_t i;
+    for(i = 0; i < sizeof(aligns) / sizeof(aligns[0]); i++) {
+        dsc.align = aligns[i];
+        dsc.text_layout = NULL;
+        draw_to_canvas(canvas, &dsc, &coords);
+        lv_memcpy(ref, buf->data, buf_size);
+
+        dsc.text_layout = &layout;
+        draw_to_canvas(canvas, &dsc, &coords);
+        TEST_ASSERT_EQUAL_MEMORY(ref, buf->data, buf_size);
+    }
+
+    /*Calculated for an other width, so not used*/
+    lv_area_set_width(&coords, 100);
+    dsc.text_layout = NULL;
+    draw_to_canvas(canvas, &dsc, &coords);
+    lv_memcpy(ref, buf->data, buf_size);
+    dsc.text_layout = &layout;
+    draw_to_canvas(canvas, &dsc, &coords);
+    TEST_ASSERT_EQUAL_MEMORY(ref, buf->data, buf_size);
+
+    lv_text_layout_deinit(&layout);
+    lv_obj_delete(canvas);
+    lv_free(ref);
+    lv_draw_buf_destroy(buf);
+}
+
+void test_label_text_layout_updated(void)
+{
+    lv_obj_set_width(label, 100);
+    lv_label_set_text(label, long_text);
+    lv_obj_update_layout(label);
+    lv_obj_t * ref = lv_label_create(active_screen);
+    lv_obj_set_width(ref, 100);
+    lv_label_set_long_mode(ref, LV_LABEL_LONG_MODE_DOTS);
+
+    /*The size is right after every kind of change*/
+    lv_label_ins_text(label, 5, "\nInserted ");
+    lv_label_set_text(ref, lv_label_get_text(label));
+    lv_obj_update_layout(active_screen);
+    TEST_ASSERT_EQUAL_INT32(lv_obj_get_height(ref), lv_obj_get_height(label));
+
+    lv_label_cut_text(label, 0, 20);
+    lv_label_set_text(ref, lv_label_get_text(label));
+    lv_obj_update_layout(active_screen);
+    TEST_ASSERT_EQUAL_INT32(lv_obj_get_height(ref), lv_obj_get_height(label));
+
+    lv_obj_set_width(label, 60);
+    lv_obj_set_width(ref, 60);
+    lv_obj_update_layout(active_screen);
+    TEST_ASSERT_EQUAL_INT32(lv_obj_get_height(ref), lv_obj_get_height(label));
+
+    lv_obj_set_style_text_letter_space(label, 5, 0);
+    lv_obj_set_style_text_letter_space(ref, 5, 0);
+    lv_obj_update_layout(active_screen);
+    TEST_ASSERT_EQUAL_INT32(lv_obj_get_height(ref), lv_obj_get_height(label));
+
+    /*The lines are ready to be used by the draw task*/
+    lv_label_t * l = (lv_label_t *)label;
+    TEST_ASSERT_TRUE(lv_text_layout_is_up_to_date(&l->text_layout, l->text, lv_obj_get_style_text_font(label, 0), 5,
+                                                  lv_obj_get_content_width(label), LV_TEXT_FLAG_NONE));
+}
+
+void test_label_font_resize_updates_size(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t test_ubuntu_font[];
+    extern size_t test_ubuntu_font_size;
+    lv_font_t * font = lv_tiny_ttf_create_data(test_ubuntu_font, test_ubuntu_font_size, 20);
+    lv_font_t * font_ref = lv_tiny_ttf_create_data(test_ubuntu_font, test_ubuntu_font_size, 40);
+
+    lv_obj_t * ttf_label = lv_label_create(active_screen);
+    lv_obj_set_style_text_font(ttf_label, font, 0);
+    lv_obj_set_width(ttf_label, 300);
+    lv_label_set_text(ttf_label, "Hello world from a resized font");
+    lv_obj_update_layout(active_screen);
+    int32_t small_h = lv_obj_get_height(ttf_label);
+
+    lv_obj_t * ref = lv_label_create(active_screen);
+    lv_obj_set_style_text_font(ref, font_ref, 0);
+    lv_obj_set_width(ref, 300);
+    lv_label_set_text(ref, "Hello world from a resized font");
+
+    /*The font pointer and the width are the same, only the metrics of the font change*/
+    lv_tiny_ttf_set_size(font, 40);
+    lv_obj_report_style_change(NULL);
+    lv_obj_update_layout(active_screen);
+
+    TEST_ASSERT_GREATER_THAN_INT32(small_h, lv_obj_get_height(ttf_label));
+    TEST_ASSERT_EQUAL_INT32(lv_obj_get_height(ref), lv_obj_get_height(ttf_label));
+
+    /*The letter positions come from the lines of the label, so they need to be broken again too*/
+    lv_point_t pos;
+    lv_point_t pos_ref;
+    lv_label_get_letter_pos(ttf_label, 20, &pos);
+    lv_label_get_letter_pos(ref, 20, &pos_ref);
+    TEST_ASSERT_EQUAL_INT32(pos_ref.x, pos.x);
+    TEST_ASSERT_EQUAL_INT32(pos_ref.y, pos.y);
+
+    lv_label_t * l = (lv_label_t *)ttf_label;
+    lv_label_t * l_ref = (lv_label_t *)ref;
+    TEST_ASSERT_EQUAL_INT32(l_ref->text_size.x, l->text_size.x);
+    TEST_ASSERT_EQUAL_INT32(l_ref->text_size.y, l->text_size.y);
+
+    lv_obj_delete(ttf_label);
+    lv_obj_delete(ref);
+    lv_tiny_ttf_destroy(font);
+    lv_tiny_ttf_destroy(font_ref);
+#else
+    TEST_PASS();
+#endif
+}
+
 #endif
@@ -350,4 +350,100 @@ void test_table_cell_select_should_not_allow_set_on_table_with_no_rows(void)
     TEST_ASSERT_EQUAL_UINT32(LV_TABLE_CELL_NONE, selected_column);
 }
 
+static uint32_t g_cell_value_cnt;
+static uint32_t g_cell_value_min_row;
+
+static const char * cell_value_cb(lv_obj_t * obj, uint32_t row, uint32_t col)
+{
+    LV_UNUSED(obj);
+    static char buf[32];
+
+    g_cell_value_cnt++;
+    if(row < g_cell_value_min_row) g_cell_value_min_row = row;
+
+    lv_snprintf(buf, sizeof(buf), "Event %d/%d", (int)row, (int)col);
+    return buf;
+}
+
+void test_table_virtual_should_get_only_the_visible_cells(void)
+{
+    lv_obj_set_size(table, 300, 200);
+    lv_table_set_column_count(table, 3);
+    lv_table_set_cell_value(table, 0, 0, "Stored");
+    lv_table_set_cell_value_cb(table, cell_value_cb);
+    lv_table_set_row_count(table, 100000);
+
+    /*No memory is used for the rows*/
+    lv_table_t * table_p = (lv_table_t *)table;
+    TEST_ASSERT_NULL(table_p->cell_data);
+    TEST_ASSERT_NULL(table_p->row_h);
+    TEST_ASSERT_EQUAL_UINT32(100000, lv_table_get_row_count(table));
+    TEST_ASSERT_EQUAL_STRING("Event 123/2", lv_table_get_cell_value(table, 123, 2));
+
+    lv_obj_update_layout(table);
+    int32_t row_h = table_p->virtual_row_h;
+    int32_t visible_row_cnt = lv_obj_get_content_height(table) / row_h + 2;
+
+    g_cell_value_cnt = 0;
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, g_cell_value_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(visible_row_cnt * 3, g_cell_value_cnt);
+
+    /*All the rows can be scrolled*/
+    lv_obj_scroll_to_y(table, 50000 * row_h, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_INT32(50000 * row_h, lv_obj_get_scroll_y(table));
+
+    g_cell_value_cnt = 0;
+    g_cell_value_min_row = UINT32_MAX;
+    lv_refr_now(NULL);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(visible_row_cnt * 3, g_cell_value_cnt);
+    /*The previous row is still visible on the top padding*/
+    TEST_ASSERT_EQUAL_UINT32(49999, g_cell_value_min_row);
+
+    /*Rows after the 65535th can be selected too*/
+    lv_table_set_selected_cell(table, 99999, 1);
+    uint32_t row;
+    uint32_t col;
+    lv_table_get_selected_cell(table, &row, &col);
+    TEST_ASSERT_EQUAL_UINT32(99999, row);
+    TEST_ASSERT_EQUAL_UINT32(1, col);
+
+    /*Store the cells again*/
+    lv_table_set_row_count(table, 10);
+    lv_table_set_cell_value_cb(table, NULL);
+    TEST_ASSERT_EQUAL_STRING("", lv_table_get_cell_value(table, 0, 0));
+    lv_table_set_cell_value(table, 9, 2, "Stored");
+    TEST_ASSERT_EQUAL_STRING("Stored", lv_table_get_cell_value(table, 9, 2));
+}
+
+void test_table_virtual_should_look_like_cropped_cells(void)
+{
+    lv_obj_set_size(table, 300, 200);
+    lv_obj_set_style_pad_all(table, 5, LV_PART_ITEMS);
+    lv_table_set_column_count(table, 2);
+    lv_table_set_column_width(table, 0, 200);
+
+    uint32_t i;
+    for(i = 0; i < 30; i++) {
+        lv_table_set_cell_ctrl(table, i, 0, LV_TABLE_CELL_CTRL_TEXT_CROP);
+        lv_table_set_cell_ctrl(table, i, 1, LV_TABLE_CELL_CTRL_TEXT_CROP);
+        lv_table_set_cell_value(table, i, 0, cell_value_cb(table, i, 0));
+        lv_table_set_cell_value(table, i, 1, cell_value_cb(table, i, 1));
+    }
+    lv_obj_scroll_to_y(table, 123, LV_ANIM_OFF);
+    lv_draw_buf_t * stored_buf = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(stored_buf);
+
+    lv_table_set_cell_value_cb(table, cell_value_cb);
+    lv_obj_update_layout(table);
+    lv_obj_scroll_to_y(table, 123, LV_ANIM_OFF);
+    lv_draw_buf_t * virtual_buf = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(virtual_buf);
+
+    TEST_ASSERT_EQUAL_MEMORY(stored_buf->data, virtual_buf->data, stored_buf->data_size);
+
+    lv_draw_buf_destroy(stored_buf);
+    lv_draw_buf_destroy(virtual_buf);
+}
+
 #endif
@@ -213,4 +213,51 @@ void test_textarea_properties(void)
 #endif
 }
 
+void test_textarea_edit_long_text(void)
+{
+    lv_obj_set_size(textarea, 300, 200);
+    lv_obj_t * ref = lv_textarea_create(active_screen);
+    lv_obj_set_size(ref, 300, 200);
+
+    char line[64];
+    uint32_t i;
+    for(i = 0; i < 300; i++) {
+        lv_snprintf(line, sizeof(line), "[%d] Some log message with a few words %d\n", (int)i, (int)(i * 7));
+        lv_textarea_add_text(textarea, line);
+    }
+
+    /*Type and delete in the middle of the text*/
+    lv_textarea_set_cursor_pos(textarea, 5000);
+    lv_textarea_add_text(textarea, "Inserted text which is long enough to wrap the line ");
+    lv_textarea_add_char(textarea, '\n');
+    for(i = 0; i < 30; i++) {
+        lv_textarea_delete_char(textarea);
+    }
+    lv_textarea_delete_char_forward(textarea);
+    lv_textarea_cursor_down(textarea);
+    lv_textarea_add_char(textarea, 'X');
+    lv_obj_update_layout(active_screen);
+
+    /*Same as setting the whole text at once*/
+    lv_textarea_set_text(ref, lv_textarea_get_text(textarea));
+    lv_textarea_set_cursor_pos(ref, lv_textarea_get_cursor_pos(textarea));
+    lv_obj_update_layout(active_screen);
+
+    lv_obj_t * label = lv_textarea_get_label(textarea);
+    lv_obj_t * ref_label = lv_textarea_get_label(ref);
+    TEST_ASSERT_EQUAL_INT32(lv_obj_get_width(ref_label), lv_obj_get_width(label));
+    TEST_ASSERT_EQUAL_INT32(lv_obj_get_height(ref_label), lv_obj_get_height(label));
+
+    lv_textarea_t * ta = (lv_textarea_t *)textarea;
+    lv_textarea_t * ta_ref = (lv_textarea_t *)ref;
+    TEST_ASSERT_EQUAL_MEMORY(&ta_ref->cursor.area, &ta->cursor.area, sizeof(lv_area_t));
+    TEST_ASSERT_EQUAL_UINT32(ta_ref->cursor.txt_byte_pos, ta->cursor.txt_byte_pos);
+
+    lv_label_t * l = (lv_label_t *)label;
+    lv_label_t * l_ref = (lv_label_t *)ref_label;
+    TEST_ASSERT_EQUAL_UINT32(l_ref->text_layout.line_cnt, l->text_layout.line_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(l_ref->text_layout.lines, l->text_layout.lines,
+                             (l->text_layout.line_cnt + 1) * sizeof(lv_text_line_t));
+}
+
 #endif